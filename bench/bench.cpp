@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basicscheduler.h"
+#include "batch.h"
+#include "policies.h"
+
+namespace
+{
+    using alg::uint;
+
+    //! Porównanie zadań przez funkcję wirtualną
+    /*!
+    Odtwarza sposób działania harmonogramu sprzed wprowadzenia polityk,
+    gdy każde porównanie wywoływało wirtualną funkcję getTaskPriority().
+    */
+    class VirtualComparator
+    {
+    public:
+        virtual ~VirtualComparator() = default;
+        virtual bool higher(const alg::Task& a, const alg::Task& b) const = 0;
+        virtual uint runLength(const alg::Task& running, const alg::Task& competitor, bool tieWins) const = 0;
+    };
+
+    //! Implementacja VirtualComparator przekazująca wywołania do polityki
+    template <typename Policy>
+    class PolicyComparator : public VirtualComparator
+    {
+    public:
+        bool higher(const alg::Task& a, const alg::Task& b) const override
+        {
+            return Policy::higher(a, b);
+        }
+
+        uint runLength(const alg::Task& running, const alg::Task& competitor, bool tieWins) const override
+        {
+            return Policy::runLength(running, competitor, tieWins);
+        }
+    };
+
+    //! Polityka wywołująca porównania przez wskaźnik na klasę bazową
+    /*!
+    Kolejkę, zaczepy i pozostałe stałe dziedziczy po mierzonej polityce.
+    */
+    template <typename Policy>
+    struct VirtualPolicy : Policy
+    {
+        static const VirtualComparator* comparator;
+
+        static bool higher(const alg::Task& a, const alg::Task& b)
+        {
+            return comparator->higher(a, b);
+        }
+
+        static uint runLength(const alg::Task& running, const alg::Task& competitor, bool tieWins)
+        {
+            return comparator->runLength(running, competitor, tieWins);
+        }
+    };
+
+    template <typename Policy>
+    const VirtualComparator* VirtualPolicy<Policy>::comparator = nullptr;
+
+    //! Funkcja losuje zadania z takimi samymi rozkładami jak MainWindow::randomTasks()
+    std::vector<alg::Task> randomTasks(int taskCount, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> disTime(1, 100);
+        std::uniform_int_distribution<> disPrioryty(0, 9);
+
+        std::vector<alg::Task> tasks;
+        for (int i = 0; i < taskCount; i++)
+        {
+            int time = disTime(gen);
+            int prioryty = disPrioryty(gen);
+
+            std::uniform_int_distribution<> disPeriod(time + 10, time + 50);
+            int period = disPeriod(gen);
+
+            tasks.emplace_back(i, period, time, period, prioryty);
+        }
+        return tasks;
+    }
+
+    //! Funkcja zwraca czas jednego cyklu symulacji w nanosekundach
+    template <typename Policy>
+    double measure(const std::vector<alg::Task>& tasks, uint horizon, bool events)
+    {
+        alg::BasicScheduler<Policy> scheduler;
+        scheduler.tasks = tasks;
+
+        auto start = std::chrono::steady_clock::now();
+        if (events)
+            scheduler.scheduleEvents(horizon);
+        else
+            scheduler.schedule(horizon);
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / horizon;
+    }
+
+    //! Metoda mierzy i wypisuje wyniki dla jednej polityki
+    template <typename Policy>
+    void run(const char* name, const std::vector<alg::Task>& tasks, uint horizon)
+    {
+        PolicyComparator<Policy> comparator;
+        VirtualPolicy<Policy>::comparator = &comparator;
+
+        for (bool events : {false, true})
+        {
+            double before = measure<VirtualPolicy<Policy>>(tasks, horizon, events);
+            double after = measure<Policy>(tasks, horizon, events);
+
+            std::printf("%-8s %-7s %8zu %14.2f %14.2f %8.2fx\n", name, events ? "events" : "ticks",
+                        tasks.size(), before, after, before / after);
+        }
+    }
+
+    //! Metoda mierzy przepustowość symulacji wsadowej dla rosnącej liczby wątków
+    void runBatch(uint horizon, unsigned seed)
+    {
+        std::vector<alg::TaskSet> sets;
+        for (unsigned i = 0; i < 512; ++i)
+            sets.push_back(randomTasks(10, seed + i));
+
+        std::vector<std::string> algorithms = alg::engineNames();
+        std::vector<uint> horizons {horizon / 10};
+
+        std::size_t maxThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        double single = 0.0;
+
+        std::printf("\n%-8s %12s %9s\n", "threads", "sims/s", "speedup");
+        for (std::size_t threads = 1; ; threads = std::min(threads * 2, maxThreads))
+        {
+            alg::ThreadPool pool(threads);
+
+            auto start = std::chrono::steady_clock::now();
+            alg::simulateBatch(pool, sets, algorithms, horizons);
+            auto end = std::chrono::steady_clock::now();
+
+            double rate = sets.size() * algorithms.size() / std::chrono::duration<double>(end - start).count();
+            if (threads == 1)
+                single = rate;
+            std::printf("%-8zu %12.1f %8.2fx\n", threads, rate, rate / single);
+
+            if (threads == maxThreads)
+                break;
+        }
+    }
+}
+
+//! Benchmark porównujący wirtualne i statyczne porównania zadań oraz skalowanie symulacji wsadowej
+/*!
+Użycie: bench [horyzont] [ziarno]
+*/
+int main(int argc, char* argv[])
+{
+    uint horizon = argc > 1 ? static_cast<uint>(std::strtoul(argv[1], nullptr, 10)) : 200000;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 1;
+
+    std::printf("%-8s %-7s %8s %14s %14s %9s\n", "policy", "mode", "tasks", "virtual ns/t", "static ns/t", "speedup");
+
+    for (int taskCount : {10, 100, 1000})
+    {
+        std::vector<alg::Task> tasks = randomTasks(taskCount, seed);
+
+        run<alg::DMSPolicy>("DMS", tasks, horizon);
+        run<alg::LLFPolicy>("LLF", tasks, horizon);
+        run<alg::PriorityPolicy>("Prio", tasks, horizon);
+        run<alg::EDFPolicy>("EDF", tasks, horizon);
+    }
+
+    runBatch(horizon, seed);
+
+    return 0;
+}
@@ -0,0 +1,9 @@
+TEMPLATE = app
+TARGET = bench
+
+CONFIG += console
+CONFIG -= qt app_bundle
+
+SOURCES = bench.cpp
+
+include(../core/core.pri)
@@ -0,0 +1,9 @@
+TEMPLATE = app
+TARGET = schedcli
+
+CONFIG += console
+CONFIG -= qt app_bundle
+
+SOURCES = main.cpp
+
+include(../core/core.pri)
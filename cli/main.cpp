@@ -0,0 +1,779 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "batch.h"
+#include "generator.h"
+#include "multiprocessor.h"
+#include "registry.h"
+#include "release.h"
+#include "resources.h"
+#include "server.h"
+#include "simulation.h"
+#include "taskio.h"
+#include "tracefile.h"
+
+namespace
+{
+    //! Metoda wypisuje sposób użycia programu
+    void usage(const char* program)
+    {
+        std::fprintf(stderr,
+            "Uzycie: %s [-a algorytm|all] [-t czas[,czas...]] [--ticks] [--full] [--analyze] [--batch [-j watki]] [--trace plik] [--hist bity]\n"
+            "          [-m procesory [--partition heurystyka]] [--generate liczba [--gen opcje] [--dump]] [--releases opcje]\n"
+            "          [--server rodzaj,budzet,okres[,priorytet]] [--resources protokol] [--policy opcje] plik...\n"
+            "  -a algorytm  algorytm szeregowania (domyslnie all)\n"
+            "  -t czas      czas symulacji, kilka czasow oddzielonych przecinkami (domyslnie 500)\n"
+            "  --ticks      symulacja cykl po cyklu zamiast sterowanej zdarzeniami\n"
+            "  --full       symuluj caly czas, bez pomijania powtarzajacych sie hiperokresow\n"
+            "  --analyze    wypisz wyniki testow szeregowalnosci; z --batch symuluj tylko zestawy\n"
+            "               nierozstrzygniete przez testy\n"
+            "  --batch      symulacja rownolegla, wypisuje tylko wyniki zbiorcze algorytmow\n"
+            "  -j watki     liczba watkow symulacji wsadowej lub procesorow podzielonych (domyslnie\n"
+            "               liczba rdzeni)\n"
+            "  --trace plik zapisz przebieg symulacji do pliku binarnego; wymaga jednego zestawu,\n"
+            "               algorytmu i czasu\n"
+            "  --hist bity  precyzja histogramu czasow odpowiedzi dla percentyla p99R,\n"
+            "               blad wzgledny 2^-bity, 0 wylacza histogram (domyslnie 7)\n"
+            "  -m procesory liczba procesorow (domyslnie 1), bez --partition szeregowanie globalne\n"
+            "  --partition heurystyka  podziel zadania pomiedzy procesory: ff, nf, bf, wf (first, next,\n"
+            "               best, worst fit), z sufiksem d w kolejnosci malejacego wykorzystania, np. ffd\n"
+            "  --generate liczba  losuj podana liczbe zestawow zadan zamiast czytac pliki\n"
+            "  --gen opcje  ustawienia generatora klucz=wartosc oddzielone przecinkami:\n"
+            "               n=zadania (10), u=wykorzystanie (0.7), umax=limit zadania (1),\n"
+            "               method=uunifast|randfixedsum, periods=log|harmonic|divisors,\n"
+            "               min=okres (10), max=okres (1000), granularity=1, hyperperiod=25200,\n"
+            "               deadline=najkrotszy termin jako ulamek T - C (1), priorities=10, seed=1\n"
+            "  --dump       wypisz wylosowane zestawy w formacie pliku zadan i zakoncz\n"
+            "  --releases opcje  zwolnienia zadan z przesunieciem, jitterem, sporadycznych (s) i aperiodycznych (a),\n"
+            "               klucz=wartosc oddzielone przecinkami: seed=1, slack=odstep sporadyczny do\n"
+            "               (1 + slack) * okres (1), arrivals=plik zwolnien zadan aperiodycznych,\n"
+            "               wiersze: czas numer_zadania\n"
+            "  --server rodzaj,budzet,okres[,priorytet]  serwer zadan aperiodycznych (a) dla DMS,\n"
+            "               RM i algorytmu priorytetowego: ps (odpytujacy), ds (odroczony), ss (sporadyczny);\n"
+            "               tylko dla jednego procesora\n"
+            "  --resources protokol  dostep do zasobow z sekcji krytycznych zadan (Rn:poczatek:dlugosc):\n"
+            "               none (bez zmiany priorytetow), pip (dziedziczenie), pcp (pulap priorytetu);\n"
+            "               pip i pcp dla DMS, RM i algorytmu priorytetowego, tylko dla jednego procesora\n"
+            "  --policy opcje  parametry polityk klucz=wartosc oddzielone przecinkami: quantum=kwant RR (4),\n"
+            "               hysteresis=premia swobody wykonywanego zadania w LLF-H (2),\n"
+            "               sticky=1 remis swobod w LLF-H wygrywa wykonywane zadanie (0),\n"
+            "               switch=koszt przelaczenia kontekstu w cyklach dla kazdego algorytmu (0)\n"
+            "  --list       wypisz dostepne algorytmy z opisami\n"
+            "  plik         plik z zestawami zadan, '-' oznacza standardowe wejscie\n",
+            program);
+    }
+
+    //! Metoda wypisuje wyniki testów szeregowalności
+    void printReport(const alg::SchedulabilityReport& report)
+    {
+        std::printf("analiza: U=%.4f, Liu-Layland %s, hiperboliczny %s, czas odpowiedzi %s, zapotrzebowanie %s => %s\n",
+                    report.utilization, alg::verdictName(report.liuLayland), alg::verdictName(report.hyperbolic),
+                    alg::verdictName(report.responseTime), alg::verdictName(report.demand), alg::verdictName(report.verdict));
+    }
+
+    //! Metoda wypisuje wiersz statystyk zadania lub serwera
+    void printRow(const std::string& label, const alg::TaskStats& s, alg::uint horizon, bool multiprocessor, bool locking,
+                  bool switching)
+    {
+        std::printf("%-7s %9u %9u %8u %10u %8u %10.2f ", label.c_str(), s.jobs, s.completed, s.misses, s.busy,
+                    s.maxResponse, s.avgResponse());
+
+        // percentyl i spóźnienie mają sens tylko dla zakończonych instancji
+        if (s.responses.count() > 0)
+            std::printf("%8u ", s.responsePercentile(0.99));
+        else
+            std::printf("%8s ", "-");
+        if (s.completed > 0)
+            std::printf("%8d ", s.maxLateness);
+        else
+            std::printf("%8s ", "-");
+
+        std::printf("%8u %8u ", s.preemptions, s.switches);
+        if (multiprocessor)
+            std::printf("%8u ", s.migrations);
+        if (locking)
+            std::printf("%8u ", s.blocked);
+        if (switching)
+            std::printf("%8u ", s.switching);
+        std::printf("%8.4f\n", s.utilization(horizon));
+    }
+
+    //! Metoda wypisuje statystyki jednej symulacji
+    /*!
+    Migracje i procesory wypisywane są tylko dla symulacji na wielu procesorach,
+    a czas blokowania na zasobach tylko gdy zadania zajmowały zasoby. Cykle przełączania kontekstu
+    wypisywane są tylko z niezerowym kosztem przełączenia.
+    Gdy zadania aperiodyczne obsługiwał serwer, pod zadaniami wypisywany jest wiersz S
+    z łącznymi statystykami obsłużonych instancji.
+    \param report wyniki testów szeregowalności lub nullptr
+    \param partition podział zadań pomiędzy procesory lub nullptr przy szeregowaniu globalnym
+    \param server ustawienia serwera zadań aperiodycznych lub nullptr
+    \param protocol protokół dostępu do zasobów
+    */
+    void printStats(const std::string& source, std::size_t setIndex, const std::string& algorithm,
+                    const alg::SimulationStats& stats, const alg::SchedulabilityReport* report = nullptr,
+                    const alg::Partition* partition = nullptr, const alg::ServerOptions* server = nullptr,
+                    alg::ResourceProtocol protocol = alg::ResourceProtocol::NONE)
+    {
+        const bool multiprocessor = stats.cores > 1;
+        const bool switching = stats.switchCost > 0;
+
+        std::printf("# %s, zestaw %zu, algorytm %s, czas %u\n", source.c_str(), setIndex + 1, algorithm.c_str(), stats.horizon);
+        std::printf("%-7s %9s %9s %8s %10s %8s %10s %8s %8s %8s %8s", "zadanie", "instancje", "zakoncz.", "terminy",
+                    "cykle", "maxR", "sredniaR", "p99R", "maxL", "wywl.", "przel.");
+        if (multiprocessor)
+            std::printf(" %8s", "migr.");
+        if (stats.locking)
+            std::printf(" %8s", "blok.");
+        if (switching)
+            std::printf(" %8s", "kontekst");
+        std::printf(" %8s\n", "wykorz.");
+
+        for (std::size_t i = 0; i < stats.tasks.size(); ++i)
+            printRow("T" + std::to_string(i + 1), stats.tasks[i], stats.horizon, multiprocessor, stats.locking, switching);
+        if (stats.served)
+            printRow("S", stats.server, stats.horizon, multiprocessor, stats.locking, switching);
+
+        std::printf("przekroczone terminy: %u, wykorzystanie: %.4f, wywlaszczenia: %u, przelaczenia: %u",
+                    stats.misses(), stats.utilization(), stats.preemptions(), stats.switches());
+        if (multiprocessor)
+            std::printf(", migracje: %u", stats.migrations());
+        std::printf(", system %s\n", stats.systemOk ? "sprawny" : "niesprawny");
+
+        if (multiprocessor)
+        {
+            std::printf("procesory: %u", stats.cores);
+            if (partition)
+            {
+                std::printf(", podzial:");
+                for (std::size_t c = 0; c < partition->load.size(); ++c)
+                {
+                    std::printf(" P%zu(U=%.4f):", c + 1, partition->load[c]);
+                    for (std::size_t i = 0; i < partition->cores.size(); ++i)
+                    {
+                        if (partition->cores[i] == c)
+                            std::printf(" T%zu", i + 1);
+                    }
+                }
+                if (!partition->fits)
+                    std::printf(", zadania nie mieszcza sie na procesorach");
+            }
+            else
+                std::printf(", szeregowanie globalne");
+            std::printf("\n");
+        }
+        if (stats.served && server)
+        {
+            std::printf("serwer %s: budzet %d, okres %d, priorytet %d\n", alg::serverName(server->kind),
+                        server->budget, server->period, server->prioryty);
+        }
+        if (stats.locking)
+            std::printf("zasoby: protokol %s, blokowanie: %u\n", alg::protocolName(protocol), stats.blocked());
+        if (switching)
+        {
+            std::printf("przelaczanie kontekstu: koszt %u, cykle %u, strata %.4f czasu procesora\n", stats.switchCost,
+                        stats.switching(), stats.switchOverhead());
+        }
+        if (report)
+            printReport(*report);
+        std::printf("\n");
+    }
+
+    //! Metoda wypisuje wyniki zbiorcze symulacji wsadowej
+    /*!
+    \param switching czy wypisać średnią stratę czasu procesora na przełączanie kontekstu
+    */
+    void printSummary(const std::vector<alg::BatchSummary>& summary, bool switching)
+    {
+        std::printf("%-13s %10s %8s %9s %9s %10s %10s %12s %10s %8s %8s %12s", "algorytm", "czas", "zestawy", "przyjete",
+                    "odrzucone", "niewykon.", "instancje", "terminy", "udz.term.", "maxR", "wykorz.", "wywl.");
+        if (switching)
+            std::printf(" %8s", "przel.");
+        std::printf("\n");
+
+        for (const alg::BatchSummary &s : summary)
+        {
+            std::printf("%-13s %10u %8zu %9zu %9zu %10zu %10llu %12llu %10.6f %8u %8.4f %12llu", s.algorithm.c_str(), s.horizon,
+                        s.sets, s.accepted, s.rejected, s.failedSets, static_cast<unsigned long long>(s.jobs),
+                        static_cast<unsigned long long>(s.misses), s.missRatio(), s.maxResponse, s.avgUtilization(),
+                        static_cast<unsigned long long>(s.preemptions));
+            if (switching)
+                std::printf(" %8.4f", s.avgOverhead());
+            std::printf("\n");
+        }
+    }
+
+    //! Funkcja wczytuje listę czasów oddzielonych przecinkami
+    bool parseHorizons(const char* text, std::vector<alg::uint>& horizons)
+    {
+        horizons.clear();
+        while (*text)
+        {
+            char* end;
+            unsigned long value = std::strtoul(text, &end, 10);
+            if (end == text || (*end != ',' && *end != '\0'))
+                return false;
+
+            horizons.push_back(static_cast<alg::uint>(value));
+            text = *end ? end + 1 : end;
+        }
+        return !horizons.empty();
+    }
+
+    //! Funkcja wczytuje ustawienia generatora zapisane jako klucz=wartosc oddzielone przecinkami
+    bool parseGenerator(const std::string& text, alg::GeneratorOptions& options, std::uint64_t& seed)
+    {
+        std::size_t begin = 0;
+        while (begin < text.size())
+        {
+            std::size_t end = text.find(',', begin);
+            if (end == std::string::npos)
+                end = text.size();
+
+            std::string item = text.substr(begin, end - begin);
+            begin = end + 1;
+
+            std::size_t eq = item.find('=');
+            if (eq == std::string::npos)
+                return false;
+            std::string key = item.substr(0, eq);
+            std::string value = item.substr(eq + 1);
+            char *rest;
+            double number = std::strtod(value.c_str(), &rest);
+            bool isNumber = !value.empty() && *rest == '\0' && number >= 0;
+
+            if (key == "method" && (value == "uunifast" || value == "randfixedsum"))
+                options.utilizationMethod = value == "uunifast" ? alg::UtilizationMethod::UUNIFAST : alg::UtilizationMethod::RANDFIXEDSUM;
+            else if (key == "periods" && value == "log")
+                options.periodMethod = alg::PeriodMethod::LOG_UNIFORM;
+            else if (key == "periods" && value == "harmonic")
+                options.periodMethod = alg::PeriodMethod::HARMONIC;
+            else if (key == "periods" && value == "divisors")
+                options.periodMethod = alg::PeriodMethod::DIVISORS;
+            else if (!isNumber)
+                return false;
+            else if (key == "n")
+                options.tasks = static_cast<std::size_t>(number);
+            else if (key == "u")
+                options.utilization = number;
+            else if (key == "umax")
+                options.maxTaskUtilization = number;
+            else if (key == "min")
+                options.minPeriod = static_cast<alg::uint>(number);
+            else if (key == "max")
+                options.maxPeriod = static_cast<alg::uint>(number);
+            else if (key == "granularity")
+                options.granularity = static_cast<alg::uint>(number);
+            else if (key == "hyperperiod")
+                options.hyperperiod = static_cast<alg::uint>(number);
+            else if (key == "deadline")
+                options.minDeadline = number;
+            else if (key == "priorities")
+                options.priorities = static_cast<int>(number);
+            else if (key == "seed")
+                seed = static_cast<std::uint64_t>(number);
+            else
+                return false;
+        }
+        return true;
+    }
+
+    //! Funkcja wczytuje ustawienia zwolnień zapisane jako klucz=wartosc oddzielone przecinkami
+    bool parseReleases(const std::string& text, alg::ReleaseOptions& options)
+    {
+        std::size_t begin = 0;
+        while (begin < text.size())
+        {
+            std::size_t end = text.find(',', begin);
+            if (end == std::string::npos)
+                end = text.size();
+
+            std::string item = text.substr(begin, end - begin);
+            begin = end + 1;
+
+            std::size_t eq = item.find('=');
+            if (eq == std::string::npos)
+                return false;
+            std::string key = item.substr(0, eq);
+            std::string value = item.substr(eq + 1);
+            char *rest;
+            double number = std::strtod(value.c_str(), &rest);
+            bool isNumber = !value.empty() && *rest == '\0' && number >= 0;
+
+            if (key == "arrivals" && !value.empty())
+                options.arrivals = value;
+            else if (!isNumber)
+                return false;
+            else if (key == "seed")
+                options.seed = static_cast<std::uint64_t>(number);
+            else if (key == "slack")
+                options.sporadicSlack = number;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    //! Funkcja wczytuje parametry polityki zapisane jako klucz=wartosc oddzielone przecinkami
+    bool parsePolicy(const std::string& text, alg::PolicyOptions& options)
+    {
+        std::size_t begin = 0;
+        while (begin < text.size())
+        {
+            std::size_t end = text.find(',', begin);
+            if (end == std::string::npos)
+                end = text.size();
+
+            std::string item = text.substr(begin, end - begin);
+            begin = end + 1;
+
+            std::size_t eq = item.find('=');
+            if (eq == std::string::npos)
+                return false;
+            std::string key = item.substr(0, eq);
+            std::string value = item.substr(eq + 1);
+            char *rest;
+            long number = std::strtol(value.c_str(), &rest, 10);
+            if (value.empty() || *rest != '\0' || number < 0 || number > 0x7fffffff)
+                return false;
+
+            if (key == "quantum" && number > 0)
+                options.quantum = static_cast<int>(number);
+            else if (key == "hysteresis")
+                options.hysteresis = static_cast<int>(number);
+            else if (key == "sticky" && number <= 1)
+                options.sticky = number != 0;
+            else if (key == "switch")
+                options.switchCost = static_cast<int>(number);
+            else
+                return false;
+        }
+        return true;
+    }
+
+    //! Funkcja wczytuje serwer zadań aperiodycznych zapisany jako rodzaj,budzet,okres[,priorytet]
+    bool parseServer(const std::string& text, alg::ServerOptions& options)
+    {
+        std::vector<std::string> items;
+        std::size_t begin = 0;
+        while (begin <= text.size())
+        {
+            std::size_t end = text.find(',', begin);
+            if (end == std::string::npos)
+                end = text.size();
+            items.push_back(text.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        if (items.size() < 3 || items.size() > 4)
+            return false;
+
+        if (items[0] == "ps")
+            options.kind = alg::ServerKind::POLLING;
+        else if (items[0] == "ds")
+            options.kind = alg::ServerKind::DEFERRABLE;
+        else if (items[0] == "ss")
+            options.kind = alg::ServerKind::SPORADIC;
+        else
+            return false;
+
+        int* values[] = {&options.budget, &options.period, &options.prioryty};
+        for (std::size_t k = 1; k < items.size(); ++k)
+        {
+            char *rest;
+            long value = std::strtol(items[k].c_str(), &rest, 10);
+            if (items[k].empty() || *rest != '\0' || value < 0 || value > 0x7fffffff)
+                return false;
+            *values[k - 1] = static_cast<int>(value);
+        }
+        return options.enabled();
+    }
+
+    //! Funkcja wczytuje zestawy zadań z pliku lub standardowego wejścia
+    bool loadFile(const std::string& file, std::vector<alg::TaskSet>& sets)
+    {
+        std::string error;
+        bool ok;
+
+        if (file == "-")
+            ok = alg::readTaskSets(std::cin, sets, error);
+        else
+        {
+            std::ifstream in(file);
+            if (!in)
+            {
+                std::fprintf(stderr, "%s: nie mozna otworzyc pliku\n", file.c_str());
+                return false;
+            }
+            ok = alg::readTaskSets(in, sets, error);
+        }
+
+        if (!ok)
+            std::fprintf(stderr, "%s: %s\n", file.c_str(), error.c_str());
+        return ok;
+    }
+}
+
+//! Program symulujący algorytmy szeregowania bez interfejsu graficznego
+int main(int argc, char* argv[])
+{
+    std::string algorithm = "all";
+    std::vector<alg::uint> horizons {500};
+    bool events = true;
+    bool batch = false;
+    bool shortcut = true;
+    bool analysis = false;
+    std::size_t threads = 0;
+    unsigned histogram = alg::Histogram::defaultPrecision;
+    std::string traceFile;
+    std::vector<std::string> files;
+    std::size_t generate = 0;
+    alg::GeneratorOptions generatorOptions;
+    std::uint64_t seed = 1;
+    bool dump = false;
+    alg::MultiprocessorOptions multiprocessor;
+    alg::ReleaseOptions releases;
+    alg::ServerOptions server;
+    alg::ResourceProtocol protocol = alg::ResourceProtocol::NONE;
+    alg::PolicyOptions policy;
+
+    // parsujemy argumenty
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+            algorithm = argv[++i];
+        else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            if (!parseHorizons(argv[++i], horizons))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            threads = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--ticks") == 0)
+            events = false;
+        else if (std::strcmp(argv[i], "--batch") == 0)
+            batch = true;
+        else if (std::strcmp(argv[i], "--full") == 0)
+            shortcut = false;
+        else if (std::strcmp(argv[i], "--analyze") == 0)
+            analysis = true;
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            traceFile = argv[++i];
+        else if (std::strcmp(argv[i], "--hist") == 0 && i + 1 < argc)
+            histogram = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--generate") == 0 && i + 1 < argc)
+            generate = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--gen") == 0 && i + 1 < argc)
+        {
+            if (!parseGenerator(argv[++i], generatorOptions, seed))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--dump") == 0)
+            dump = true;
+        else if (std::strcmp(argv[i], "--releases") == 0 && i + 1 < argc)
+        {
+            if (!parseReleases(argv[++i], releases))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--server") == 0 && i + 1 < argc)
+        {
+            if (!parseServer(argv[++i], server))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--resources") == 0 && i + 1 < argc)
+        {
+            if (!alg::parseProtocol(argv[++i], protocol))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc)
+        {
+            if (!parsePolicy(argv[++i], policy))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            multiprocessor.cores = static_cast<alg::uint>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--partition") == 0 && i + 1 < argc)
+        {
+            if (!alg::parseHeuristic(argv[++i], multiprocessor.heuristic, multiprocessor.decreasing))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+            multiprocessor.mode = alg::MultiprocessorMode::PARTITIONED;
+        }
+        else if (std::strcmp(argv[i], "--list") == 0)
+        {
+            for (const alg::PolicyInfo &info : alg::policies())
+                std::printf("%-13s %s\n", info.name.c_str(), info.description.c_str());
+            return 0;
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+            files.push_back(argv[i]);
+    }
+
+    if (files.empty() == (generate == 0) || multiprocessor.cores == 0 || multiprocessor.cores > 0xffff)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // testy szeregowalności dotyczą jednego procesora
+    const bool partitioned = multiprocessor.cores > 1 && multiprocessor.mode == alg::MultiprocessorMode::PARTITIONED;
+    if (analysis && multiprocessor.cores > 1 && !batch)
+    {
+        std::fprintf(stderr, "--analyze dotyczy jednego procesora, nie mozna go uzyc z -m\n");
+        return 2;
+    }
+    if (server.enabled() && multiprocessor.cores > 1)
+    {
+        std::fprintf(stderr, "--server dotyczy jednego procesora, nie mozna go uzyc z -m\n");
+        return 2;
+    }
+    if (protocol != alg::ResourceProtocol::NONE && multiprocessor.cores > 1)
+    {
+        std::fprintf(stderr, "--resources dotyczy jednego procesora, nie mozna go uzyc z -m\n");
+        return 2;
+    }
+
+    // zestawy losowane są zamiast wczytywania plików, ten sam generator i ziarno dają te same zestawy
+    alg::TaskSetGenerator generator(generatorOptions, seed);
+    if (generate > 0)
+    {
+        if (!generator.valid())
+        {
+            std::fprintf(stderr, "Niepoprawne ustawienia generatora\n");
+            return 2;
+        }
+        files.push_back("generator");
+    }
+
+    if (dump)
+    {
+        alg::TaskSet tasks;
+        for (std::size_t i = 0; i < generate; ++i)
+        {
+            if (!generator.generate(tasks))
+            {
+                std::fprintf(stderr, "Nie udalo sie wylosowac zestawu\n");
+                return 1;
+            }
+            if (i > 0)
+                std::cout << '\n';
+            alg::writeTaskSet(std::cout, tasks);
+        }
+        return 0;
+    }
+
+    // wybieramy algorytmy do uruchomienia
+    std::vector<std::string> algorithms;
+    if (algorithm == "all")
+        algorithms = alg::engineNames();
+    else if (alg::createEngine(algorithm))
+        algorithms.push_back(algorithm);
+    else
+    {
+        std::fprintf(stderr, "Nieznany algorytm: %s\n", algorithm.c_str());
+        return 2;
+    }
+
+    // przebieg zapisujemy tylko dla pojedynczej symulacji
+    if (!traceFile.empty() && (batch || files.size() != 1 || algorithms.size() != 1 || horizons.size() != 1))
+    {
+        std::fprintf(stderr, "--trace wymaga jednego pliku, algorytmu i czasu, bez --batch\n");
+        return 2;
+    }
+
+    // plik zwolnień sprawdzamy przed symulacją, by błąd nie przerwał jej w połowie
+    std::string arrivalsError;
+    if (!releases.arrivals.empty() && !alg::checkArrivals(releases.arrivals, arrivalsError))
+    {
+        std::fprintf(stderr, "%s\n", arrivalsError.c_str());
+        return 1;
+    }
+
+    int result = 0;
+
+    if (batch)
+    {
+        alg::BatchOptions options;
+        options.events = events;
+        options.shortcut = shortcut;
+        options.prefilter = analysis;
+        options.multiprocessor = multiprocessor;
+        options.releases = releases;
+        options.server = server;
+        options.resources = protocol;
+        options.policy = policy;
+
+        alg::ThreadPool pool(threads);
+        std::vector<alg::BatchSummary> summary;
+
+        if (generate > 0)
+        {
+            // losowane zestawy symulujemy porcjami, więc pamięć nie zależy od ich liczby
+            const std::size_t portion = 65536;
+            std::vector<alg::TaskSet> sets;
+            for (std::size_t done = 0; done < generate; done += sets.size())
+            {
+                sets.resize(std::min(portion, generate - done));
+                for (alg::TaskSet &tasks : sets)
+                {
+                    if (!generator.generate(tasks))
+                    {
+                        std::fprintf(stderr, "Nie udalo sie wylosowac zestawu\n");
+                        return 1;
+                    }
+                }
+
+                std::vector<alg::BatchSummary> part = alg::simulateBatch(pool, sets, algorithms, horizons, options);
+                if (summary.empty())
+                    summary = part;
+                else
+                {
+                    for (std::size_t k = 0; k < summary.size(); ++k)
+                        summary[k].merge(part[k]);
+                }
+            }
+        }
+        else
+        {
+            // wczytujemy wszystkie zestawy i symulujemy je równolegle
+            std::vector<alg::TaskSet> sets;
+            for (const std::string &file : files)
+            {
+                if (!loadFile(file, sets))
+                    return 1;
+            }
+            summary = alg::simulateBatch(pool, sets, algorithms, horizons, options);
+        }
+        printSummary(summary, policy.switchCost > 0);
+
+        for (const alg::BatchSummary &s : summary)
+        {
+            if (s.failedSets > 0)
+                result = 3;
+        }
+        return result;
+    }
+
+    // procesory zestawu podzielonego symulowane są równolegle
+    alg::ThreadPool pool(partitioned ? std::min<std::size_t>(threads ? threads : multiprocessor.cores, multiprocessor.cores) : 1);
+
+    for (const std::string &file : files)
+    {
+        // wczytujemy zestawy zadań
+        std::vector<alg::TaskSet> sets;
+        if (generate > 0)
+        {
+            sets = generator.generate(generate);
+            if (sets.empty())
+            {
+                std::fprintf(stderr, "Nie udalo sie wylosowac zestawu\n");
+                return 1;
+            }
+        }
+        else if (!loadFile(file, sets))
+            return 1;
+
+        if (!traceFile.empty() && sets.size() != 1)
+        {
+            std::fprintf(stderr, "%s: --trace wymaga pliku z jednym zestawem zadan\n", file.c_str());
+            return 2;
+        }
+
+        // symulujemy każdy zestaw każdym algorytmem
+        for (std::size_t i = 0; i < sets.size(); ++i)
+        {
+            for (const std::string &name : algorithms)
+            {
+                for (alg::uint endTime : horizons)
+                {
+                    alg::SimulationStats stats;
+                    alg::Partition partition;
+
+                    if (partitioned && traceFile.empty())
+                    {
+                        // bez przebiegu procesory symulowane są równolegle, bez buforowania odcinków
+                        stats = alg::simulateMultiprocessor(name, sets[i], endTime, multiprocessor, events, shortcut,
+                                                            histogram, &pool, &partition, releases, policy);
+                    }
+                    else
+                    {
+                        std::unique_ptr<alg::SchedulerEngine> engine = alg::createEngine(name, multiprocessor);
+                        engine->tasks = sets[i];
+                        engine->setHyperperiodShortcut(shortcut);
+                        engine->setReleaseOptions(releases);
+                        engine->setServerOptions(server);
+                        engine->setResourceProtocol(protocol);
+                        engine->setPolicyOptions(policy);
+
+                        // przebieg zapisywany jest na bieżąco, w trakcie symulacji
+                        alg::TraceWriter writer;
+                        if (!traceFile.empty() && !writer.open(traceFile, name, sets[i], multiprocessor.cores))
+                        {
+                            std::fprintf(stderr, "%s: nie mozna utworzyc pliku\n", traceFile.c_str());
+                            return 1;
+                        }
+
+                        stats = alg::simulate(*engine, endTime, events, traceFile.empty() ? nullptr : &writer, histogram);
+
+                        if (!traceFile.empty() && !writer.close(engine->currentTime()))
+                        {
+                            std::fprintf(stderr, "%s: blad zapisu\n", traceFile.c_str());
+                            return 1;
+                        }
+                        if (partitioned)
+                            partition = alg::partitionTasks(sets[i], multiprocessor.cores, multiprocessor.heuristic,
+                                                            multiprocessor.decreasing);
+                    }
+
+                    if (analysis)
+                    {
+                        alg::SchedulabilityReport report = alg::analyze(name, sets[i]);
+                        // testy nie uwzględniają kosztu przełączania kontekstu
+                        if (policy.switchCost > 0)
+                            report.verdict = alg::Verdict::UNKNOWN;
+                        printStats(file, i, name, stats, &report, nullptr, &server, protocol);
+                    }
+                    else
+                        printStats(file, i, name, stats, nullptr, partitioned ? &partition : nullptr, &server, protocol);
+
+                    if (!stats.systemOk)
+                        result = 3;
+                }
+            }
+        }
+    }
+
+    // kod 3 oznacza, że któryś zestaw przekroczył termin
+    return result;
+}
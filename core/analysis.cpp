@@ -0,0 +1,332 @@
+#include "analysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+#include "registry.h"
+
+namespace alg
+{
+    namespace
+    {
+        //! Największa liczba kroków analizy zapotrzebowania
+        const std::size_t maxDemandSteps = 1000000;
+
+        //! Funkcja zwraca termin względny, przed którym instancja musi się zakończyć
+        std::uint64_t effectiveDeadline(const Task& t)
+        {
+            return static_cast<std::uint64_t>(std::min(t.deadline, t.period));
+        }
+
+        //! Funkcja sprawdza czy parametry zadań pozwalają na analizę
+        bool valid(const std::vector<Task>& tasks)
+        {
+            for (const Task &t : tasks)
+            {
+                if (t.period <= 0 || t.deadline <= 0 || t.time < 0)
+                    return false;
+            }
+            return true;
+        }
+
+        //! Funkcja sprawdza czy terminy zadań nie przekraczają okresów
+        bool constrainedDeadlines(const std::vector<Task>& tasks)
+        {
+            for (const Task &t : tasks)
+            {
+                if (t.deadline > t.period)
+                    return false;
+            }
+            return true;
+        }
+
+        //! Funkcja sprawdza czy priorytety zadań są uporządkowane według terminów, jak w DMS
+        /*!
+        Przy równym priorytecie wyższy ma zadanie o mniejszym id, tak jak w responseTimeTest().
+        */
+        bool deadlineMonotonic(const std::vector<Task>& tasks, bool (*higher)(const Task&, const Task&))
+        {
+            std::vector<std::size_t> order(tasks.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+            {
+                if (higher(tasks[a], tasks[b]))
+                    return true;
+                if (higher(tasks[b], tasks[a]))
+                    return false;
+                return a < b;
+            });
+
+            for (std::size_t i = 1; i < order.size(); ++i)
+            {
+                if (effectiveDeadline(tasks[order[i]]) < effectiveDeadline(tasks[order[i - 1]]))
+                    return false;
+            }
+            return true;
+        }
+
+        //! Funkcja zwraca gęstość zadania (czas wykonania do terminu)
+        double density(const Task& t)
+        {
+            return static_cast<double>(t.time) / static_cast<double>(effectiveDeadline(t));
+        }
+
+        //! Funkcja zwraca zapotrzebowanie na procesor zadań z terminami do chwili t włącznie
+        std::uint64_t demand(const std::vector<Task>& tasks, std::uint64_t t)
+        {
+            std::uint64_t sum = 0;
+            for (const Task &task : tasks)
+            {
+                std::uint64_t d = effectiveDeadline(task);
+                if (t >= d)
+                    sum += ((t - d) / static_cast<std::uint64_t>(task.period) + 1) * static_cast<std::uint64_t>(task.time);
+            }
+            return sum;
+        }
+
+        //! Funkcja zwraca największy termin bezwzględny mniejszy od t lub 0 gdy takiego nie ma
+        std::uint64_t previousDeadline(const std::vector<Task>& tasks, std::uint64_t t)
+        {
+            std::uint64_t best = 0;
+            for (const Task &task : tasks)
+            {
+                std::uint64_t d = effectiveDeadline(task);
+                if (task.time == 0 || t <= d)
+                    continue;
+
+                std::uint64_t period = static_cast<std::uint64_t>(task.period);
+                best = std::max(best, (t - 1 - d) / period * period + d);
+            }
+            return best;
+        }
+    }
+
+    const char* verdictName(Verdict verdict)
+    {
+        switch (verdict)
+        {
+        case Verdict::SCHEDULABLE:
+            return "szeregowalny";
+        case Verdict::UNSCHEDULABLE:
+            return "nieszeregowalny";
+        default:
+            return "nierozstrzygniety";
+        }
+    }
+
+    double utilization(const std::vector<Task>& tasks)
+    {
+        double sum = 0.0;
+        for (const Task &t : tasks)
+        {
+            if (t.period > 0)
+                sum += static_cast<double>(t.time) / t.period;
+        }
+        return sum;
+    }
+
+    Verdict liuLaylandTest(const std::vector<Task>& tasks)
+    {
+        if (tasks.empty())
+            return Verdict::SCHEDULABLE;
+        if (!valid(tasks))
+            return Verdict::UNKNOWN;
+
+        // zadanie (C, T, D) zastępujemy zadaniem (C, D, D), dla którego DMS to RMS
+        double sum = 0.0;
+        for (const Task &t : tasks)
+            sum += density(t);
+
+        double n = static_cast<double>(tasks.size());
+        return sum <= n * (std::pow(2.0, 1.0 / n) - 1.0) ? Verdict::SCHEDULABLE : Verdict::UNKNOWN;
+    }
+
+    Verdict hyperbolicTest(const std::vector<Task>& tasks)
+    {
+        if (!valid(tasks))
+            return Verdict::UNKNOWN;
+
+        double product = 1.0;
+        for (const Task &t : tasks)
+            product *= density(t) + 1.0;
+
+        return product <= 2.0 ? Verdict::SCHEDULABLE : Verdict::UNKNOWN;
+    }
+
+    Verdict responseTimeTest(const std::vector<Task>& tasks, bool (*higher)(const Task&, const Task&),
+                             std::vector<uint>* responses)
+    {
+        if (responses)
+            responses->assign(tasks.size(), unboundedResponse);
+
+        if (!valid(tasks))
+            return Verdict::UNKNOWN;
+
+        // porządkujemy zadania od najwyższego priorytetu, przy równym decyduje id
+        std::vector<std::size_t> order(tasks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+        {
+            if (higher(tasks[a], tasks[b]))
+                return true;
+            if (higher(tasks[b], tasks[a]))
+                return false;
+            return a < b;
+        });
+
+        Verdict result = Verdict::SCHEDULABLE;
+
+        for (std::size_t k = 0; k < order.size(); ++k)
+        {
+            const Task &task = tasks[order[k]];
+            std::uint64_t deadline = effectiveDeadline(task);
+            std::uint64_t response = static_cast<std::uint64_t>(task.time);
+
+            // iterujemy aż do punktu stałego lub przekroczenia terminu
+            for (;;)
+            {
+                std::uint64_t next = static_cast<std::uint64_t>(task.time);
+                for (std::size_t j = 0; j < k; ++j)
+                {
+                    const Task &h = tasks[order[j]];
+                    std::uint64_t period = static_cast<std::uint64_t>(h.period);
+                    next += (response + period - 1) / period * static_cast<std::uint64_t>(h.time);
+                }
+
+                if (next == response || next > deadline)
+                {
+                    response = next;
+                    break;
+                }
+                response = next;
+            }
+
+            if (response > deadline)
+            {
+                // zadania o niższym priorytecie i tak sprawdzamy, by podać ich czasy odpowiedzi
+                result = Verdict::UNSCHEDULABLE;
+                continue;
+            }
+
+            if (responses)
+                (*responses)[order[k]] = static_cast<uint>(response);
+        }
+
+        return result;
+    }
+
+    Verdict demandTest(const std::vector<Task>& tasks)
+    {
+        if (!valid(tasks))
+            return Verdict::UNKNOWN;
+
+        // wykorzystanie liczymy dokładnie, jako ułamek o mianowniku równym hiperokresowi
+        uint hyper = hyperperiod(tasks);
+        double u = utilization(tasks);
+        if (hyper != 0)
+        {
+            std::uint64_t work = 0;
+            for (const Task &t : tasks)
+                work += static_cast<std::uint64_t>(hyper) / static_cast<std::uint64_t>(t.period) * static_cast<std::uint64_t>(t.time);
+
+            if (work > hyper)
+                return Verdict::UNSCHEDULABLE;
+            u = static_cast<double>(work) / hyper;
+        }
+        else if (u > 1.0)
+            return Verdict::UNSCHEDULABLE;
+
+        // ograniczenie Baruaha i najkrótszy termin
+        std::uint64_t maxDeadline = 0;
+        std::uint64_t minDeadline = std::numeric_limits<std::uint64_t>::max();
+        double weighted = 0.0;
+        for (const Task &t : tasks)
+        {
+            if (t.time == 0)
+                continue;
+
+            std::uint64_t d = effectiveDeadline(t);
+            maxDeadline = std::max(maxDeadline, d);
+            minDeadline = std::min(minDeadline, d);
+            weighted += static_cast<double>(t.period - static_cast<int>(d)) * t.time / t.period;
+        }
+
+        if (maxDeadline == 0)
+            return Verdict::SCHEDULABLE;
+
+        std::uint64_t bound;
+        if (u < 1.0)
+            bound = std::max<std::uint64_t>(maxDeadline, static_cast<std::uint64_t>(std::ceil(weighted / (1.0 - u))));
+        else if (hyper != 0)
+            bound = static_cast<std::uint64_t>(hyper) + maxDeadline;
+        else
+            return Verdict::UNKNOWN;
+
+        if (hyper != 0)
+            bound = std::min(bound, static_cast<std::uint64_t>(hyper) + maxDeadline);
+
+        // QPA: schodzimy od największego terminu poniżej ograniczenia
+        std::uint64_t t = previousDeadline(tasks, bound + 1);
+        std::uint64_t h = demand(tasks, t);
+        for (std::size_t step = 0; h <= t && h > minDeadline; ++step)
+        {
+            // przy wykorzystaniu bliskim 1 ograniczenie może być bardzo duże
+            if (step == maxDemandSteps)
+                return Verdict::UNKNOWN;
+
+            t = h < t ? h : previousDeadline(tasks, t);
+            h = demand(tasks, t);
+        }
+
+        return h <= minDeadline ? Verdict::SCHEDULABLE : Verdict::UNSCHEDULABLE;
+    }
+
+    SchedulabilityReport analyze(const std::string& algorithm, const std::vector<Task>& tasks)
+    {
+        SchedulabilityReport report;
+        report.utilization = utilization(tasks);
+
+        // symulator nie zgłasza przekroczeń terminów dłuższych od okresów, więc testy nie odpowiadałyby jego wynikom
+        if (!constrainedDeadlines(tasks))
+            return report;
+
+        // testy nie mają składnika blokowania, a sekcje krytyczne opóźniają zadania o wyższym priorytecie
+        // niezależnie od protokołu dostępu do zasobów
+        if (hasCriticalSections(tasks))
+            return report;
+
+        report.demand = demandTest(tasks);
+
+        // gdy zapotrzebowanie przekracza czas, żaden algorytm nie zdąży
+        bool infeasible = report.demand == Verdict::UNSCHEDULABLE;
+
+        const PolicyInfo* policy = findPolicy(algorithm);
+        switch (policy ? policy->analysis : PolicyAnalysis::NONE)
+        {
+        case PolicyAnalysis::RESPONSE_TIME:
+            // ograniczenia wykorzystania dotyczą tylko priorytetów uporządkowanych według terminów
+            if (deadlineMonotonic(tasks, policy->higher))
+            {
+                report.liuLayland = liuLaylandTest(tasks);
+                report.hyperbolic = hyperbolicTest(tasks);
+            }
+            report.responseTime = responseTimeTest(tasks, policy->higher, &report.responses);
+            report.verdict = report.responseTime;
+            break;
+        case PolicyAnalysis::DEMAND:
+            report.verdict = report.demand;
+            break;
+        case PolicyAnalysis::NONE:
+            // np. swoboda LLF liczona jest od terminu względnego, więc LLF nie musi być optymalny jak EDF
+            // i pozytywny wynik analizy zapotrzebowania niczego nie przesądza
+            break;
+        }
+
+        if (infeasible)
+            report.verdict = Verdict::UNSCHEDULABLE;
+
+        return report;
+    }
+}
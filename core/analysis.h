@@ -0,0 +1,89 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Wynik testu szeregowalności
+    enum class Verdict
+    {
+        SCHEDULABLE,   //!< żadne zadanie nie przekroczy terminu
+        UNSCHEDULABLE, //!< któreś zadanie przekroczy termin
+        UNKNOWN        //!< test nie rozstrzyga, potrzebna jest symulacja
+    };
+
+    //! Funkcja zwraca opis wyniku testu
+    const char* verdictName(Verdict verdict);
+
+    //! Wartość oznaczająca nieograniczony czas odpowiedzi
+    const uint unboundedResponse = std::numeric_limits<uint>::max();
+
+    //! Wyniki analizy szeregowalności zestawu zadań
+    /*!
+    Testy zakładają model symulatora: wszystkie zadania zwalniane są w chwili 0,
+    a instancja niedokończona w chwili terminu przekracza go i jest porzucana.
+    Instancja zadania z terminem dłuższym od okresu jest natomiast porzucana przy kolejnym
+    zwolnieniu bez przekroczenia terminu, więc dla zestawów z takimi zadaniami analyze()
+    zwraca UNKNOWN i rozstrzyga je dopiero symulacja. Testy nie uwzględniają też blokowania
+    na zasobach, więc tak samo traktowane są zestawy z sekcjami krytycznymi.
+    */
+    struct SchedulabilityReport
+    {
+        double utilization {0.0};                //!< wykorzystanie procesora
+        Verdict liuLayland {Verdict::UNKNOWN};   //!< ograniczenie Liu i Laylanda (stałe priorytety uporządkowane według terminów)
+        Verdict hyperbolic {Verdict::UNKNOWN};   //!< ograniczenie hiperboliczne (stałe priorytety uporządkowane według terminów)
+        Verdict responseTime {Verdict::UNKNOWN}; //!< analiza czasu odpowiedzi (PolicyAnalysis::RESPONSE_TIME)
+        Verdict demand {Verdict::UNKNOWN};       //!< analiza zapotrzebowania procesora (dokładna dla PolicyAnalysis::DEMAND, np. EDF)
+        Verdict verdict {Verdict::UNKNOWN};      //!< wynik dla wybranego algorytmu
+        std::vector<uint> responses;             //!< najgorsze czasy odpowiedzi zadań z analizy czasu odpowiedzi
+    };
+
+    //! Funkcja zwraca wykorzystanie procesora przez zadania
+    double utilization(const std::vector<Task>& tasks);
+
+    //! Test Liu i Laylanda dla priorytetów według terminów
+    /*!
+    Warunek dostateczny: suma C / min(D, T) <= n (2^(1/n) - 1).
+    \return SCHEDULABLE lub UNKNOWN
+    */
+    Verdict liuLaylandTest(const std::vector<Task>& tasks);
+
+    //! Test hiperboliczny dla priorytetów według terminów
+    /*!
+    Warunek dostateczny: iloczyn (C / min(D, T) + 1) <= 2.
+    \return SCHEDULABLE lub UNKNOWN
+    */
+    Verdict hyperbolicTest(const std::vector<Task>& tasks);
+
+    //! Dokładna analiza czasu odpowiedzi dla stałych priorytetów
+    /*!
+    Dla każdego zadania szuka najmniejszego punktu stałego R = C + suma ceil(R / Tj) Cj
+    po zadaniach o wyższym priorytecie. Przy równym priorytecie wyższy ma zadanie o mniejszym id,
+    tak jak w kolejce zadań gotowych.
+    \param tasks zadania
+    \param higher funkcja porównująca priorytety, np. DMSPolicy::higher
+    \param responses najgorsze czasy odpowiedzi lub nullptr
+    */
+    Verdict responseTimeTest(const std::vector<Task>& tasks, bool (*higher)(const Task&, const Task&),
+                             std::vector<uint>* responses = nullptr);
+
+    //! Analiza zapotrzebowania procesora (dokładny test EDF)
+    /*!
+    Sprawdza h(t) <= t dla terminów t poniżej ograniczenia Baruaha, przeglądając je algorytmem QPA.
+    Niepowodzenie oznacza, że żaden algorytm nie uszereguje zadań.
+    */
+    Verdict demandTest(const std::vector<Task>& tasks);
+
+    //! Funkcja wykonuje testy właściwe dla podanego algorytmu
+    /*!
+    Test wybierany jest według PolicyInfo::analysis polityki z rejestru, więc polityka
+    dopisana przez registerPolicy() nie wymaga zmian w analizie.
+    \param algorithm nazwa algorytmu, jak w createEngine()
+    \param tasks zadania
+    */
+    SchedulabilityReport analyze(const std::string& algorithm, const std::vector<Task>& tasks);
+}
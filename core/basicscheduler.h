@@ -0,0 +1,1013 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "policies.h"
+#include "release.h"
+#include "resources.h"
+#include "server.h"
+#include "task.h"
+#include "trace.h"
+#include "tasktable.h"
+#include "readyqueue.h"
+
+namespace alg
+{
+    //! Silnik harmonogramu
+    /*!
+    Klasa bazowa silnika harmonogramu niezależna od Qt.
+    Metody wirtualne wywoływane są raz na symulację, cała pętla symulacji
+    znajduje się w klasie szablonowej BasicScheduler.
+    */
+    class SchedulerEngine
+    {
+    public:
+        //! Destruktor
+        virtual ~SchedulerEngine() = default;
+
+        //! Metoda symulująca działanie harmonogramu cykl po cyklu
+        virtual void schedule(uint endTime) = 0;
+        //! Metoda symulująca działanie harmonogramu sterowana zdarzeniami
+        virtual void scheduleEvents(uint endTime) = 0;
+        //! Funkcja sprawdza czy możliwe jest zasymulowanie kolejnego cyklu
+        virtual bool nextTick(bool print = true) = 0;
+        //! Funkcja zawraca id najlepszego zadania
+        virtual int getBestTaskId() const = 0;
+
+        //! Funkcja zwraca liczbę procesorów
+        virtual uint cores() const { return 1; }
+
+        //! Funkcja zwraca akttualny czas symulacji
+        uint currentTime() const { return mCurrentTime; }
+        //! Funkcja zwraca czy w ostatniej symulacji żadne zadanie nie przekroczyło terminu
+        bool systemOk() const { return mSystemOk; }
+        //! Funkcja zwraca liczbę obiegów pętli ostatniej symulacji
+        /*!
+        W symulacji cykl po cyklu jest to liczba zasymulowanych cykli, a w symulacji
+        sterowanej zdarzeniami liczba odcinków pomiędzy zdarzeniami. Powtórzone hiperokresy nie są liczone.
+        */
+        std::uint64_t steps() const { return mSteps; }
+
+        //! Metoda ustawia odbiorcę przebiegu symulacji
+        /*!
+        \param sink odbiorca lub nullptr gdy przebieg nie jest potrzebny
+        */
+        void setTraceSink(TraceSink* sink) { mSink = sink; }
+
+        //! Metoda włącza lub wyłącza pomijanie powtarzających się hiperokresów
+        /*!
+        Gdy stan wszystkich zadań po hiperokresie jest taki sam jak na jego początku,
+        dalsza część symulacji jest powtórzeniem i nie jest symulowana.
+        Przebieg i statystyki są wtedy powielane. Domyślnie włączone.
+        */
+        void setHyperperiodShortcut(bool enabled) { mShortcut = enabled; }
+
+        //! Metoda ustawia rozmiar fragmentu symulacji
+        /*!
+        Co podaną liczbę cykli silnik przekazuje odbiorcy zebrany przebieg i postęp
+        (TraceSink::progress()) oraz sprawdza flagę przerwania.
+        \param ticks rozmiar fragmentu, 0 wyłącza podział na fragmenty
+        */
+        void setChunk(uint ticks) { mChunk = ticks; }
+
+        //! Metoda ustawia flagę przerwania symulacji
+        /*!
+        Flaga może być ustawiona z innego wątku, silnik sprawdza ją na granicach fragmentów.
+        \param token flaga lub nullptr
+        */
+        void setCancelToken(const std::atomic<bool>* token) { mCancel = token; }
+
+        //! Funkcja zwraca czy ostatnia symulacja została przerwana
+        bool cancelled() const { return mCancelled; }
+
+        //! Metoda ustawia ziarno, odstępy zadań sporadycznych i plik zwolnień zadań aperiodycznych
+        /*!
+        Dotyczy symulacji zadań, które nie są ściśle okresowe (isStrictlyPeriodic()). Są one
+        zwalniane przez GeneratedReleases, a pomijanie hiperokresów jest wtedy wyłączone.
+        Błąd pliku zwolnień nie przerywa symulacji, plik należy sprawdzić wcześniej funkcją checkArrivals().
+        */
+        void setReleaseOptions(const ReleaseOptions& options) { mGeneratedReleases.setOptions(options); }
+
+        //! Funkcja zwraca ustawienia zwolnień zadań
+        const ReleaseOptions& releaseOptions() const { return mGeneratedReleases.options(); }
+
+        //! Metoda ustawia własny strumień zwolnień
+        /*!
+        \param stream strumień zwalniający wszystkie zadania, również ściśle okresowe,
+        lub nullptr by użyć GeneratedReleases; strumień musi istnieć do końca symulacji
+        */
+        void setReleaseStream(ReleaseStream* stream) { mCustomReleases = stream; }
+
+        //! Metoda ustawia serwer zadań aperiodycznych
+        /*!
+        Serwer obsługuje zadania aperiodyczne (Arrival::APERIODIC) w kolejności zwolnień,
+        tylko w silnikach, które go obsługują (serverSupported()). W pozostałych silnikach
+        zadania aperiodyczne szeregowane są tak jak pozostałe zadania.
+        */
+        void setServerOptions(const ServerOptions& options) { mServerOptions = options; }
+
+        //! Funkcja zwraca ustawienia serwera zadań aperiodycznych
+        const ServerOptions& serverOptions() const { return mServerOptions; }
+
+        //! Funkcja zwraca czy silnik obsługuje serwer zadań aperiodycznych
+        virtual bool serverSupported() const { return false; }
+
+        //! Funkcja zwraca czy w ostatniej symulacji zadania aperiodyczne obsługiwał serwer
+        bool serving() const { return mServing; }
+
+        //! Metoda ustawia protokół dostępu do zasobów współdzielonych
+        /*!
+        Sekcje krytyczne zadań (Task::sections) uwzględniają tylko silniki, które je obsługują
+        (resourcesSupported()). Dziedziczenie i pułap priorytetu wymagają stałych priorytetów,
+        w pozostałych algorytmach zadania czekają na zasoby bez zmiany priorytetów.
+        */
+        void setResourceProtocol(ResourceProtocol protocol) { mResourceProtocol = protocol; }
+
+        //! Funkcja zwraca protokół dostępu do zasobów współdzielonych
+        ResourceProtocol resourceProtocol() const { return mResourceProtocol; }
+
+        //! Funkcja zwraca czy silnik obsługuje sekcje krytyczne zadań
+        virtual bool resourcesSupported() const { return false; }
+
+        //! Funkcja zwraca czy w ostatniej symulacji zadania zajmowały zasoby
+        bool locking() const { return mLocking; }
+
+        //! Metoda ustawia parametry polityki szeregowania
+        /*!
+        Kwant czasu dotyczy polityki round-robin, a histereza i remisy LLF z histerezą, pozostałe polityki je pomijają.
+        Koszt przełączenia kontekstu nalicza silnik, niezależnie od polityki.
+        */
+        void setPolicyOptions(const PolicyOptions& options) { mPolicyOptions = options; }
+
+        //! Funkcja zwraca parametry polityki szeregowania
+        const PolicyOptions& policyOptions() const { return mPolicyOptions; }
+
+        std::vector<Task> tasks; //!< tablica zadań
+
+    protected:
+        //! Funkcja wybiera strumień zwolnień na początek symulacji
+        /*!
+        \param endTime czas zakończenia symulacji, zwolnienia od tej chwili są pomijane
+        \return true jeżeli zadania zwalniane są ze strumienia, false gdy co okres przez TaskTable
+        */
+        bool beginReleases(uint endTime)
+        {
+            mReleaseEnd = endTime;
+            mReleaseStream = mCustomReleases ? mCustomReleases : isStrictlyPeriodic(tasks) ? nullptr : &mGeneratedReleases;
+            if (mReleaseStream)
+                mReleaseStream->begin(tasks);
+            return mReleaseStream != nullptr;
+        }
+
+        //! Funkcja zwraca liczbę cykli do najbliższego zwolnienia ze strumienia
+        uint releaseDistance() const
+        {
+            if (!mReleaseStream)
+                return std::numeric_limits<uint>::max();
+
+            uint next = mReleaseStream->nextTime();
+            if (next == std::numeric_limits<uint>::max())
+                return next;
+            return next > mCurrentTime ? next - mCurrentTime : 1;
+        }
+
+        //! Metoda przygotowuje podział symulacji na fragmenty
+        void beginChunks()
+        {
+            mCancelled = false;
+            mNextChunk = mChunk > 0 ? mChunk : std::numeric_limits<uint>::max();
+        }
+
+        //! Funkcja kończy fragment symulacji
+        /*!
+        \return false gdy symulacja ma zostać przerwana
+        */
+        bool nextChunk()
+        {
+            mTrace.progress(mCurrentTime);
+
+            if (mCancel && mCancel->load(std::memory_order_relaxed))
+            {
+                mCancelled = true;
+                return false;
+            }
+
+            std::uint64_t next = static_cast<std::uint64_t>(mCurrentTime) + mChunk;
+            mNextChunk = static_cast<uint>(std::min<std::uint64_t>(next, std::numeric_limits<uint>::max()));
+            return true;
+        }
+
+
+        uint mCurrentTime   {0};    //!< czas symulacji
+        int mLastTaskId     {-1};   //!< id ostaniego wykonanego zadania. Wartośc -1 oznacza brak zadania
+        bool mSystemOk      {true};  //!< flaga sprawdzająca czy system działa
+        bool mShortcut      {true};  //!< flaga pomijania powtarzających się hiperokresów
+        bool mCancelled     {false}; //!< czy ostatnia symulacja została przerwana
+        uint mChunk         {0};     //!< rozmiar fragmentu symulacji, 0 wyłącza podział
+        uint mNextChunk     {0};     //!< koniec bieżącego fragmentu
+        std::uint64_t mSteps {0};    //!< liczba obiegów pętli symulacji
+        const std::atomic<bool>* mCancel {nullptr}; //!< flaga przerwania symulacji
+        TraceSink* mSink    {nullptr};  //!< odbiorca przebiegu symulacji
+        TraceRecorder mTrace;           //!< bufor przebiegu symulacji
+        ReleaseStream* mReleaseStream {nullptr};  //!< strumień zwolnień bieżącej symulacji lub nullptr
+        ReleaseStream* mCustomReleases {nullptr}; //!< strumień ustawiony przez setReleaseStream()
+        GeneratedReleases mGeneratedReleases;     //!< zwolnienia wyznaczane z parametrów zadań
+        std::vector<int> mDue;                    //!< zadania zwolnione w bieżącym cyklu
+        uint mReleaseEnd {0};                     //!< chwila zakończenia symulacji dla strumienia zwolnień
+        ServerOptions mServerOptions;             //!< ustawienia serwera zadań aperiodycznych
+        bool mServing {false};                    //!< czy w bieżącej symulacji działa serwer
+        ResourceProtocol mResourceProtocol {ResourceProtocol::NONE}; //!< protokół dostępu do zasobów
+        bool mLocking {false};                    //!< czy w bieżącej symulacji zadania zajmują zasoby
+        PolicyOptions mPolicyOptions;             //!< parametry polityki szeregowania
+    };
+
+    //! Harmonogram z polityką wybieraną w czasie kompilacji
+    /*!
+    Polityka dostarcza statyczne funkcje higher() i runLength(), dzięki czemu
+    porównania zadań w kolejce zadań gotowych są rozwijane w miejscu wywołania.
+    Polityka wybiera też strukturę kolejki zadań gotowych (Policy::Queue) i może reagować
+    na zwolnienie, wykonanie i zakończenie instancji oraz zmianę wykonywanego zadania (PolicyHooks).
+
+    Na czas symulacji zadania kopiowane są do tablicy TaskTable, a po jej zakończeniu
+    stan zadań zapisywany jest z powrotem do tablicy tasks.
+
+    Dla polityk o stałych priorytetach (Policy::fixedPriority) zadania aperiodyczne mogą być
+    obsługiwane przez serwer (setServerOptions()). Serwer jest w kolejce zadań gotowych
+    dodatkowym wpisem o id równym liczbie zadań, gotowym gdy ma budżet i zadania do obsłużenia,
+    a wybrany przez getBestTaskId() zamieniany jest na pierwsze oczekujące zadanie aperiodyczne.
+
+    Zadania z sekcjami krytycznymi zajmują zasoby w chwili wyboru do wykonania (acquire()).
+    Zadanie czekające na zasób usuwane jest z kolejki zadań gotowych, a priorytet dziedziczony
+    (PIP) lub pułap zasobu (PCP) zapisywany jest jako id zadania, którego priorytet porównuje TaskLess.
+
+    Z niezerowym kosztem przełączenia kontekstu (PolicyOptions::switchCost) wybrane zadanie,
+    którego kontekstu nie ma na procesorze, wykonuje się dopiero po tylu cyklach przełączania
+    (SegmentKind::SWITCH). Kontekst pozostaje na procesorze w czasie bezczynności, więc tak jak
+    w StatsCollector przerwa pomiędzy wykonaniami tego samego zadania nie jest przełączeniem.
+    Zdarzenie w trakcie przełączania może wybrać inne zadanie, które zaczyna przełączanie od nowa.
+
+    \tparam Policy polityka szeregowania, np. DMSPolicy lub EDFPolicy (policies.h)
+    */
+    template <typename Policy>
+    class BasicScheduler final : public SchedulerEngine
+    {
+    public:
+        bool serverSupported() const override { return Policy::fixedPriority; }
+        bool resourcesSupported() const override { return true; }
+
+        //! Metoda symulująca działanie harmonogramu
+        /*!
+        \param endTime czas zakończenia symulacji
+        */
+        void schedule(uint endTime) override
+        {
+            //Wywałane po ty tylko by nabić dane w zadaiach
+            mTable.load(tasks, !beginReleases(endTime));
+            mQueued.resize(tasks.size() + 1);
+            mReady.reset(tasks.size() + 1);
+            beginPolicy();
+            beginServer();
+            beginLocks();
+            mTrace.begin(mSink);
+            // pierwszy cykl przypada na chwilę 0, w której następują pierwsze zwolnienia
+            mCurrentTime = std::numeric_limits<uint>::max();
+            nextTick(false);
+            --mCurrentTime;
+
+            mSystemOk = true;
+            mSteps = 0;
+            beginSteadyState(endTime);
+            beginChunks();
+
+            //Główna pętla symulacji
+            for ( mCurrentTime = 0; mCurrentTime < endTime; mSystemOk &= nextTick())
+            {
+                // po hiperokresie sprawdzamy czy stan się powtarza
+                checkSteadyState(endTime);
+
+                // na granicy fragmentu przekazujemy przebieg i sprawdzamy czy przerwać
+                if (mCurrentTime >= mNextChunk && !nextChunk())
+                    break;
+                ++mSteps;
+
+                // wybór zadania, które może zająć swoje zasoby
+                int taskId = getBestTaskId();
+                if (mLocking)
+                    taskId = acquire(taskId);
+
+                // zmiana wykonywanego zadania jest zdarzeniem polityki
+                if (taskId != mLastTaskId)
+                    dispatch(taskId);
+
+                // przypisanie zadania do ostanio wykonywanego zadania
+                mLastTaskId = taskId;
+
+                // przed wykonaniem nowego zadania procesor przełącza kontekst
+                bool switching = beginSwitch(taskId);
+
+                // blokowanie w trakcie cyklu, zanim wykonanie zwolni zasoby
+                if (mLocking)
+                    traceBlocking(taskId, 1);
+
+                // zwiększamy ilość cykli dla zadania
+                if (switching)
+                    contextSwitch(taskId, 1);
+                else if (taskId != -1)
+                {
+                    execute(taskId, 1);
+
+                    // wykonujemy zadanie
+                    if (mTrace.active())
+                        mTrace.run(taskId, mCurrentTime, 1);
+                }
+            }
+
+            mTrace.end();
+            mTable.store(tasks);
+        }
+
+        //! Metoda symulująca działanie harmonogramu sterowana zdarzeniami
+        /*!
+        Zamiast symulować każdy cykl osobno, przeskakuje od razu do najbliższego zdarzenia
+        (zwolnienie zadania co okres lub ze strumienia, termin, zakończenie zadania, zmiana kolejności swobód w LLF, koniec przełączania kontekstu)
+        i rozlicza cały odcinek jednocześnie. Koszt zależy od liczby zdarzeń, a nie od czasu symulacji.
+        \param endTime czas zakończenia symulacji
+        */
+        void scheduleEvents(uint endTime) override
+        {
+            //Wywałane po ty tylko by nabić dane w zadaiach
+            mTable.load(tasks, !beginReleases(endTime));
+            mQueued.resize(tasks.size() + 1);
+            mReady.reset(tasks.size() + 1);
+            beginPolicy();
+            beginServer();
+            beginLocks();
+            mTrace.begin(mSink);
+            // pierwszy cykl przypada na chwilę 0, w której następują pierwsze zwolnienia
+            mCurrentTime = std::numeric_limits<uint>::max();
+            nextTick(false);
+            --mCurrentTime;
+
+            mSystemOk = true;
+            mSteps = 0;
+            beginSteadyState(endTime);
+            beginChunks();
+
+            //Główna pętla symulacji, każdy obieg to jeden odcinek pomiędzy zdarzeniami
+            for (mCurrentTime = 0; mCurrentTime < endTime; )
+            {
+                // po hiperokresie sprawdzamy czy stan się powtarza
+                checkSteadyState(endTime);
+
+                // na granicy fragmentu przekazujemy przebieg i sprawdzamy czy przerwać
+                if (mCurrentTime >= mNextChunk && !nextChunk())
+                    break;
+                ++mSteps;
+
+                // wybór zadania, które może zająć swoje zasoby
+                int taskId = getBestTaskId();
+                if (mLocking)
+                    taskId = acquire(taskId);
+
+                // zmiana wykonywanego zadania jest zdarzeniem polityki
+                if (taskId != mLastTaskId)
+                    dispatch(taskId);
+
+                // przypisanie zadania do ostanio wykonywanego zadania
+                mLastTaskId = taskId;
+
+                // przełączanie kontekstu kończy się zdarzeniem, a wybrane zadanie nie wykonuje się do jego końca
+                bool switching = beginSwitch(taskId);
+                uint distance = switching ? std::min(mSwitchLeft, nextEventDistance(-1)) : nextEventDistance(taskId);
+
+                // długość odcinka, nie wychodzimy poza czas symulacji ani poza fragment
+                uint length = std::min({distance, endTime - mCurrentTime, mNextChunk - mCurrentTime});
+
+                // blokowanie w trakcie odcinka, zanim wykonanie zwolni zasoby
+                if (mLocking)
+                    traceBlocking(taskId, length);
+
+                // zwiększamy ilość cykli dla zadania o cały odcinek
+                if (switching)
+                    contextSwitch(taskId, length);
+                else if (taskId != -1)
+                {
+                    execute(taskId, length);
+
+                    // wykonujemy zadanie przez cały odcinek
+                    if (mTrace.active())
+                        mTrace.run(taskId, mCurrentTime, length);
+                }
+
+                mSystemOk &= advance(length);
+            }
+
+            mTrace.end();
+            mTable.store(tasks);
+        }
+
+        //! Funkcja sprawdza czy możliwe jest zasymulowanie kolejnego cyklu
+        /*!
+        Liczniki wszystkich zadań aktualizowane są wektorowo przez TaskTable::tick(),
+        a kolejka zadań gotowych tylko dla zadań oznaczonych w maskach.
+        \param print czy zgłosić przekroczenia terminu
+        */
+        bool nextTick(bool print = true) override
+        {
+            // zwiększamy licznika czasu
+            mCurrentTime++;
+
+            // sparwdzamy kolajne zadani czy nie przeroczyły terminu
+            bool ok = !mTable.tick(mMisses, mReleases);
+
+            for (std::size_t word = 0; word < mMisses.size(); ++word)
+            {
+                std::uint64_t changed = mMisses[word] | mReleases[word];
+
+                while (changed)
+                {
+                    int bit = lowestBit(changed);
+                    int taskId = static_cast<int>(word * 64) + bit;
+
+                    if (print && mTrace.active() && ((mMisses[word] >> bit) & 1))
+                        mTrace.miss(taskId, mCurrentTime); // termin został przekroczony
+
+                    if ((mReleases[word] >> bit) & 1)
+                        Policy::released(mPolicyState, mTable, taskId, mCurrentTime);
+
+                    // nowa lub porzucona instancja nie zajmuje już zasobów
+                    if (mLocking && (((mReleases[word] >> bit) & 1) || !mTable.isSchedulable(taskId)))
+                        dropJob(taskId);
+
+                    updateReady(taskId);
+                    changed &= changed - 1;
+                }
+            }
+
+            // zwolnienia ze strumienia zwolnień, instancje zwolnione w chwili zakończenia nie należą do symulacji
+            if (mReleaseStream && mCurrentTime < mReleaseEnd)
+                ok &= releaseJobs();
+
+            // odnowienie budżetu serwera, po zwolnieniach z tej samej chwili
+            if (mServing && mServer.nextReplenish() <= mCurrentTime)
+            {
+                mServer.replenish(mCurrentTime);
+                updateServer();
+            }
+
+            return ok;
+        }
+
+        //! Funkcja zawraca id najlepszego zadania z kolejki zadań gotowych
+        /*!
+        Gdy najlepszy jest serwer, zwracane jest pierwsze oczekujące zadanie aperiodyczne.
+        */
+        int getBestTaskId() const override
+        {
+            int best = mReady.top();
+            return best == mServerId ? mServed[mServedHead].task : best;
+        }
+
+    private:
+        //! Funktor porównujący zadania w kolejce zadań gotowych
+        /*!
+        Porównuje kopie zadań z chwili ostatniej aktualizacji kolejki, dzięki czemu
+        kolejka pozostaje spójna gdy TaskTable::tick() zmieni wiele zadań naraz.
+        Przy równym priorytecie wygrywa zadanie o mniejszym id
+        */
+        struct TaskLess
+        {
+            const BasicScheduler* scheduler;
+
+            bool operator()(int a, int b) const
+            {
+                // zadanie zajmujące zasób porównywane jest priorytetem dziedziczonym
+                if (scheduler->mLocking)
+                {
+                    int pa = scheduler->mPriorityOf[static_cast<std::size_t>(a)];
+                    int pb = scheduler->mPriorityOf[static_cast<std::size_t>(b)];
+                    if (pa != pb)
+                        return scheduler->better(pa, pb);
+
+                    // przy równym priorytecie nie wywłaszczamy zadania na pułapie zasobu
+                    bool ia = pa != a;
+                    bool ib = pb != b;
+                    if (ia != ib)
+                        return ia;
+                }
+                return scheduler->better(a, b);
+            }
+        };
+
+        //! Funkcja porównuje priorytety bazowe zadań, przy równym priorytecie wygrywa zadanie o mniejszym id
+        bool better(int a, int b) const
+        {
+            const Task &ta = mQueued[static_cast<std::size_t>(a)];
+            const Task &tb = mQueued[static_cast<std::size_t>(b)];
+
+            if (Policy::higher(ta, tb))
+                return true;
+            if (Policy::higher(tb, ta))
+                return false;
+            return a < b;
+        }
+
+        //! Funkcja porównuje priorytety zadań w bieżącej chwili, wyznacza kolejność przekazywania zasobów
+        /*!
+        W przeciwieństwie do better() nie korzysta z kopii zadań z mQueued, które dla zadań
+        czekających na zasób pochodzą z różnych chwil.
+        */
+        bool currentlyBetter(int a, int b) const
+        {
+            const Task ta = mTable.row(a);
+            const Task tb = mTable.row(b);
+
+            if (Policy::higher(ta, tb))
+                return true;
+            if (Policy::higher(tb, ta))
+                return false;
+            return a < b;
+        }
+
+        //! Metoda przygotowuje stan polityki na początek symulacji
+        void beginPolicy()
+        {
+            mPolicyState = PolicyState();
+            mPolicyState.options = mPolicyOptions;
+            mLastTaskId = -1;
+            mSwitchCost = static_cast<uint>(std::max(mPolicyOptions.switchCost, 0));
+            mContextTask = -1;
+            mSwitchLeft = 0;
+        }
+
+        //! Funkcja rozpoczyna lub kontynuuje przełączanie kontekstu na wybrane zadanie
+        /*!
+        Pierwsze zadanie symulacji nie zastępuje żadnego kontekstu, więc nie jest przełączeniem.
+        \param taskId wybrane zadanie lub -1
+        \return true gdy procesor w bieżącym cyklu przełącza kontekst zamiast wykonywać zadanie
+        */
+        bool beginSwitch(int taskId)
+        {
+            if (mSwitchCost == 0 || taskId == -1)
+                return false;
+
+            // nowe zadanie przerywa niedokończone przełączanie na inne zadanie
+            if (taskId != mContextTask)
+            {
+                mSwitchLeft = mContextTask != -1 ? mSwitchCost : 0;
+                mContextTask = taskId;
+            }
+            return mSwitchLeft > 0;
+        }
+
+        //! Metoda rozlicza przełączanie kontekstu na zadanie przez podaną liczbę cykli od bieżącej chwili
+        void contextSwitch(int taskId, uint length)
+        {
+            mSwitchLeft -= length;
+            if (mTrace.active())
+                mTrace.contextSwitch(taskId, mCurrentTime, length);
+        }
+
+        //! Metoda zgłasza polityce zmianę wykonywanego zadania
+        /*!
+        \param taskId nowo wybrane zadanie lub -1, poprzednim jest mLastTaskId
+        */
+        void dispatch(int taskId)
+        {
+            if (!Policy::dispatched(mPolicyState, mTable, mLastTaskId, taskId))
+                return;
+
+            if (mLastTaskId != -1)
+                updateReady(mLastTaskId);
+            if (taskId != -1)
+                updateReady(taskId);
+        }
+
+        //! Instancja zadania aperiodycznego czekająca na serwer
+        struct ServedJob
+        {
+            int task;     //!< id zadania
+            uint release; //!< chwila zwolnienia instancji
+        };
+
+        //! Funkcja sprawdza czy zadanie obsługuje serwer
+        bool isServed(int taskId) const
+        {
+            return mServing && tasks[static_cast<std::size_t>(taskId)].arrival == Arrival::APERIODIC;
+        }
+
+        //! Metoda przygotowuje serwer zadań aperiodycznych na początek symulacji
+        void beginServer()
+        {
+            mServerId = static_cast<int>(tasks.size());
+            mServing = Policy::fixedPriority && mServerOptions.enabled()
+                    && std::any_of(tasks.begin(), tasks.end(), [](const Task& t) { return t.arrival == Arrival::APERIODIC; });
+            mServed.clear();
+            mServedHead = 0;
+            mServedRelease.assign(tasks.size(), 0);
+
+            if (mServing)
+            {
+                mServer.reset(mServerOptions);
+                mQueued[static_cast<std::size_t>(mServerId)] = mServerOptions.task();
+            }
+        }
+
+        //! Metoda przygotowuje zasoby na początek symulacji
+        /*!
+        Kopie zadań w mQueued wypełniane są od razu, bo pułapy i dziedziczenie porównują
+        także zadania, które nie trafiły jeszcze do kolejki zadań gotowych.
+        */
+        void beginLocks()
+        {
+            mResources.load(tasks, mServing);
+            mLocking = mResources.active();
+            mProtocol = Policy::fixedPriority ? mResourceProtocol : ResourceProtocol::NONE;
+            mPriorityOf.resize(tasks.size() + 1);
+            for (std::size_t i = 0; i < mPriorityOf.size(); ++i)
+                mPriorityOf[i] = static_cast<int>(i);
+
+            if (!mLocking)
+                return;
+
+            for (std::size_t i = 0; i < tasks.size(); ++i)
+                mQueued[i] = mTable.row(static_cast<int>(i));
+            mResources.computeCeilings([this](int a, int b) { return better(a, b); });
+        }
+
+        //! Funkcja zwraca id zadania o najwyższym priorytecie, który przyjmuje zadanie zajmujące zasoby
+        int inheritedPriority(int taskId) const
+        {
+            int best = taskId;
+            for (int resource : mResources.held(taskId))
+            {
+                if (mProtocol == ResourceProtocol::CEILING)
+                {
+                    int ceiling = mResources.ceiling(resource);
+                    if (better(ceiling, best))
+                        best = ceiling;
+                }
+                else if (mProtocol == ResourceProtocol::INHERITANCE)
+                {
+                    for (int waiter : mResources.waiters(resource))
+                    {
+                        int priority = mPriorityOf[static_cast<std::size_t>(waiter)];
+                        if (better(priority, best))
+                            best = priority;
+                    }
+                }
+            }
+            return best;
+        }
+
+        //! Metoda aktualizuje priorytet dziedziczony zadania i właścicieli zasobów, na które ono czeka
+        void updatePriority(int taskId)
+        {
+            if (mProtocol == ResourceProtocol::NONE)
+                return;
+
+            // łańcuch czekających jest krótszy niż liczba zadań, chyba że zadania się zakleszczyły
+            for (std::size_t step = 0; taskId >= 0 && step < tasks.size(); ++step)
+            {
+                int priority = inheritedPriority(taskId);
+                if (priority == mPriorityOf[static_cast<std::size_t>(taskId)])
+                    return;
+
+                mPriorityOf[static_cast<std::size_t>(taskId)] = priority;
+                if (mReady.contains(taskId))
+                    mReady.update(taskId);
+
+                int resource = mResources.waitingOn(taskId);
+                taskId = resource >= 0 ? mResources.holder(resource) : -1;
+            }
+        }
+
+        //! Metoda wznawia zadania, którym przekazano zwolnione zasoby
+        void wake()
+        {
+            for (int taskId : mWoken)
+            {
+                updateReady(taskId);
+                updatePriority(taskId);
+            }
+            mWoken.clear();
+        }
+
+        //! Funkcja zajmuje zasoby wybranego zadania i zwraca zadanie, które może się wykonać
+        /*!
+        Zadanie, które trafiło na zajęty zasób, czeka poza kolejką zadań gotowych,
+        a wybór przechodzi do kolejnego zadania.
+        \param taskId najlepsze zadanie z kolejki zadań gotowych
+        */
+        int acquire(int taskId)
+        {
+            auto order = [this](int a, int b) { return currentlyBetter(a, b); };
+
+            while (taskId != -1 && !isServed(taskId))
+            {
+                int resource = mResources.lock(taskId, mTable.cycles[static_cast<std::size_t>(taskId)], order, mWoken);
+                wake();
+                if (resource < 0)
+                {
+                    updatePriority(taskId);
+                    break;
+                }
+
+                mReady.erase(taskId);
+                updatePriority(mResources.holder(resource));
+                taskId = getBestTaskId();
+            }
+            return taskId;
+        }
+
+        //! Metoda zwalnia zasoby i przerywa czekanie zakończonej lub porzuconej instancji zadania
+        void dropJob(int taskId)
+        {
+            int resource = mResources.drop(taskId, [this](int a, int b) { return currentlyBetter(a, b); }, mWoken);
+            updatePriority(taskId);
+            if (resource >= 0)
+                updatePriority(mResources.holder(resource));
+            wake();
+        }
+
+        //! Metoda zapisuje blokowanie gotowych zadań o wyższym priorytecie bazowym niż wykonywane zadanie
+        /*!
+        Przy zmiennych priorytetach, gdzie kolejność zadań zmienia się w trakcie odcinka,
+        zablokowane są tylko zadania czekające na zasób. Przegląda wszystkie zadania,
+        więc kosztuje O(n) na zdarzenie, ale tylko gdy zadania zajmują zasoby.
+        */
+        void traceBlocking(int taskId, uint length)
+        {
+            if (!mTrace.active())
+                return;
+
+            int running = taskId != -1 && isServed(taskId) ? mServerId : taskId;
+            for (std::size_t i = 0; i < tasks.size(); ++i)
+            {
+                int id = static_cast<int>(i);
+                if (id == taskId || !mTable.isSchedulable(id) || isServed(id))
+                    continue;
+                // bez wykonywanego zadania lub przy zmiennych priorytetach liczy się tylko czekanie na zasób
+                bool waitingOnly = running == -1 || !Policy::fixedPriority;
+                bool blocked = waitingOnly ? mResources.waitingOn(id) >= 0 : better(id, running);
+                if (blocked)
+                    mTrace.blocked(id, mCurrentTime, length);
+            }
+        }
+
+        //! Metoda rozlicza wykonanie zadania przez podaną liczbę cykli od bieżącej chwili
+        void execute(int taskId, uint length)
+        {
+            mTable.cycles[static_cast<std::size_t>(taskId)] += static_cast<int>(length);
+            Policy::executed(mPolicyState, mTable, taskId, length);
+            if (!mTable.isSchedulable(taskId))
+                Policy::completed(mPolicyState, mTable, taskId);
+
+            if (isServed(taskId))
+                mServer.consume(mCurrentTime, length);
+            else if (mLocking)
+            {
+                mResources.unlock(taskId, mTable.cycles[static_cast<std::size_t>(taskId)],
+                                  [this](int a, int b) { return currentlyBetter(a, b); }, mWoken);
+                updatePriority(taskId);
+                wake();
+            }
+            updateReady(taskId);
+        }
+
+        //! Metoda aktualizuje gotowość serwera po zmianie budżetu lub instancji zadań aperiodycznych
+        /*!
+        Zakończone, porzucone i przeterminowane instancje usuwane są dopiero z początku kolejki,
+        więc każda instancja jest wstawiana i usuwana raz.
+        */
+        void updateServer()
+        {
+            while (mServedHead < mServed.size())
+            {
+                const ServedJob &job = mServed[mServedHead];
+                if (mTable.isSchedulable(job.task) && mServedRelease[static_cast<std::size_t>(job.task)] == job.release)
+                    break;
+                ++mServedHead;
+            }
+
+            // usunięty początek kolejki zwalniamy, gdy zajmuje ponad połowę
+            if (mServedHead > 0 && mServedHead * 2 >= mServed.size())
+            {
+                mServed.erase(mServed.begin(), mServed.begin() + static_cast<std::ptrdiff_t>(mServedHead));
+                mServedHead = 0;
+            }
+
+            if (mServer.update(mServedHead < mServed.size()))
+            {
+                if (!mReady.contains(mServerId))
+                    mReady.push(mServerId);
+            }
+            else if (mReady.contains(mServerId))
+            {
+                mReady.erase(mServerId);
+            }
+        }
+
+        //! Funkcja zwraca kopię zadania z kolejki zadań gotowych, również serwera
+        Task readyRow(int id) const
+        {
+            return id == mServerId ? mQueued[static_cast<std::size_t>(id)] : mTable.row(id);
+        }
+
+        //! Metoda aktualizuje położenie zadania w kolejce zadań gotowych
+        void updateReady(int taskId)
+        {
+            // zadania aperiodyczne czekają w kolejce serwera, a nie w kolejce zadań gotowych
+            if (isServed(taskId))
+            {
+                updateServer();
+                return;
+            }
+
+            // zadanie czekające na zasób nie jest gotowe
+            if (mTable.isSchedulable(taskId) && !(mLocking && mResources.waitingOn(taskId) >= 0))
+            {
+                mQueued[static_cast<std::size_t>(taskId)] = mTable.row(taskId);
+
+                if (mReady.contains(taskId))
+                    mReady.update(taskId);
+                else
+                    mReady.push(taskId);
+            }
+            else if (mReady.contains(taskId))
+            {
+                mReady.erase(taskId);
+            }
+        }
+
+        //! Metoda rozpoczyna instancje zadań zwolnionych ze strumienia w bieżącym cyklu
+        /*!
+        \return false gdy któraś porzucona instancja nie zdążyła się zakończyć
+        */
+        bool releaseJobs()
+        {
+            bool ok = true;
+            mDue.clear();
+            mReleaseStream->pop(mCurrentTime, mDue);
+
+            for (int taskId : mDue)
+            {
+                // poprzednia instancja nie zakończyła się przed kolejnym zwolnieniem, więc jest porzucana
+                if (mTable.release(taskId))
+                {
+                    ok = false;
+                    if (mTrace.active())
+                        mTrace.miss(taskId, mCurrentTime);
+                }
+                Policy::released(mPolicyState, mTable, taskId, mCurrentTime);
+                if (mLocking)
+                    dropJob(taskId);
+
+                if (mTrace.active())
+                    mTrace.release(taskId, mCurrentTime);
+
+                // instancja zadania aperiodycznego ustawia się w kolejce serwera
+                if (isServed(taskId))
+                {
+                    mServedRelease[static_cast<std::size_t>(taskId)] = mCurrentTime;
+                    mServed.push_back(ServedJob{taskId, mCurrentTime});
+                }
+                updateReady(taskId);
+            }
+
+            return ok;
+        }
+
+        //! Funkcja zwraca liczbę cykli do najbliższego zdarzenia
+        uint nextEventDistance(int taskId) const
+        {
+            // zwolnienie kolejnego zadania lub termin niezakończonego zadania
+            uint distance = std::min(static_cast<uint>(mTable.nextEvent()), releaseDistance());
+
+            // odnowienie budżetu serwera
+            if (mServing)
+            {
+                uint replenish = mServer.nextReplenish();
+                if (replenish != std::numeric_limits<uint>::max())
+                    distance = std::min(distance, replenish > mCurrentTime ? replenish - mCurrentTime : 1);
+            }
+
+            if (taskId == -1)
+                return distance;
+
+            // zakończenie wykonywanego zadania, a w ramach serwera także wyczerpanie budżetu
+            const Task running = mTable.row(taskId);
+            distance = std::min(distance, static_cast<uint>(running.time - running.cycles));
+            if (isServed(taskId))
+                distance = std::min(distance, mServer.budget());
+            else if (mLocking)
+                distance = std::min(distance, mResources.nextPoint(taskId, running.cycles));
+
+            // wywłaszczenie przez inne zadanie
+            int competitorId = mReady.runnerUp();
+            if (competitorId != -1)
+            {
+                const Task competitor = readyRow(competitorId);
+                distance = std::min(distance, Policy::runLength(running, competitor, taskId < competitorId));
+            }
+
+            return distance;
+        }
+
+        //! Metoda przygotowuje wykrywanie stanu ustalonego
+        /*!
+        Sprawdzanie jest wyłączone gdy hiperokres nie mieści się w typie uint, symulacja jest
+        zbyt krótka, by powtórzyć choć jeden hiperokres, zadania zwalniane są ze strumienia
+        albo silnik nalicza koszt przełączenia kontekstu.
+        */
+        void beginSteadyState(uint endTime)
+        {
+            // stan zasobów, kolejność z kluczy polityki i kontekst procesora nie należą do stanu zadań porównywanego po hiperokresie
+            mHyperperiod = mShortcut && Policy::repeatable && !mReleaseStream && !mLocking && mSwitchCost == 0 ? hyperperiod(tasks) : 0;
+            if (mHyperperiod > (endTime - 1) / 2)
+                mHyperperiod = 0;
+
+            mNextCheck = 0;
+        }
+
+        //! Metoda pomija symulację powtarzających się okresów
+        /*!
+        Stan zadań zapisywany jest co hiperokres. Przyszły przebieg zależy tylko od tego stanu,
+        więc gdy stan się powtórzy, cała reszta symulacji jest powtórzeniem ostatniego okresu.
+        Czas przesuwany jest o tyle pełnych okresów, by zostało mniej niż jeden okres do symulacji.
+        W symulacji sterowanej zdarzeniami sprawdzenie następuje w pierwszym zdarzeniu po upływie hiperokresu.
+        */
+        void checkSteadyState(uint endTime)
+        {
+            if (mHyperperiod == 0 || mCurrentTime < mNextCheck)
+                return;
+
+            if (mCurrentTime > 0 && mTable.sameState(mPeriodState))
+            {
+                uint period = mCurrentTime - mPeriodStart;
+                uint count = (endTime - mCurrentTime - 1) / period;
+
+                if (count > 0 && mTrace.repeat(period, count))
+                    mCurrentTime += count * period;
+
+                // do końca symulacji zostało mniej niż jeden okres
+                mHyperperiod = 0;
+                return;
+            }
+
+            // zapamiętujemy stan z początku kolejnego okresu
+            mTable.saveState(mPeriodState);
+            mTrace.boundary(mCurrentTime);
+            mPeriodStart = mCurrentTime;
+
+            if (endTime - mCurrentTime > 2 * static_cast<std::uint64_t>(mHyperperiod))
+                mNextCheck = mCurrentTime + mHyperperiod;
+            else
+                mHyperperiod = 0;
+        }
+
+        //! Funkcja przesuwa symulację o podaną liczbę cykli
+        /*!
+        Zakłada, że przed ostatnim z tych cykli nie występuje żadne zdarzenie.
+        */
+        bool advance(uint length)
+        {
+            // cykle bez zdarzeń tylko zmniejszają liczniki
+            uint skip = length - 1;
+            mCurrentTime += skip;
+            if (skip > 0)
+                mTable.skip(static_cast<int>(skip));
+
+            // ostatni cykl może zawierać zdarzenie
+            return nextTick();
+        }
+
+        TaskTable mTable;                             //!< zadania w układzie struktury tablic
+        uint mHyperperiod {0};                        //!< hiperokres zadań, 0 wyłącza wykrywanie stanu ustalonego
+        uint mNextCheck   {0};                        //!< chwila kolejnego porównania stanu
+        uint mPeriodStart {0};                        //!< chwila zapisania stanu mPeriodState
+        std::vector<int> mPeriodState;                //!< stan zadań na początku bieżącego okresu
+        TaskMask mMisses;                             //!< maska zadań które przekroczyły termin
+        TaskMask mReleases;                           //!< maska zadań zwolnionych w ostatnim cyklu
+        std::vector<Task> mQueued;                    //!< kopie zadań z chwili wstawienia do kolejki, na końcu serwer
+        typename Policy::template Queue<TaskLess> mReady {TaskLess{this}}; //!< kolejka zadań gotowych
+        PolicyState mPolicyState;                     //!< stan polityki w bieżącej symulacji
+        BudgetServer mServer;                         //!< budżet serwera zadań aperiodycznych
+        int mServerId {-1};                           //!< id serwera w kolejce zadań gotowych
+        std::vector<ServedJob> mServed;               //!< instancje zadań aperiodycznych w kolejności zwolnień
+        std::size_t mServedHead {0};                  //!< pierwsza oczekująca instancja w mServed
+        std::vector<uint> mServedRelease;             //!< chwila zwolnienia bieżącej instancji zadania aperiodycznego
+        ResourceTable mResources;                     //!< zasoby współdzielone
+        ResourceProtocol mProtocol {ResourceProtocol::NONE}; //!< protokół dostępu do zasobów w bieżącej symulacji
+        std::vector<int> mPriorityOf;                 //!< zadanie, którego priorytet przyjmuje zadanie, na końcu serwer
+        std::vector<int> mWoken;                      //!< zadania, którym przekazano zwolnione zasoby
+        uint mSwitchCost  {0};                        //!< koszt przełączenia kontekstu w bieżącej symulacji
+        int mContextTask  {-1};                       //!< zadanie, którego kontekst jest lub będzie na procesorze, -1 przed pierwszym wyborem
+        uint mSwitchLeft  {0};                        //!< pozostałe cykle przełączania kontekstu na mContextTask
+    };
+}
@@ -0,0 +1,128 @@
+#include "batch.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace alg
+{
+    std::vector<BatchSummary> simulateBatch(ThreadPool& pool,
+                                            const std::vector<TaskSet>& sets,
+                                            const std::vector<std::string>& algorithms,
+                                            const std::vector<uint>& horizons,
+                                            const BatchOptions& options,
+                                            std::vector<BatchResult>* results)
+    {
+        for (const std::string &name : algorithms)
+        {
+            if (!createEngine(name))
+                return {};
+        }
+
+        // numer zadania puli: (zestaw * liczba algorytmów + algorytm) * liczba czasów + czas
+        std::size_t perSet = algorithms.size() * horizons.size();
+        std::vector<BatchResult> local;
+        std::vector<BatchResult> &out = results ? *results : local;
+        out.assign(sets.size() * perSet, BatchResult());
+
+        const MultiprocessorOptions &multiprocessor = options.multiprocessor;
+        const bool partitioned = multiprocessor.cores > 1 && multiprocessor.mode == MultiprocessorMode::PARTITIONED;
+
+        // silniki tworzone są leniwie, osobno dla każdego wątku i algorytmu
+        std::vector<std::vector<std::unique_ptr<SchedulerEngine>>> engines(pool.size());
+        for (auto &row : engines)
+            row.resize(algorithms.size());
+
+        pool.run(out.size(), [&](std::size_t worker, std::size_t index)
+        {
+            BatchResult &r = out[index];
+            r.set = index / perSet;
+            r.algorithm = index / horizons.size() % algorithms.size();
+            r.horizon = horizons[index % horizons.size()];
+
+            // zestawy rozstrzygnięte analitycznie pomijamy, analiza nie uwzględnia blokowania na zasobach
+            // ani kosztu przełączania kontekstu
+            if (options.prefilter && multiprocessor.cores <= 1 && options.policy.switchCost <= 0
+                && isStrictlyPeriodic(sets[r.set]) && !hasCriticalSections(sets[r.set]))
+            {
+                r.verdict = analyze(algorithms[r.algorithm], sets[r.set]).verdict;
+                if (r.verdict != Verdict::UNKNOWN)
+                    return;
+            }
+
+            // wyniki zbiorcze nie korzystają z percentyli, więc histogramy są wyłączone
+            SimulationStats stats;
+            if (partitioned)
+            {
+                stats = simulateMultiprocessor(algorithms[r.algorithm], sets[r.set], r.horizon, multiprocessor,
+                                               options.events, options.shortcut, 0, nullptr, nullptr, options.releases,
+                                               options.policy);
+            }
+            else
+            {
+                std::unique_ptr<SchedulerEngine> &engine = engines[worker][r.algorithm];
+                if (!engine)
+                    engine = createEngine(algorithms[r.algorithm], multiprocessor);
+
+                engine->tasks = sets[r.set];
+                engine->setHyperperiodShortcut(options.shortcut);
+                engine->setReleaseOptions(options.releases);
+                engine->setPolicyOptions(options.policy);
+                engine->setServerOptions(options.server);
+                engine->setResourceProtocol(options.resources);
+                stats = simulate(*engine, r.horizon, options.events, nullptr, 0);
+            }
+            r.simulated = true;
+
+            for (const TaskStats &s : stats.tasks)
+            {
+                r.jobs += s.jobs;
+                r.maxResponse = std::max(r.maxResponse, s.maxResponse);
+            }
+            r.misses = stats.misses();
+            r.utilization = stats.utilization();
+            r.preemptions = stats.preemptions();
+            r.switchOverhead = stats.switchOverhead();
+        });
+
+        // zbieramy wyniki w stałej kolejności, niezależnej od przydziału do wątków
+        std::vector<BatchSummary> summary(perSet);
+        for (std::size_t a = 0; a < algorithms.size(); ++a)
+        {
+            for (std::size_t h = 0; h < horizons.size(); ++h)
+            {
+                summary[a * horizons.size() + h].algorithm = algorithms[a];
+                summary[a * horizons.size() + h].horizon = horizons[h];
+            }
+        }
+
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            const BatchResult &r = out[i];
+            BatchSummary &s = summary[i % perSet];
+            s.sets++;
+
+            if (!r.simulated)
+            {
+                if (r.verdict == Verdict::SCHEDULABLE)
+                    s.accepted++;
+                else
+                {
+                    s.rejected++;
+                    s.failedSets++;
+                }
+                continue;
+            }
+
+            s.jobs += r.jobs;
+            s.misses += r.misses;
+            s.maxResponse = std::max(s.maxResponse, r.maxResponse);
+            s.sumUtilization += r.utilization;
+            s.preemptions += r.preemptions;
+            s.sumOverhead += r.switchOverhead;
+            if (r.misses > 0)
+                s.failedSets++;
+        }
+
+        return summary;
+    }
+}
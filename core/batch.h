@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "analysis.h"
+#include "multiprocessor.h"
+#include "simulation.h"
+#include "taskio.h"
+#include "threadpool.h"
+
+namespace alg
+{
+    //! Ustawienia symulacji wsadowej
+    struct BatchOptions
+    {
+        bool events    {true};  //!< czy użyć symulacji sterowanej zdarzeniami
+        bool shortcut  {true};  //!< czy pomijać powtarzające się hiperokresy
+        bool prefilter {false}; //!< czy symulować tylko zestawy nierozstrzygnięte przez analyze(), tylko dla jednego procesora
+        MultiprocessorOptions multiprocessor; //!< liczba procesorów i sposób szeregowania
+        ReleaseOptions releases; //!< ustawienia zwolnień zadań, które nie są ściśle okresowe
+        ServerOptions server;    //!< serwer zadań aperiodycznych, tylko dla jednego procesora
+        ResourceProtocol resources {ResourceProtocol::NONE}; //!< protokół dostępu do zasobów, tylko dla jednego procesora
+        PolicyOptions policy;    //!< parametry polityki szeregowania, np. kwant RR
+    };
+
+    //! Wynik jednej symulacji wsadowej
+    struct BatchResult
+    {
+        std::size_t set       {0}; //!< numer zestawu zadań
+        std::size_t algorithm {0}; //!< numer algorytmu
+        uint horizon          {0}; //!< czas symulacji
+        uint jobs             {0}; //!< liczba zwolnionych instancji zadań
+        uint misses           {0}; //!< liczba przekroczonych terminów
+        uint maxResponse      {0}; //!< najdłuższy czas odpowiedzi
+        double utilization    {0.0}; //!< wykorzystanie procesora
+        uint preemptions      {0}; //!< liczba wywłaszczeń
+        double switchOverhead {0.0}; //!< część czasu procesora stracona na przełączanie kontekstu
+        Verdict verdict       {Verdict::UNKNOWN}; //!< wynik analizy, gdy włączono BatchOptions::prefilter
+        bool simulated        {false}; //!< czy zestaw był symulowany
+    };
+
+    //! Zbiorcze wyniki algorytmu dla jednego czasu symulacji
+    struct BatchSummary
+    {
+        std::string algorithm;          //!< nazwa algorytmu
+        uint horizon           {0};     //!< czas symulacji
+        std::size_t sets       {0};     //!< liczba zestawów zadań
+        std::size_t failedSets {0};     //!< liczba zestawów z przekroczonym terminem lub odrzuconych przez analizę
+        std::size_t accepted   {0};     //!< liczba zestawów przyjętych przez analizę bez symulacji
+        std::size_t rejected   {0};     //!< liczba zestawów odrzuconych przez analizę bez symulacji
+        std::uint64_t jobs     {0};     //!< liczba zwolnionych instancji zadań
+        std::uint64_t misses   {0};     //!< liczba przekroczonych terminów
+        uint maxResponse       {0};     //!< najdłuższy czas odpowiedzi
+        double sumUtilization  {0.0};   //!< suma wykorzystania procesora w symulowanych zestawach
+        std::uint64_t preemptions {0};  //!< liczba wywłaszczeń
+        double sumOverhead     {0.0};   //!< suma części czasu straconej na przełączanie kontekstu w symulowanych zestawach
+
+        //! Funkcja zwraca liczbę symulowanych zestawów
+        std::size_t simulated() const { return sets - accepted - rejected; }
+
+        //! Metoda dodaje wyniki tego samego algorytmu i czasu dla kolejnej części zestawów
+        void merge(const BatchSummary& other)
+        {
+            sets += other.sets;
+            failedSets += other.failedSets;
+            accepted += other.accepted;
+            rejected += other.rejected;
+            jobs += other.jobs;
+            misses += other.misses;
+            maxResponse = std::max(maxResponse, other.maxResponse);
+            sumUtilization += other.sumUtilization;
+            preemptions += other.preemptions;
+            sumOverhead += other.sumOverhead;
+        }
+        //! Funkcja zwraca stosunek przekroczonych terminów do zwolnionych instancji w symulowanych zestawach
+        double missRatio() const { return jobs ? static_cast<double>(misses) / jobs : 0.0; }
+        //! Funkcja zwraca odsetek zestawów z przekroczonym terminem
+        double failRatio() const { return sets ? static_cast<double>(failedSets) / sets : 0.0; }
+        //! Funkcja zwraca średnie wykorzystanie procesora
+        double avgUtilization() const { return simulated() ? sumUtilization / simulated() : 0.0; }
+        //! Funkcja zwraca średnią część czasu procesora straconą na przełączanie kontekstu
+        double avgOverhead() const { return simulated() ? sumOverhead / simulated() : 0.0; }
+    };
+
+    //! Funkcja symuluje wszystkie zestawy zadań wszystkimi algorytmami równolegle
+    /*!
+    Każda para (zestaw, algorytm, czas) jest osobnym zadaniem puli wątków.
+    Każdy wątek używa własnych silników, a wyniki trafiają do osobnych elementów
+    tablicy, więc wątki nie współdzielą modyfikowanego stanu. Wyniki są zbierane
+    po zakończeniu wszystkich symulacji i nie zależą od liczby wątków.
+
+    Z włączonym BatchOptions::prefilter zestawy rozstrzygnięte przez analyze() nie są symulowane,
+    a wynik analizy dotyczy nieograniczonego czasu symulacji. Testy dotyczą jednego procesora,
+    więc przy wielu procesorach, z kosztem przełączania kontekstu (PolicyOptions::switchCost) i dla zestawów,
+    które nie są ściśle okresowe lub mają sekcje krytyczne, prefilter jest pomijany. Procesory zestawu podzielonego
+    symulowane są kolejno w wątku zestawu, równolegle symulowane są tylko różne zestawy.
+
+    \param pool pula wątków
+    \param sets zestawy zadań
+    \param algorithms nazwy algorytmów, jak w createEngine()
+    \param horizons czasy symulacji
+    \param options ustawienia symulacji
+    \param results wyniki poszczególnych symulacji lub nullptr gdy nie są potrzebne
+    \return wyniki zbiorcze dla każdej pary (algorytm, czas) lub pusta tablica gdy algorytm jest nieznany
+    */
+    std::vector<BatchSummary> simulateBatch(ThreadPool& pool,
+                                            const std::vector<TaskSet>& sets,
+                                            const std::vector<std::string>& algorithms,
+                                            const std::vector<uint>& horizons,
+                                            const BatchOptions& options = BatchOptions(),
+                                            std::vector<BatchResult>* results = nullptr);
+}
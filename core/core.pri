@@ -0,0 +1,14 @@
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# symulacja wsadowa uzywa std::thread
+CONFIG += thread
+
+win32:CONFIG(release, debug|release): SCHEDCORE_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): SCHEDCORE_DIR = $$OUT_PWD/../core/debug
+else: SCHEDCORE_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$SCHEDCORE_DIR -lschedcore
+
+win32:!win32-g++: PRE_TARGETDEPS += $$SCHEDCORE_DIR/schedcore.lib
+else: PRE_TARGETDEPS += $$SCHEDCORE_DIR/libschedcore.a
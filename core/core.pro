@@ -0,0 +1,48 @@
+TEMPLATE = lib
+TARGET = schedcore
+
+CONFIG += staticlib thread
+CONFIG -= qt
+
+HEADERS = task.h \
+          policies.h \
+          registry.h \
+          readyqueue.h \
+          tasktable.h \
+          trace.h \
+          basicscheduler.h \
+          globalscheduler.h \
+          multiprocessor.h \
+          simulation.h \
+          taskio.h \
+          threadpool.h \
+          batch.h \
+          analysis.h \
+          tracepyramid.h \
+          tracefile.h \
+          segmentarena.h \
+          histogram.h \
+          generator.h \
+          timerwheel.h \
+          release.h \
+          server.h \
+          resources.h
+
+SOURCES = tasktable.cpp \
+          trace.cpp \
+          simulation.cpp \
+          taskio.cpp \
+          threadpool.cpp \
+          batch.cpp \
+          analysis.cpp \
+          tracepyramid.cpp \
+          tracefile.cpp \
+          segmentarena.cpp \
+          histogram.cpp \
+          generator.cpp \
+          multiprocessor.cpp \
+          timerwheel.cpp \
+          release.cpp \
+          server.cpp \
+          resources.cpp \
+          registry.cpp
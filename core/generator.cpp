@@ -0,0 +1,266 @@
+#include "generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace alg
+{
+    namespace
+    {
+        //! Liczba prób UUniFast, po której zestaw losowany jest metodą Randfixedsum
+        const int maxDiscards = 1000;
+    }
+
+    const std::size_t TaskSetGenerator::maxRandfixedsumTable;
+
+    void Random::seed(std::uint64_t seed)
+    {
+        // stan wypełniamy generatorem splitmix64, by podobne ziarna dawały niezależne ciągi
+        for (std::uint64_t &s : mState)
+        {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    TaskSetGenerator::TaskSetGenerator(const GeneratorOptions& options, std::uint64_t seed)
+        : mOptions(options)
+        , mRandom(seed)
+        , mUtilizations(options.tasks)
+    {
+        if (mOptions.periodMethod == PeriodMethod::DIVISORS)
+        {
+            // dzielniki wyznaczamy raz, losowanie okresu to wybór jednego z nich
+            for (uint d = 1; d <= mOptions.hyperperiod / d; ++d)
+            {
+                if (mOptions.hyperperiod % d != 0)
+                    continue;
+
+                for (uint divisor : {d, mOptions.hyperperiod / d})
+                {
+                    if (divisor >= mOptions.minPeriod && divisor <= mOptions.maxPeriod)
+                        mDivisors.push_back(divisor);
+                }
+            }
+            std::sort(mDivisors.begin(), mDivisors.end());
+            mDivisors.erase(std::unique(mDivisors.begin(), mDivisors.end()), mDivisors.end());
+        }
+
+        if (valid() && mOptions.utilizationMethod == UtilizationMethod::RANDFIXEDSUM)
+            prepareRandfixedsum();
+    }
+
+    bool TaskSetGenerator::valid() const
+    {
+        const GeneratorOptions &o = mOptions;
+
+        if (o.tasks == 0 || o.utilization <= 0.0 || o.maxTaskUtilization <= 0.0 || o.maxTaskUtilization > 1.0)
+            return false;
+        if (o.utilization > o.maxTaskUtilization * static_cast<double>(o.tasks))
+            return false;
+        if (o.minPeriod == 0 || o.minPeriod > o.maxPeriod || o.granularity == 0)
+            return false;
+        if (o.maxPeriod > static_cast<uint>(std::numeric_limits<int>::max()))
+            return false;
+        if (o.minDeadline < 0.0 || o.minDeadline > 1.0 || o.priorities <= 0)
+            return false;
+        if (o.periodMethod == PeriodMethod::DIVISORS && mDivisors.empty())
+            return false;
+        if (o.utilizationMethod == UtilizationMethod::RANDFIXEDSUM && randfixedsumTable() > maxRandfixedsumTable)
+            return false;
+
+        return true;
+    }
+
+    bool TaskSetGenerator::generate(TaskSet& tasks)
+    {
+        if (!valid())
+            return false;
+
+        if (mOptions.utilizationMethod == UtilizationMethod::RANDFIXEDSUM)
+            randfixedsum();
+        else
+        {
+            // UUniFast-Discard: zestaw z zadaniem powyżej limitu losujemy ponownie
+            int attempt = 0;
+            while (!uunifast())
+            {
+                if (++attempt == maxDiscards)
+                {
+                    // limit jest zbyt ciasny dla odrzucania, Randfixedsum uwzględnia go bezpośrednio
+                    if (randfixedsumTable() > maxRandfixedsumTable)
+                        return false;
+                    if (mProbabilities.empty())
+                        prepareRandfixedsum();
+                    randfixedsum();
+                    break;
+                }
+            }
+        }
+
+        tasks.resize(mOptions.tasks);
+        for (std::size_t i = 0; i < mOptions.tasks; ++i)
+        {
+            uint t = period();
+            double c = std::max(1.0, std::round(mUtilizations[i] * t));
+            int time = static_cast<int>(std::min(c, static_cast<double>(t)));
+
+            // termin z przedziału [C + minDeadline * (T - C), T]
+            double factor = mOptions.minDeadline + (1.0 - mOptions.minDeadline) * mRandom.uniform();
+            int deadline = time + static_cast<int>(std::round(factor * (static_cast<int>(t) - time)));
+
+            int prioryty = static_cast<int>(mRandom.below(static_cast<std::uint64_t>(mOptions.priorities)));
+
+            tasks[i] = Task(static_cast<int>(i), static_cast<int>(t), time, deadline, prioryty);
+        }
+
+        return true;
+    }
+
+    std::vector<TaskSet> TaskSetGenerator::generate(std::size_t count)
+    {
+        std::vector<TaskSet> sets(count);
+        for (TaskSet &tasks : sets)
+        {
+            if (!generate(tasks))
+                return std::vector<TaskSet>();
+        }
+        return sets;
+    }
+
+    bool TaskSetGenerator::uunifast()
+    {
+        std::size_t n = mOptions.tasks;
+        double sum = mOptions.utilization;
+
+        for (std::size_t i = 0; i + 1 < n; ++i)
+        {
+            double next = sum * std::pow(mRandom.uniform(), 1.0 / static_cast<double>(n - 1 - i));
+            mUtilizations[i] = sum - next;
+            if (mUtilizations[i] > mOptions.maxTaskUtilization)
+                return false;
+            sum = next;
+        }
+
+        mUtilizations[n - 1] = sum;
+        return sum <= mOptions.maxTaskUtilization;
+    }
+
+    std::size_t TaskSetGenerator::randfixedsumTable() const
+    {
+        double k = std::floor(mOptions.utilization / mOptions.maxTaskUtilization);
+        double width = std::min(k, static_cast<double>(mOptions.tasks)) + 1.0;
+        double size = static_cast<double>(mOptions.tasks) * width;
+        return size < 1e18 ? static_cast<std::size_t>(size) : std::numeric_limits<std::size_t>::max();
+    }
+
+    void TaskSetGenerator::prepareRandfixedsum()
+    {
+        // tablica zależy tylko od liczby zadań i sumy, więc liczymy ją raz (Stafford, randfixedsum.m)
+        std::size_t n = mOptions.tasks;
+        double s = mOptions.utilization / mOptions.maxTaskUtilization;
+        double k = std::max(std::min(std::floor(s), static_cast<double>(n - 1)), 0.0);
+        s = std::max(std::min(s, k + 1.0), k);
+
+        // losowanie odwiedza tylko kolumny 0..k, więc tablica ma k + 1 kolumn zamiast n
+        mScaledSum = s;
+        mStartColumn = static_cast<std::size_t>(k);
+        std::size_t width = mStartColumn + 1;
+        mProbabilities.assign(n > 1 ? (n - 1) * width : 1, 0.0);
+        if (n < 2)
+            return;
+
+        std::vector<double> s1(n), s2(n);
+        for (std::size_t c = 0; c < n; ++c)
+        {
+            s1[c] = s - (k - static_cast<double>(c));
+            s2[c] = (k + static_cast<double>(n - c)) - s;
+        }
+
+        const double huge = 1e300;
+        const double tiny = std::numeric_limits<double>::denorm_min();
+
+        std::vector<double> previous(n + 1, 0.0), current(n + 1, 0.0);
+        previous[1] = huge;
+        for (std::size_t i = 2; i <= n; ++i)
+        {
+            std::fill(current.begin(), current.end(), 0.0);
+            for (std::size_t c = 0; c < std::min(i, width); ++c)
+            {
+                double a = previous[c + 1] * s1[c] / static_cast<double>(i);
+                double b = previous[c] * s2[n - i + c] / static_cast<double>(i);
+                current[c + 1] = a + b;
+
+                double total = current[c + 1] + tiny;
+                mProbabilities[(i - 2) * width + c] = s2[n - i + c] > s1[c] ? b / total : 1.0 - a / total;
+            }
+            previous.swap(current);
+        }
+    }
+
+    void TaskSetGenerator::randfixedsum()
+    {
+        std::size_t n = mOptions.tasks;
+        double s = mScaledSum;
+        std::size_t column = mStartColumn;
+        std::size_t width = mStartColumn + 1;
+        double sm = 0.0;
+        double pr = 1.0;
+
+        // losujemy punkt jednostajnie z przekroju kostki [0, 1]^n hiperpłaszczyzną o sumie s
+        for (std::size_t i = n - 1; i >= 1; --i)
+        {
+            bool e = mRandom.uniform() <= mProbabilities[(i - 1) * width + column];
+            double sx = std::pow(mRandom.uniform(), 1.0 / static_cast<double>(i));
+            sm += (1.0 - sx) * pr * s / static_cast<double>(i + 1);
+            pr *= sx;
+            mUtilizations[n - i - 1] = sm + (e ? pr : 0.0);
+            if (e)
+            {
+                s -= 1.0;
+                --column;
+            }
+        }
+        mUtilizations[n - 1] = sm + pr * s;
+
+        // współrzędne są uporządkowane według sposobu losowania, więc je mieszamy
+        for (std::size_t i = n - 1; i > 0; --i)
+            std::swap(mUtilizations[i], mUtilizations[static_cast<std::size_t>(mRandom.below(i + 1))]);
+
+        for (double &u : mUtilizations)
+            u = std::min(std::max(u, 0.0), 1.0) * mOptions.maxTaskUtilization;
+    }
+
+    uint TaskSetGenerator::period()
+    {
+        const GeneratorOptions &o = mOptions;
+
+        switch (o.periodMethod)
+        {
+        case PeriodMethod::HARMONIC:
+        {
+            // liczba podwojeń najkrótszego okresu mieszczących się w przedziale
+            uint steps = 0;
+            while (static_cast<std::uint64_t>(o.minPeriod) << (steps + 1) <= o.maxPeriod)
+                ++steps;
+            return o.minPeriod << mRandom.below(steps + 1);
+        }
+        case PeriodMethod::DIVISORS:
+            return mDivisors[static_cast<std::size_t>(mRandom.below(mDivisors.size()))];
+        case PeriodMethod::LOG_UNIFORM:
+        default:
+        {
+            // rozkład logarytmicznie jednostajny w [min, max + granularity), zaokrąglony w dół do wielokrotności
+            double low = std::log(static_cast<double>(o.minPeriod));
+            double high = std::log(static_cast<double>(o.maxPeriod) + o.granularity);
+            double value = std::exp(low + (high - low) * mRandom.uniform());
+            uint t = static_cast<uint>(value / o.granularity) * o.granularity;
+            return std::min(std::max(t, o.minPeriod), o.maxPeriod);
+        }
+        }
+    }
+}
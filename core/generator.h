@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "task.h"
+#include "taskio.h"
+
+namespace alg
+{
+    //! Generator liczb pseudolosowych xoshiro256**
+    /*!
+    W odróżnieniu od rozkładów z <random> daje te same liczby na każdej platformie
+    i w każdej bibliotece standardowej, więc zestawy zadań są powtarzalne dla danego ziarna.
+    */
+    class Random
+    {
+    public:
+        //! Konstruktor
+        /*!
+        \param seed ziarno, stan rozwijany jest generatorem splitmix64
+        */
+        explicit Random(std::uint64_t seed = 1) { this->seed(seed); }
+
+        //! Metoda ustawia ziarno
+        void seed(std::uint64_t seed);
+
+        //! Funkcja zwraca kolejną liczbę 64-bitową
+        std::uint64_t next()
+        {
+            std::uint64_t result = rotl(mState[1] * 5, 7) * 9;
+            std::uint64_t t = mState[1] << 17;
+
+            mState[2] ^= mState[0];
+            mState[3] ^= mState[1];
+            mState[1] ^= mState[2];
+            mState[0] ^= mState[3];
+            mState[2] ^= t;
+            mState[3] = rotl(mState[3], 45);
+
+            return result;
+        }
+
+        //! Funkcja zwraca liczbę z przedziału [0, 1)
+        double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+        //! Funkcja zwraca liczbę całkowitą z przedziału [0, n)
+        std::uint64_t below(std::uint64_t n) { return n ? static_cast<std::uint64_t>(uniform() * static_cast<double>(n)) : 0; }
+
+    private:
+        //! Funkcja obraca bity w lewo
+        static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        std::uint64_t mState[4]; //!< stan generatora
+    };
+
+    //! Sposób podziału wykorzystania procesora pomiędzy zadania
+    enum class UtilizationMethod
+    {
+        UUNIFAST,     //!< UUniFast (Bini i Buttazzo), z odrzucaniem zestawów z zadaniem powyżej limitu
+        RANDFIXEDSUM  //!< Randfixedsum (Stafford), rozkład jednostajny z uwzględnieniem limitu zadania
+    };
+
+    //! Sposób losowania okresów
+    enum class PeriodMethod
+    {
+        LOG_UNIFORM, //!< rozkład logarytmicznie jednostajny w [minPeriod, maxPeriod]
+        HARMONIC,    //!< minPeriod pomnożony przez potęgę dwójki, każdy okres dzieli wszystkie dłuższe
+        DIVISORS     //!< dzielniki hiperokresu z przedziału [minPeriod, maxPeriod], hiperokres zestawu go nie przekracza
+    };
+
+    //! Ustawienia generatora zestawów zadań
+    struct GeneratorOptions
+    {
+        std::size_t tasks      {10};   //!< liczba zadań w zestawie
+        double utilization     {0.7};  //!< łączne wykorzystanie procesora
+        double maxTaskUtilization {1.0}; //!< największe wykorzystanie procesora przez jedno zadanie
+        UtilizationMethod utilizationMethod {UtilizationMethod::UUNIFAST}; //!< podział wykorzystania
+        PeriodMethod periodMethod {PeriodMethod::LOG_UNIFORM}; //!< sposób losowania okresów
+        uint minPeriod         {10};   //!< najkrótszy okres
+        uint maxPeriod         {1000}; //!< najdłuższy okres
+        uint granularity       {1};    //!< okresy są wielokrotnością tej liczby (dla LOG_UNIFORM)
+        uint hyperperiod       {25200};//!< hiperokres, którego dzielnikami są okresy (dla DIVISORS)
+        double minDeadline     {1.0};  //!< termin losowany jest z [C + minDeadline * (T - C), T], 1 oznacza termin równy okresowi
+        int priorities         {10};   //!< priorytety losowane są z [0, priorities)
+    };
+
+    //! Generator zestawów zadań niezależny od Qt
+    /*!
+    Wykorzystanie procesora dzielone jest pomiędzy zadania metodą UUniFast lub Randfixedsum,
+    okresy losowane są według GeneratorOptions::periodMethod, a czas wykonania zadania to jego
+    wykorzystanie pomnożone przez okres, zaokrąglone i nie mniejsze od 1. Termin jest ograniczony
+    okresem (constrained deadline).
+
+    Ten sam obiekt z tym samym ziarnem i ustawieniami zawsze zwraca te same zestawy.
+    Generator nie przydziela pamięci przy kolejnych zestawach tej samej wielkości,
+    więc może zasilać symulację wsadową bezpośrednio, milionami zestawów na sekundę.
+    */
+    class TaskSetGenerator
+    {
+    public:
+        //! Konstruktor
+        /*!
+        \param options ustawienia generatora
+        \param seed ziarno generatora liczb pseudolosowych
+        */
+        explicit TaskSetGenerator(const GeneratorOptions& options = GeneratorOptions(), std::uint64_t seed = 1);
+
+        //! Funkcja zwraca ustawienia generatora
+        const GeneratorOptions& options() const { return mOptions; }
+
+        //! Największy rozmiar tablicy prawdopodobieństw Randfixedsum
+        /*!
+        Tablica ma (tasks - 1) * (floor(utilization / maxTaskUtilization) + 1) elementów.
+        */
+        static const std::size_t maxRandfixedsumTable = std::size_t(1) << 24;
+
+        //! Funkcja sprawdza czy ustawienia pozwalają wygenerować zestaw
+        bool valid() const;
+
+        //! Metoda ustawia ziarno, kolejne zestawy powtarzają się od początku
+        void seed(std::uint64_t seed) { mRandom.seed(seed); }
+
+        //! Funkcja losuje kolejny zestaw zadań
+        /*!
+        \param tasks zestaw, którego pamięć jest wykorzystywana ponownie
+        \return false gdy ustawienia są niepoprawne (valid()) lub gdy UUniFast odrzucił wszystkie próby,
+        a tablica Randfixedsum dla tych ustawień byłaby zbyt duża
+        */
+        bool generate(TaskSet& tasks);
+
+        //! Funkcja losuje podaną liczbę zestawów zadań
+        std::vector<TaskSet> generate(std::size_t count);
+
+    private:
+        //! Metoda dzieli wykorzystanie metodą UUniFast
+        /*!
+        \return false gdy któreś zadanie przekroczyło limit i zestaw należy odrzucić
+        */
+        bool uunifast();
+        //! Metoda dzieli wykorzystanie metodą Randfixedsum
+        void randfixedsum();
+        //! Metoda przygotowuje tablicę prawdopodobieństw Randfixedsum dla bieżących ustawień
+        void prepareRandfixedsum();
+        //! Funkcja zwraca rozmiar tablicy Randfixedsum dla bieżących ustawień
+        std::size_t randfixedsumTable() const;
+        //! Funkcja losuje okres
+        uint period();
+
+        GeneratorOptions mOptions;          //!< ustawienia generatora
+        Random mRandom;                     //!< generator liczb pseudolosowych
+        std::vector<double> mUtilizations;  //!< wykorzystanie kolejnych zadań
+        std::vector<uint> mDivisors;        //!< dzielniki hiperokresu z przedziału okresów
+        std::vector<double> mProbabilities; //!< tablica prawdopodobieństw Randfixedsum, (tasks - 1) wierszy
+        std::size_t mStartColumn {0};       //!< początkowa kolumna tablicy Randfixedsum
+        double mScaledSum {0.0};            //!< suma wykorzystania przeskalowana do kostki [0, 1]^tasks
+    };
+}
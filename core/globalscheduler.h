@@ -0,0 +1,512 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "basicscheduler.h"
+
+namespace alg
+{
+    //! Harmonogram globalny na wielu procesorach
+    /*!
+    W każdej chwili wykonywanych jest m najlepszych zadań według polityki, a każde zadanie
+    może wykonywać się na dowolnym procesorze. Zadania gotowe przechowywane są w kolejce
+    TopQueue, więc zmiana zbioru wykonywanych zadań kosztuje O(log n) na zmienione zadanie.
+
+    Wykonywane zadanie pozostaje na swoim procesorze. Nowo wybrane zadanie z rozpoczętą instancją
+    wraca na procesor, na którym wykonywało się ostatnio, o ile jest on wolny, a w przeciwnym razie
+    zajmuje wolny procesor o najmniejszym numerze. Wznowienie rozpoczętej instancji na innym procesorze
+    to migracja, liczona przez StatsCollector na podstawie numerów procesorów w odcinkach przebiegu.
+
+    Polityki, ich zdarzenia, pomijanie hiperokresów i podział na fragmenty działają tak jak
+    w BasicScheduler, a dla jednego procesora przebieg jest taki sam. Zmiana wykonywanego zadania
+    zgłaszana jest polityce osobno dla każdego procesora. Wybór m zadań zawsze korzysta z kopców
+    TopQueue, niezależnie od Policy::Queue.
+
+    Koszt przełączenia kontekstu (PolicyOptions::switchCost) naliczany jest osobno na każdym
+    procesorze, gdy procesor dostaje zadanie, którego kontekstu na nim nie ma, również po migracji.
+
+    \tparam Policy polityka szeregowania, np. DMSPolicy lub EDFPolicy (policies.h)
+    */
+    template <typename Policy>
+    class GlobalScheduler final : public SchedulerEngine
+    {
+    public:
+        //! Konstruktor
+        /*!
+        \param cores liczba procesorów
+        */
+        explicit GlobalScheduler(uint cores = 2)
+            : mCores(std::max(cores, 1u))
+        {}
+
+        //! Funkcja zwraca liczbę procesorów
+        uint cores() const override { return mCores; }
+
+        //! Metoda symulująca działanie harmonogramu cykl po cyklu
+        /*!
+        \param endTime czas zakończenia symulacji
+        */
+        void schedule(uint endTime) override
+        {
+            begin(endTime);
+
+            //Główna pętla symulacji
+            for (mCurrentTime = 0; mCurrentTime < endTime; mSystemOk &= nextTick())
+            {
+                // po hiperokresie sprawdzamy czy stan się powtarza
+                checkSteadyState(endTime);
+
+                // na granicy fragmentu przekazujemy przebieg i sprawdzamy czy przerwać
+                if (mCurrentTime >= mNextChunk && !nextChunk())
+                    break;
+                ++mSteps;
+
+                // wybór zadań dla procesorów i wykonanie jednego cyklu
+                dispatch();
+                execute(1);
+            }
+
+            end();
+        }
+
+        //! Metoda symulująca działanie harmonogramu sterowana zdarzeniami
+        /*!
+        Odcinek pomiędzy zdarzeniami kończy się także, gdy któreś z wykonywanych zadań
+        się zakończy lub gdy najlepsze oczekujące zadanie wyprzedzi któreś z wykonywanych.
+        \param endTime czas zakończenia symulacji
+        */
+        void scheduleEvents(uint endTime) override
+        {
+            begin(endTime);
+
+            //Główna pętla symulacji, każdy obieg to jeden odcinek pomiędzy zdarzeniami
+            for (mCurrentTime = 0; mCurrentTime < endTime; )
+            {
+                // po hiperokresie sprawdzamy czy stan się powtarza
+                checkSteadyState(endTime);
+
+                // na granicy fragmentu przekazujemy przebieg i sprawdzamy czy przerwać
+                if (mCurrentTime >= mNextChunk && !nextChunk())
+                    break;
+                ++mSteps;
+
+                dispatch();
+
+                // długość odcinka, nie wychodzimy poza czas symulacji ani poza fragment
+                uint length = std::min({nextEventDistance(), endTime - mCurrentTime, mNextChunk - mCurrentTime});
+                execute(length);
+
+                mSystemOk &= advance(length);
+            }
+
+            end();
+        }
+
+        //! Funkcja sprawdza czy możliwe jest zasymulowanie kolejnego cyklu
+        /*!
+        \param print czy zgłosić przekroczenia terminu
+        */
+        bool nextTick(bool print = true) override
+        {
+            // zwiększamy licznika czasu
+            mCurrentTime++;
+
+            bool ok = !mTable.tick(mMisses, mReleases);
+
+            for (std::size_t word = 0; word < mMisses.size(); ++word)
+            {
+                std::uint64_t changed = mMisses[word] | mReleases[word];
+
+                while (changed)
+                {
+                    int bit = lowestBit(changed);
+                    int taskId = static_cast<int>(word * 64) + bit;
+
+                    if (print && mTrace.active() && ((mMisses[word] >> bit) & 1))
+                        mTrace.miss(taskId, mCurrentTime); // termin został przekroczony
+
+                    if ((mReleases[word] >> bit) & 1)
+                        Policy::released(mPolicyState, mTable, taskId, mCurrentTime);
+
+                    updateReady(taskId);
+                    changed &= changed - 1;
+                }
+            }
+
+            // zwolnienia ze strumienia zwolnień, instancje zwolnione w chwili zakończenia nie należą do symulacji
+            if (mReleaseStream && mCurrentTime < mReleaseEnd)
+                ok &= releaseJobs();
+
+            return ok;
+        }
+
+        //! Funkcja zawraca id najlepszego zadania spośród wykonywanych i oczekujących
+        int getBestTaskId() const override
+        {
+            TaskLess less {this};
+            int best = mReady.bestWaiting();
+            for (int id : mReady.selection())
+            {
+                if (best == -1 || less(id, best))
+                    best = id;
+            }
+            return best;
+        }
+
+    private:
+        //! Funktor porównujący zadania, tak jak w BasicScheduler
+        struct TaskLess
+        {
+            const GlobalScheduler* scheduler;
+
+            bool operator()(int a, int b) const
+            {
+                const Task &ta = scheduler->mQueued[static_cast<std::size_t>(a)];
+                const Task &tb = scheduler->mQueued[static_cast<std::size_t>(b)];
+
+                // wybierz zadanie z większym priorytetem, a przy równym to z mniejszym id
+                if (Policy::higher(ta, tb))
+                    return true;
+                if (Policy::higher(tb, ta))
+                    return false;
+                return a < b;
+            }
+        };
+
+        //! Metoda przygotowuje symulację
+        void begin(uint endTime)
+        {
+            mTable.load(tasks, !beginReleases(endTime));
+            mQueued.resize(tasks.size());
+            mReady.reset(tasks.size(), mCores);
+            mCoreTask.assign(mCores, -1);
+            mTaskCore.assign(tasks.size(), -1);
+            mUnplaced.reserve(mCores);
+            mPolicyState = PolicyState();
+            mPolicyState.options = mPolicyOptions;
+            mSwitchCost = static_cast<uint>(std::max(mPolicyOptions.switchCost, 0));
+            mCoreContext.assign(mCores, -1);
+            mSwitchLeft.assign(mCores, 0);
+            mTrace.begin(mSink, mCores);
+            // pierwszy cykl przypada na chwilę 0, w której następują pierwsze zwolnienia
+            mCurrentTime = std::numeric_limits<uint>::max();
+            nextTick(false);
+            --mCurrentTime;
+
+            mSystemOk = true;
+            mSteps = 0;
+            beginSteadyState(endTime);
+            beginChunks();
+        }
+
+        //! Metoda kończy symulację
+        void end()
+        {
+            mTrace.end();
+            mTable.store(tasks);
+        }
+
+        //! Metoda aktualizuje położenie zadania w kolejce zadań gotowych
+        void updateReady(int taskId)
+        {
+            if (mTable.isSchedulable(taskId))
+            {
+                mQueued[static_cast<std::size_t>(taskId)] = mTable.row(taskId);
+                mReady.update(taskId);
+            }
+            else
+            {
+                mReady.erase(taskId);
+            }
+        }
+
+        //! Metoda rozpoczyna instancje zadań zwolnionych ze strumienia, tak jak w BasicScheduler
+        bool releaseJobs()
+        {
+            bool ok = true;
+            mDue.clear();
+            mReleaseStream->pop(mCurrentTime, mDue);
+
+            for (int taskId : mDue)
+            {
+                // poprzednia instancja nie zakończyła się przed kolejnym zwolnieniem, więc jest porzucana
+                if (mTable.release(taskId))
+                {
+                    ok = false;
+                    if (mTrace.active())
+                        mTrace.miss(taskId, mCurrentTime);
+                }
+                Policy::released(mPolicyState, mTable, taskId, mCurrentTime);
+
+                if (mTrace.active())
+                    mTrace.release(taskId, mCurrentTime);
+                updateReady(taskId);
+            }
+
+            return ok;
+        }
+
+        //! Funkcja sprawdza czy zadanie ma rozpoczętą, niezakończoną instancję
+        bool started(int taskId) const
+        {
+            std::size_t i = static_cast<std::size_t>(taskId);
+            return mTable.cycles[i] > 0 && mTable.cycles[i] < mTable.time[i];
+        }
+
+        //! Metoda wybiera m najlepszych zadań, przydziela je procesorom i zgłasza zmiany polityce
+        /*!
+        Procesor, który dostał zadanie bez kontekstu na tym procesorze, rozpoczyna przełączanie,
+        tak jak w BasicScheduler.
+        */
+        void dispatch()
+        {
+            mPreviousCores = mCoreTask;
+            assignCores();
+
+            for (std::size_t core = 0; core < mCoreTask.size(); ++core)
+            {
+                int previous = mPreviousCores[core];
+                int next = mCoreTask[core];
+                if (next == previous || !Policy::dispatched(mPolicyState, mTable, previous, next))
+                    continue;
+
+                // zmiana kolejności nie odbiera procesora nowo wybranemu zadaniu, więc wybór pozostaje aktualny
+                if (previous != -1)
+                    updateReady(previous);
+                if (next != -1)
+                    updateReady(next);
+            }
+
+            if (mSwitchCost == 0)
+                return;
+
+            for (std::size_t core = 0; core < mCoreTask.size(); ++core)
+            {
+                int next = mCoreTask[core];
+                if (next == -1 || next == mCoreContext[core])
+                    continue;
+
+                mSwitchLeft[core] = mCoreContext[core] != -1 ? mSwitchCost : 0;
+                mCoreContext[core] = next;
+            }
+        }
+
+        //! Metoda wybiera m najlepszych zadań i przydziela je procesorom
+        void assignCores()
+        {
+            mReady.rebalance();
+
+            // zwalniamy procesory zadań, które przestały być wybrane
+            std::size_t busy = 0;
+            for (int &taskId : mCoreTask)
+            {
+                if (taskId != -1 && !mReady.selected(taskId))
+                    taskId = -1;
+                busy += taskId != -1;
+            }
+
+            // wszystkie wybrane zadania mają już procesory
+            if (busy == mReady.selection().size())
+                return;
+
+            // zadania bez procesora rozmieszczamy w kolejności id, tak by przydział nie zależał
+            // od kolejności w kopcu (innej w symulacji cyklami i zdarzeniami)
+            mUnplaced.clear();
+            for (int taskId : mReady.selection())
+            {
+                int core = mTaskCore[static_cast<std::size_t>(taskId)];
+                if (core == -1 || mCoreTask[static_cast<std::size_t>(core)] != taskId)
+                    mUnplaced.push_back(taskId);
+            }
+            std::sort(mUnplaced.begin(), mUnplaced.end());
+
+            // rozpoczęta instancja wraca na poprzedni procesor, jeżeli jest wolny
+            for (int taskId : mUnplaced)
+            {
+                int core = mTaskCore[static_cast<std::size_t>(taskId)];
+                if (core != -1 && started(taskId) && mCoreTask[static_cast<std::size_t>(core)] == -1)
+                    mCoreTask[static_cast<std::size_t>(core)] = taskId;
+            }
+
+            // pozostałe zadania zajmują wolne procesory od najmniejszego numeru
+            std::size_t free = 0;
+            for (int taskId : mUnplaced)
+            {
+                int &core = mTaskCore[static_cast<std::size_t>(taskId)];
+                if (core != -1 && mCoreTask[static_cast<std::size_t>(core)] == taskId)
+                    continue;
+
+                while (mCoreTask[free] != -1)
+                    ++free;
+                mCoreTask[free] = taskId;
+                core = static_cast<int>(free);
+            }
+        }
+
+        //! Metoda wykonuje zadania przydzielone procesorom przez podaną liczbę cykli
+        void execute(uint length)
+        {
+            for (uint core = 0; core < mCores; ++core)
+            {
+                int taskId = mCoreTask[core];
+                if (taskId == -1)
+                    continue;
+
+                // procesor przełączający kontekst nie wykonuje zadania
+                if (mSwitchLeft[core] > 0)
+                {
+                    mSwitchLeft[core] -= length;
+                    if (mTrace.active())
+                        mTrace.contextSwitch(taskId, mCurrentTime, length, core);
+                    continue;
+                }
+
+                mTable.cycles[static_cast<std::size_t>(taskId)] += static_cast<int>(length);
+                Policy::executed(mPolicyState, mTable, taskId, length);
+                if (!mTable.isSchedulable(taskId))
+                    Policy::completed(mPolicyState, mTable, taskId);
+                updateReady(taskId);
+
+                if (mTrace.active())
+                    mTrace.run(taskId, mCurrentTime, length, core);
+            }
+
+            // ostatnio wykonane zadanie pierwszego procesora, tak jak w BasicScheduler
+            mLastTaskId = mCoreTask[0];
+        }
+
+        //! Funkcja zwraca liczbę cykli do najbliższego zdarzenia
+        /*!
+        Swobody wszystkich wykonywanych zadań rosną jednakowo, a oczekujących się nie zmieniają,
+        więc kolejność może zmienić tylko najlepsze oczekujące zadanie wyprzedzając któreś z wykonywanych.
+        Zadanie, na które procesor przełącza kontekst, nie wykonuje się, więc jego odcinek kończy koniec przełączania.
+        */
+        uint nextEventDistance() const
+        {
+            // zwolnienie kolejnego zadania lub termin niezakończonego zadania
+            uint distance = std::min(static_cast<uint>(mTable.nextEvent()), releaseDistance());
+
+            int competitorId = mReady.bestWaiting();
+            const Task competitor = competitorId != -1 ? mTable.row(competitorId) : Task();
+
+            for (std::size_t core = 0; core < mCoreTask.size(); ++core)
+            {
+                int taskId = mCoreTask[core];
+                if (taskId == -1)
+                    continue;
+
+                if (mSwitchLeft[core] > 0)
+                {
+                    distance = std::min(distance, mSwitchLeft[core]);
+                    continue;
+                }
+
+                // zakończenie wykonywanego zadania
+                const Task running = mTable.row(taskId);
+                distance = std::min(distance, static_cast<uint>(running.time - running.cycles));
+
+                // wywłaszczenie przez najlepsze oczekujące zadanie
+                if (competitorId != -1)
+                    distance = std::min(distance, Policy::runLength(running, competitor, taskId < competitorId));
+            }
+
+            return distance;
+        }
+
+        //! Metoda zapisuje przydział procesorów, od którego zależy dalszy przebieg
+        /*!
+        Poza zadaniami wykonywanymi na procesorach zapisywany jest poprzedni procesor
+        zadań z rozpoczętą instancją, bo tylko dla nich jest on brany pod uwagę.
+        */
+        void saveCores(std::vector<int>& state) const
+        {
+            state = mCoreTask;
+            for (std::size_t i = 0; i < mTaskCore.size(); ++i)
+                state.push_back(started(static_cast<int>(i)) ? mTaskCore[i] : -1);
+        }
+
+        //! Metoda przygotowuje wykrywanie stanu ustalonego, tak jak w BasicScheduler
+        void beginSteadyState(uint endTime)
+        {
+            mHyperperiod = mShortcut && Policy::repeatable && !mReleaseStream && mSwitchCost == 0 ? hyperperiod(tasks) : 0;
+            if (mHyperperiod > (endTime - 1) / 2)
+                mHyperperiod = 0;
+
+            mNextCheck = 0;
+        }
+
+        //! Metoda pomija symulację powtarzających się okresów
+        /*!
+        Stan obejmuje, poza stanem zadań, przydział procesorów, więc powtórzony przebieg
+        ma te same numery procesorów.
+        */
+        void checkSteadyState(uint endTime)
+        {
+            if (mHyperperiod == 0 || mCurrentTime < mNextCheck)
+                return;
+
+            saveCores(mCoreState);
+            if (mCurrentTime > 0 && mTable.sameState(mPeriodState) && mCoreState == mPeriodCores)
+            {
+                uint period = mCurrentTime - mPeriodStart;
+                uint count = (endTime - mCurrentTime - 1) / period;
+
+                if (count > 0 && mTrace.repeat(period, count))
+                    mCurrentTime += count * period;
+
+                // do końca symulacji zostało mniej niż jeden okres
+                mHyperperiod = 0;
+                return;
+            }
+
+            // zapamiętujemy stan z początku kolejnego okresu
+            mTable.saveState(mPeriodState);
+            mPeriodCores.swap(mCoreState);
+            mTrace.boundary(mCurrentTime);
+            mPeriodStart = mCurrentTime;
+
+            if (endTime - mCurrentTime > 2 * static_cast<std::uint64_t>(mHyperperiod))
+                mNextCheck = mCurrentTime + mHyperperiod;
+            else
+                mHyperperiod = 0;
+        }
+
+        //! Funkcja przesuwa symulację o podaną liczbę cykli, tak jak w BasicScheduler
+        bool advance(uint length)
+        {
+            // cykle bez zdarzeń tylko zmniejszają liczniki
+            uint skip = length - 1;
+            mCurrentTime += skip;
+            if (skip > 0)
+                mTable.skip(static_cast<int>(skip));
+
+            // ostatni cykl może zawierać zdarzenie
+            return nextTick();
+        }
+
+        uint mCores;                                  //!< liczba procesorów
+        TaskTable mTable;                             //!< zadania w układzie struktury tablic
+        uint mHyperperiod {0};                        //!< hiperokres zadań, 0 wyłącza wykrywanie stanu ustalonego
+        uint mNextCheck   {0};                        //!< chwila kolejnego porównania stanu
+        uint mPeriodStart {0};                        //!< chwila zapisania stanu mPeriodState
+        std::vector<int> mPeriodState;                //!< stan zadań na początku bieżącego okresu
+        std::vector<int> mPeriodCores;                //!< przydział procesorów na początku bieżącego okresu
+        std::vector<int> mCoreState;                  //!< bieżący przydział procesorów do porównania
+        TaskMask mMisses;                             //!< maska zadań które przekroczyły termin
+        TaskMask mReleases;                           //!< maska zadań zwolnionych w ostatnim cyklu
+        std::vector<Task> mQueued;                    //!< kopie zadań z chwili wstawienia do kolejki
+        TopQueue<TaskLess> mReady {TaskLess{this}};   //!< wykonywane i oczekujące zadania gotowe
+        std::vector<int> mCoreTask;                   //!< zadanie wykonywane na procesorze lub -1
+        std::vector<int> mTaskCore;                   //!< procesor, na którym zadanie wykonywało się ostatnio, lub -1
+        std::vector<int> mUnplaced;                   //!< wybrane zadania bez procesora (bufor assignCores())
+        std::vector<int> mPreviousCores;              //!< przydział procesorów przed dispatch()
+        PolicyState mPolicyState;                     //!< stan polityki w bieżącej symulacji
+        uint mSwitchCost {0};                         //!< koszt przełączenia kontekstu w bieżącej symulacji
+        std::vector<int> mCoreContext;                //!< zadanie, którego kontekst jest lub będzie na procesorze, lub -1
+        std::vector<uint> mSwitchLeft;                //!< pozostałe cykle przełączania kontekstu na procesorze
+    };
+}
@@ -0,0 +1,69 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace alg
+{
+    const unsigned Histogram::defaultPrecision;
+    const unsigned Histogram::maxPrecision;
+
+    Histogram::Histogram(unsigned precision)
+        : mPrecision(std::min(precision, maxPrecision))
+    {}
+
+    void Histogram::repeat(const Histogram& earlier, uint count)
+    {
+        for (std::size_t i = 0; i < mCounts.size(); ++i)
+        {
+            std::uint64_t before = i < earlier.mCounts.size() ? earlier.mCounts[i] : 0;
+            mCounts[i] += (mCounts[i] - before) * count;
+        }
+        mTotal += (mTotal - earlier.mTotal) * count;
+    }
+
+    void Histogram::merge(const Histogram& other)
+    {
+        if (mPrecision == 0 || other.mPrecision != mPrecision)
+            return;
+
+        if (other.mCounts.size() > mCounts.size())
+            mCounts.resize(other.mCounts.size(), 0);
+        for (std::size_t i = 0; i < other.mCounts.size(); ++i)
+            mCounts[i] += other.mCounts[i];
+        mTotal += other.mTotal;
+    }
+
+    uint Histogram::percentile(double q) const
+    {
+        if (mTotal == 0)
+            return 0;
+
+        // numer szukanej wartości w kolejności rosnącej, liczony od 1
+        q = std::min(std::max(q, 0.0), 1.0);
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(mTotal)));
+        rank = std::max<std::uint64_t>(rank, 1);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < mCounts.size(); ++i)
+        {
+            seen += mCounts[i];
+            if (seen >= rank)
+                return upperBound(i);
+        }
+        return upperBound(mCounts.size() - 1);
+    }
+
+    uint Histogram::upperBound(std::size_t index) const
+    {
+        std::size_t sub = std::size_t(1) << mPrecision;
+        if (index < sub)
+            return static_cast<uint>(index);
+
+        // kubełek index obejmuje wartości [(sub + reszta) << shift, (sub + reszta + 1) << shift)
+        unsigned shift = static_cast<unsigned>(index / sub - 1);
+        std::uint64_t rest = index % sub;
+        std::uint64_t upper = ((sub + rest + 1) << shift) - 1;
+        return static_cast<uint>(std::min<std::uint64_t>(upper, 0xFFFFFFFFu));
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Histogram wartości całkowitych o stałym błędzie względnym
+    /*!
+    Wartości mniejsze od 2^precyzja zapisywane są dokładnie, a każdy kolejny przedział
+    [2^k, 2^(k+1)) dzielony jest na 2^precyzja równych kubełków, więc błąd względny
+    odczytanego percentyla nie przekracza 2^-precyzja. Dodanie wartości to wyznaczenie
+    indeksu kubełka i jedno zwiększenie licznika, a pamięć rośnie tylko do kubełka
+    największej zapisanej wartości.
+
+    Precyzja 0 wyłącza histogram: wartości nie są zapisywane, a percentyle wynoszą 0.
+    */
+    class Histogram
+    {
+    public:
+        //! Domyślna precyzja, błąd względny poniżej 1%
+        static const unsigned defaultPrecision = 7;
+        //! Największa dopuszczalna precyzja
+        static const unsigned maxPrecision = 16;
+
+        //! Konstruktor
+        /*!
+        \param precision liczba bitów podziału przedziałów, 0 wyłącza histogram
+        */
+        explicit Histogram(unsigned precision = defaultPrecision);
+
+        //! Funkcja zwraca precyzję histogramu
+        unsigned precision() const { return mPrecision; }
+        //! Funkcja zwraca czy histogram zapisuje wartości
+        bool enabled() const { return mPrecision > 0; }
+
+        //! Metoda dodaje wartość podaną liczbę razy
+        void add(uint value, std::uint64_t count = 1)
+        {
+            if (mPrecision == 0)
+                return;
+
+            std::size_t i = index(value);
+            if (i >= mCounts.size())
+                mCounts.resize(i + 1, 0);
+            mCounts[i] += count;
+            mTotal += count;
+        }
+
+        //! Metoda dodaje przyrost względem wcześniejszego stanu histogramu pomnożony przez liczbę powtórzeń
+        /*!
+        \param earlier stan tego samego histogramu z wcześniejszej chwili
+        \param count liczba powtórzeń przyrostu
+        */
+        void repeat(const Histogram& earlier, uint count);
+
+        //! Metoda dodaje wartości z innego histogramu o tej samej precyzji
+        void merge(const Histogram& other);
+
+        //! Funkcja zwraca liczbę zapisanych wartości
+        std::uint64_t count() const { return mTotal; }
+
+        //! Funkcja zwraca percentyl zapisanych wartości
+        /*!
+        \param q rząd percentyla z przedziału [0, 1], np. 0.99
+        \return górna granica kubełka zawierającego percentyl lub 0 gdy histogram jest pusty
+        */
+        uint percentile(double q) const;
+
+    private:
+        //! Funkcja zwraca indeks kubełka wartości
+        std::size_t index(uint value) const
+        {
+            if (value < (1u << mPrecision))
+                return value;
+
+            unsigned shift = 0;
+            for (uint v = value >> mPrecision; v > 1; v >>= 1)
+                ++shift;
+            return ((static_cast<std::size_t>(shift) + 1) << mPrecision) + ((value >> shift) - (1u << mPrecision));
+        }
+
+        //! Funkcja zwraca największą wartość należącą do kubełka
+        uint upperBound(std::size_t index) const;
+
+        unsigned mPrecision;                //!< liczba bitów podziału przedziałów
+        std::vector<std::uint64_t> mCounts; //!< liczniki kolejnych kubełków
+        std::uint64_t mTotal {0};           //!< liczba zapisanych wartości
+    };
+}
@@ -0,0 +1,364 @@
+#include "multiprocessor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "registry.h"
+
+namespace alg
+{
+    namespace
+    {
+        //! Tolerancja porównania wykorzystania z pojemnością procesora
+        const double capacity = 1.0 + 1e-9;
+
+        //! Odbiorca zapamiętujący cały przebieg procesora
+        class BufferSink : public TraceSink
+        {
+        public:
+            void consume(const Segment* segments, std::size_t count) override
+            {
+                mSegments.insert(mSegments.end(), segments, segments + count);
+            }
+
+            const std::vector<Segment>& segments() const { return mSegments; }
+
+        private:
+            std::vector<Segment> mSegments;
+        };
+
+        //! Funkcja zwraca wykorzystanie procesora przez zadanie
+        double utilization(const Task& t)
+        {
+            return t.period > 0 ? static_cast<double>(t.time) / t.period : 1.0;
+        }
+
+        //! Funkcja dzieli zadania na zestawy kolejnych procesorów
+        /*!
+        Id zadania w zestawie to jego położenie w zestawie, a Task::index pozostaje numerem
+        zadania w całym zbiorze, od którego zależą zwolnienia zadania (GeneratedReleases).
+        Sekcje krytyczne są pomijane, bo zasoby współdzielone przez procesory nie są modelowane.
+        */
+        std::vector<std::vector<Task>> split(const std::vector<Task>& tasks, const Partition& partition,
+                                             std::vector<std::vector<int>>& members)
+        {
+            std::vector<std::vector<Task>> sets(partition.load.size());
+            members.assign(partition.load.size(), std::vector<int>());
+
+            for (std::size_t i = 0; i < tasks.size(); ++i)
+            {
+                uint core = partition.cores[i];
+                sets[core].push_back(tasks[i]);
+                sets[core].back().sections.clear();
+                members[core].push_back(static_cast<int>(i));
+            }
+            return sets;
+        }
+    }
+
+    Partition partitionTasks(const std::vector<Task>& tasks, uint cores, PartitionHeuristic heuristic, bool decreasing)
+    {
+        Partition partition;
+        cores = std::max(cores, 1u);
+        partition.cores.assign(tasks.size(), 0);
+        partition.load.assign(cores, 0.0);
+
+        // kolejność rozmieszczania, przy malejącej remisy zachowują kolejność zadań
+        std::vector<std::size_t> order(tasks.size());
+        std::iota(order.begin(), order.end(), 0);
+        if (decreasing)
+        {
+            std::stable_sort(order.begin(), order.end(), [&tasks](std::size_t a, std::size_t b)
+            {
+                return utilization(tasks[a]) > utilization(tasks[b]);
+            });
+        }
+
+        std::vector<double> &load = partition.load;
+        uint current = 0;
+        for (std::size_t i : order)
+        {
+            const double u = utilization(tasks[i]);
+            uint chosen = cores;
+
+            switch (heuristic)
+            {
+            case PartitionHeuristic::NEXT_FIT:
+                // procesory, które nie pomieściły zadania, nie są już brane pod uwagę
+                while (current < cores && load[current] + u > capacity)
+                    ++current;
+                chosen = current;
+                break;
+            case PartitionHeuristic::BEST_FIT:
+            case PartitionHeuristic::WORST_FIT:
+                for (uint c = 0; c < cores; ++c)
+                {
+                    if (load[c] + u > capacity)
+                        continue;
+                    if (chosen == cores
+                        || (heuristic == PartitionHeuristic::BEST_FIT ? load[c] > load[chosen] : load[c] < load[chosen]))
+                        chosen = c;
+                }
+                break;
+            case PartitionHeuristic::FIRST_FIT:
+            default:
+                for (chosen = 0; chosen < cores && load[chosen] + u > capacity; ++chosen)
+                    ;
+                break;
+            }
+
+            // zadanie nie mieści się nigdzie, przydzielamy je najmniej obciążonemu procesorowi
+            if (chosen == cores)
+            {
+                partition.fits = false;
+                chosen = static_cast<uint>(std::min_element(load.begin(), load.end()) - load.begin());
+            }
+
+            partition.cores[i] = chosen;
+            load[chosen] += u;
+        }
+
+        return partition;
+    }
+
+    std::string heuristicName(PartitionHeuristic heuristic, bool decreasing)
+    {
+        const char *names[] = {"ff", "nf", "bf", "wf"};
+        return std::string(names[static_cast<int>(heuristic)]) + (decreasing ? "d" : "");
+    }
+
+    bool parseHeuristic(const std::string& name, PartitionHeuristic& heuristic, bool& decreasing)
+    {
+        for (PartitionHeuristic h : {PartitionHeuristic::FIRST_FIT, PartitionHeuristic::NEXT_FIT,
+                                     PartitionHeuristic::BEST_FIT, PartitionHeuristic::WORST_FIT})
+        {
+            for (bool d : {false, true})
+            {
+                if (name == heuristicName(h, d))
+                {
+                    heuristic = h;
+                    decreasing = d;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    PartitionedScheduler::PartitionedScheduler(const MultiprocessorOptions& options, Factory factory)
+        : mOptions(options)
+        , mFactory(std::move(factory))
+    {
+        mOptions.cores = std::max(mOptions.cores, 1u);
+    }
+
+    void PartitionedScheduler::run(uint endTime, bool events)
+    {
+        const uint cores = mOptions.cores;
+        mPartition = partitionTasks(tasks, cores, mOptions.heuristic, mOptions.decreasing);
+        std::vector<std::vector<Task>> sets = split(tasks, mPartition, mMembers);
+
+        // przebieg procesorów buforujemy tylko gdy odbiorca go potrzebuje
+        bool recording = mSink && mSink->enabled();
+        std::vector<BufferSink> sinks(cores);
+
+        mEngines.resize(cores);
+        for (uint c = 0; c < cores; ++c)
+        {
+            if (!mEngines[c])
+                mEngines[c] = mFactory();
+
+            SchedulerEngine &engine = *mEngines[c];
+            engine.tasks = sets[c];
+            engine.setHyperperiodShortcut(mShortcut);
+            engine.setReleaseOptions(releaseOptions());
+            engine.setPolicyOptions(policyOptions());
+            engine.setChunk(mChunk);
+            engine.setCancelToken(mCancel);
+            engine.setTraceSink(recording ? &sinks[c] : nullptr);
+        }
+
+        // każdy procesor symulowany jest w osobnym wątku, wątki nie współdzielą stanu
+        if (!mPool)
+            mPool.reset(new ThreadPool(std::min<std::size_t>(cores, std::max(1u, std::thread::hardware_concurrency()))));
+        mPool->run(cores, [&](std::size_t, std::size_t c)
+        {
+            if (events)
+                mEngines[c]->scheduleEvents(endTime);
+            else
+                mEngines[c]->schedule(endTime);
+        });
+
+        // przerwana symulacja jest kompletna do najwcześniejszej chwili przerwania
+        mSystemOk = true;
+        mCancelled = false;
+        mSteps = 0;
+        mCurrentTime = endTime;
+        for (uint c = 0; c < cores; ++c)
+        {
+            SchedulerEngine &engine = *mEngines[c];
+            mSystemOk &= engine.systemOk();
+            mCancelled |= engine.cancelled();
+            mSteps += engine.steps();
+            mCurrentTime = std::min(mCurrentTime, engine.currentTime());
+            engine.setTraceSink(nullptr);
+
+            // stan zadań zapisujemy z powrotem do wspólnej tablicy
+            for (std::size_t k = 0; k < engine.tasks.size(); ++k)
+            {
+                Task &t = tasks[static_cast<std::size_t>(mMembers[c][k])];
+                t.cycles = engine.tasks[k].cycles;
+                t.timeToDeadline = engine.tasks[k].timeToDeadline;
+                t.timeToEnd = engine.tasks[k].timeToEnd;
+            }
+        }
+
+        if (recording)
+        {
+            std::vector<std::vector<Segment>> traces(cores);
+            for (uint c = 0; c < cores; ++c)
+                traces[c] = sinks[c].segments();
+            merge(traces);
+        }
+    }
+
+    void PartitionedScheduler::merge(const std::vector<std::vector<Segment>>& traces)
+    {
+        std::vector<std::size_t> next(traces.size(), 0);
+        std::vector<Segment> batch;
+        batch.reserve(TraceRecorder::batchSize);
+
+        std::uint64_t nextProgress = mChunk > 0 ? mChunk : std::numeric_limits<std::uint64_t>::max();
+
+        for (;;)
+        {
+            // najwcześniejszy nieprzekazany odcinek wszystkich procesorów
+            std::size_t core = traces.size();
+            for (std::size_t c = 0; c < traces.size(); ++c)
+            {
+                if (next[c] < traces[c].size()
+                    && (core == traces.size() || traces[c][next[c]].start < traces[core][next[core]].start))
+                    core = c;
+            }
+            std::uint64_t start = core < traces.size() ? traces[core][next[core]].start : mCurrentTime;
+
+            // postęp zgłaszamy na granicach fragmentów, gdy wcześniejsze odcinki zostały już przekazane
+            while (nextProgress <= start && nextProgress <= mCurrentTime)
+            {
+                if (!batch.empty())
+                    mSink->consume(batch.data(), batch.size());
+                batch.clear();
+                mSink->progress(static_cast<uint>(nextProgress));
+                nextProgress += mChunk;
+            }
+
+            if (core == traces.size())
+                break;
+
+            Segment s = traces[core][next[core]++];
+            s.task = mMembers[core][static_cast<std::size_t>(s.task)];
+            s.core = static_cast<std::uint16_t>(core);
+            batch.push_back(s);
+            if (batch.size() == TraceRecorder::batchSize)
+            {
+                mSink->consume(batch.data(), batch.size());
+                batch.clear();
+            }
+        }
+
+        if (!batch.empty())
+            mSink->consume(batch.data(), batch.size());
+    }
+
+    bool PartitionedScheduler::nextTick(bool print)
+    {
+        bool ok = true;
+        for (std::unique_ptr<SchedulerEngine> &engine : mEngines)
+            ok = engine->nextTick(print) && ok;
+        mCurrentTime++;
+        return ok;
+    }
+
+    int PartitionedScheduler::getBestTaskId() const
+    {
+        if (mEngines.empty() || !mEngines[0])
+            return -1;
+
+        int local = mEngines[0]->getBestTaskId();
+        return local == -1 ? -1 : mMembers[0][static_cast<std::size_t>(local)];
+    }
+
+    std::unique_ptr<SchedulerEngine> createEngine(const std::string& name, const MultiprocessorOptions& options)
+    {
+        const PolicyInfo* policy = findPolicy(name);
+        if (!policy)
+            return nullptr;
+
+        return policy->create(options);
+    }
+
+    SimulationStats simulateMultiprocessor(const std::string& name, const std::vector<Task>& tasks, uint endTime,
+                                           const MultiprocessorOptions& options, bool events, bool shortcut,
+                                           unsigned histogramPrecision, ThreadPool* pool, Partition* partition,
+                                           const ReleaseOptions& releases, const PolicyOptions& policy)
+    {
+        if (options.cores <= 1 || options.mode == MultiprocessorMode::GLOBAL)
+        {
+            std::unique_ptr<SchedulerEngine> engine = createEngine(name, options);
+            if (!engine)
+                return SimulationStats();
+
+            engine->tasks = tasks;
+            engine->setHyperperiodShortcut(shortcut);
+            engine->setReleaseOptions(releases);
+            engine->setPolicyOptions(policy);
+            return simulate(*engine, endTime, events, nullptr, histogramPrecision);
+        }
+
+        if (!createEngine(name))
+            return SimulationStats();
+
+        Partition division = partitionTasks(tasks, options.cores, options.heuristic, options.decreasing);
+        std::vector<std::vector<int>> members;
+        std::vector<std::vector<Task>> sets = split(tasks, division, members);
+
+        // procesory są niezależne, więc każdy symulowany jest osobno, z własnymi statystykami
+        std::vector<SimulationStats> results(sets.size());
+        auto job = [&](std::size_t, std::size_t c)
+        {
+            std::unique_ptr<SchedulerEngine> engine = createEngine(name);
+            engine->tasks = sets[c];
+            engine->setHyperperiodShortcut(shortcut);
+            engine->setReleaseOptions(releases);
+            engine->setPolicyOptions(policy);
+            results[c] = simulate(*engine, endTime, events, nullptr, histogramPrecision);
+        };
+
+        if (pool)
+            pool->run(sets.size(), job);
+        else
+        {
+            for (std::size_t c = 0; c < sets.size(); ++c)
+                job(0, c);
+        }
+
+        SimulationStats stats;
+        stats.horizon = endTime;
+        stats.cores = options.cores;
+        stats.switchCost = static_cast<uint>(std::max(policy.switchCost, 0));
+        stats.tasks.resize(tasks.size());
+        for (std::size_t c = 0; c < sets.size(); ++c)
+        {
+            stats.systemOk &= results[c].systemOk;
+            for (std::size_t k = 0; k < members[c].size(); ++k)
+                stats.tasks[static_cast<std::size_t>(members[c][k])] = results[c].tasks[k];
+        }
+
+        if (partition)
+            *partition = division;
+        return stats;
+    }
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "basicscheduler.h"
+#include "globalscheduler.h"
+#include "simulation.h"
+#include "threadpool.h"
+
+namespace alg
+{
+    //! Sposób szeregowania na wielu procesorach
+    enum class MultiprocessorMode
+    {
+        GLOBAL,     //!< wspólna kolejka, zadania mogą migrować pomiędzy procesorami (GlobalScheduler)
+        PARTITIONED //!< każde zadanie przypisane na stałe do jednego procesora (PartitionedScheduler)
+    };
+
+    //! Heurystyka podziału zadań pomiędzy procesory
+    enum class PartitionHeuristic
+    {
+        FIRST_FIT, //!< pierwszy procesor, na którym zadanie się mieści
+        NEXT_FIT,  //!< bieżący procesor, a gdy zadanie się nie mieści kolejny
+        BEST_FIT,  //!< procesor, na którym zostanie najmniej wolnego miejsca
+        WORST_FIT  //!< procesor, na którym zostanie najwięcej wolnego miejsca
+    };
+
+    //! Ustawienia symulacji na wielu procesorach
+    struct MultiprocessorOptions
+    {
+        uint cores {1};                                           //!< liczba procesorów
+        MultiprocessorMode mode {MultiprocessorMode::GLOBAL};     //!< sposób szeregowania
+        PartitionHeuristic heuristic {PartitionHeuristic::FIRST_FIT}; //!< heurystyka podziału
+        bool decreasing {true};                                   //!< czy dzielić zadania w kolejności malejącego wykorzystania
+    };
+
+    //! Podział zadań pomiędzy procesory
+    struct Partition
+    {
+        std::vector<uint> cores;     //!< procesor kolejnych zadań
+        std::vector<double> load;    //!< wykorzystanie kolejnych procesorów
+        bool fits {true};            //!< czy wykorzystanie żadnego procesora nie przekracza 1
+    };
+
+    //! Funkcja dzieli zadania pomiędzy procesory heurystyką pakowania
+    /*!
+    Rozmiarem zadania jest jego wykorzystanie procesora C / T, a pojemnością procesora 1.
+    Dla EDF jest to dokładny warunek szeregowalności na procesorze, a dla priorytetów
+    stałych (DMS, Priorytetowy) warunek konieczny. Zadanie, które nie mieści się na żadnym
+    procesorze, trafia na najmniej obciążony, a wynik ma wtedy Partition::fits równe false.
+    \param tasks zadania
+    \param cores liczba procesorów
+    \param heuristic heurystyka podziału
+    \param decreasing czy rozmieszczać zadania w kolejności malejącego wykorzystania
+    */
+    Partition partitionTasks(const std::vector<Task>& tasks, uint cores, PartitionHeuristic heuristic, bool decreasing);
+
+    //! Funkcja zwraca skrót heurystyki podziału ("ff", "nf", "bf", "wf", z "d" dla kolejności malejącej)
+    std::string heuristicName(PartitionHeuristic heuristic, bool decreasing);
+
+    //! Funkcja odczytuje skrót heurystyki podziału
+    /*!
+    \return false gdy skrót jest nieznany
+    */
+    bool parseHeuristic(const std::string& name, PartitionHeuristic& heuristic, bool& decreasing);
+
+    //! Harmonogram podzielony na wiele procesorów
+    /*!
+    Zadania dzielone są pomiędzy procesory funkcją partitionTasks(), a każdy procesor symulowany
+    jest osobnym silnikiem jednoprocesorowym, wszystkie równolegle w puli wątków.
+    Przebiegi procesorów są buforowane, a po zakończeniu symulacji scalane według czasu rozpoczęcia,
+    z id zadań z tablicy tasks i numerem procesora, i przekazywane odbiorcy.
+
+    Statystyki bez przebiegu zbiera szybciej simulateMultiprocessor(), która nie buforuje odcinków.
+    */
+    class PartitionedScheduler final : public SchedulerEngine
+    {
+    public:
+        //! Funkcja tworząca silnik jednego procesora
+        using Factory = std::function<std::unique_ptr<SchedulerEngine>()>;
+
+        //! Konstruktor
+        /*!
+        \param options ustawienia podziału
+        \param factory funkcja tworząca silniki procesorów
+        */
+        PartitionedScheduler(const MultiprocessorOptions& options, Factory factory);
+
+        uint cores() const override { return mOptions.cores; }
+
+        void schedule(uint endTime) override { run(endTime, false); }
+        void scheduleEvents(uint endTime) override { run(endTime, true); }
+
+        //! Funkcja symuluje kolejny cykl na wszystkich procesorach
+        bool nextTick(bool print = true) override;
+
+        //! Funkcja zwraca id najlepszego zadania pierwszego procesora
+        int getBestTaskId() const override;
+
+        //! Funkcja zwraca podział zadań z ostatniej symulacji
+        const Partition& partition() const { return mPartition; }
+
+    private:
+        //! Metoda dzieli zadania i uruchamia symulacje procesorów
+        void run(uint endTime, bool events);
+        //! Metoda przekazuje odbiorcy scalone przebiegi procesorów
+        void merge(const std::vector<std::vector<Segment>>& traces);
+
+        MultiprocessorOptions mOptions;           //!< ustawienia podziału
+        Factory mFactory;                         //!< funkcja tworząca silniki procesorów
+        Partition mPartition;                     //!< podział zadań z ostatniej symulacji
+        std::vector<std::vector<int>> mMembers;   //!< id zadań przypisanych kolejnym procesorom
+        std::vector<std::unique_ptr<SchedulerEngine>> mEngines; //!< silniki kolejnych procesorów
+        std::unique_ptr<ThreadPool> mPool;        //!< wątki symulujące procesory
+    };
+
+    //! Funkcja tworzy silnik harmonogramu dla polityki i podanej liczby procesorów
+    /*!
+    Dla jednego procesora jest to BasicScheduler.
+    */
+    template <typename Policy>
+    std::unique_ptr<SchedulerEngine> createPolicyEngine(const MultiprocessorOptions& options)
+    {
+        if (options.cores <= 1)
+            return std::unique_ptr<SchedulerEngine>(new BasicScheduler<Policy>);
+        if (options.mode == MultiprocessorMode::GLOBAL)
+            return std::unique_ptr<SchedulerEngine>(new GlobalScheduler<Policy>(options.cores));
+
+        return std::unique_ptr<SchedulerEngine>(new PartitionedScheduler(options, []
+        {
+            return std::unique_ptr<SchedulerEngine>(new BasicScheduler<Policy>);
+        }));
+    }
+
+    //! Funkcja tworzy silnik harmonogramu dla podanej nazwy algorytmu i liczby procesorów
+    /*!
+    Algorytmy pochodzą z rejestru polityk (policies()).
+    \param name nazwa algorytmu, jak w createEngine(const std::string&)
+    \param options ustawienia procesorów
+    \return silnik lub nullptr gdy algorytm jest nieznany
+    */
+    std::unique_ptr<SchedulerEngine> createEngine(const std::string& name, const MultiprocessorOptions& options);
+
+    //! Funkcja uruchamia symulację na wielu procesorach i zwraca statystyki
+    /*!
+    Przy szeregowaniu podzielonym każdy procesor symulowany jest osobno, równolegle w puli wątków,
+    z własnym StatsCollector, a statystyki zadań przepisywane są do wyniku według podziału.
+    Odcinki nie są buforowane, a powtórzenia hiperokresów rozliczane są bez nich.
+    \param name nazwa algorytmu
+    \param tasks zadania
+    \param endTime czas zakończenia symulacji
+    \param options ustawienia procesorów
+    \param events czy użyć symulacji sterowanej zdarzeniami
+    \param shortcut czy pomijać powtarzające się hiperokresy
+    \param histogramPrecision precyzja histogramów czasów odpowiedzi, 0 wyłącza histogramy
+    \param pool pula wątków dla procesorów lub nullptr, wtedy procesory symulowane są kolejno
+    \param partition podział zadań (wynik), gdy nie jest nullptr
+    \param releases ustawienia zwolnień zadań, które nie są ściśle okresowe
+    \param policy parametry polityki szeregowania
+    */
+    SimulationStats simulateMultiprocessor(const std::string& name, const std::vector<Task>& tasks, uint endTime,
+                                           const MultiprocessorOptions& options, bool events = true, bool shortcut = true,
+                                           unsigned histogramPrecision = Histogram::defaultPrecision,
+                                           ThreadPool* pool = nullptr, Partition* partition = nullptr,
+                                           const ReleaseOptions& releases = ReleaseOptions(),
+                                           const PolicyOptions& policy = PolicyOptions());
+}
@@ -0,0 +1,413 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "readyqueue.h"
+#include "task.h"
+#include "tasktable.h"
+
+namespace alg
+{
+    //! Parametry polityk szeregowania
+    /*!
+    Każda polityka korzysta tylko ze swoich parametrów, pozostałe pomija.
+    */
+    struct PolicyOptions
+    {
+        int quantum    {4};     //!< kwant czasu w cyklach (RoundRobinPolicy)
+        int hysteresis {2};     //!< o ile swoboda oczekującego zadania musi być mniejsza, by wywłaszczyło wykonywane (HysteresisLLFPolicy)
+        bool sticky    {false}; //!< czy przy równych kluczach wygrywa wykonywane zadanie, a nie zadanie o mniejszym id (HysteresisLLFPolicy)
+        int switchCost {0};     //!< koszt przełączenia kontekstu w cyklach, naliczany przez silnik dla każdej polityki
+    };
+
+    //! Test szeregowalności stosowany dla polityki przez analyze()
+    enum class PolicyAnalysis
+    {
+        NONE,          //!< brak dokładnego testu, rozstrzyga tylko przekroczenie zapotrzebowania procesora
+        RESPONSE_TIME, //!< analiza czasu odpowiedzi dla stałych priorytetów według Policy::higher()
+        DEMAND         //!< analiza zapotrzebowania procesora, dokładna dla polityk optymalnych jak EDF
+    };
+
+    //! Stan polityki w trakcie jednej symulacji
+    struct PolicyState
+    {
+        PolicyOptions options;      //!< parametry polityki
+        std::uint64_t sequence {0}; //!< licznik nadanych numerów kolejnych, np. zwolnień w FIFO
+    };
+
+    //! Domyślne zdarzenia polityki
+    /*!
+    Polityka poza funkcjami higher() i runLength() może reagować na zdarzenia symulacji,
+    zmieniając klucze kolejności (TaskTable::order) i kwanty (TaskTable::sliceEnd) zadań.
+    Wszystkie polityki dziedziczą tę strukturę i zastępują tylko potrzebne zdarzenia,
+    a puste zdarzenia znikają po rozwinięciu w silniku. Po zdarzeniu silnik aktualizuje
+    położenie zadania w kolejce zadań gotowych.
+
+    Zdarzenia wywoływane są w tej samej kolejności w symulacji cykl po cyklu i sterowanej zdarzeniami,
+    dlatego polityka musi dawać ten sam przebieg niezależnie od długości odcinków wykonania.
+    */
+    struct PolicyHooks
+    {
+        //! Struktura kolejki zadań gotowych (ReadyQueue lub FifoQueue)
+        template <typename Less>
+        using Queue = ReadyQueue<Less>;
+
+        //! Czy przebieg zależy tylko od stanu zadań z TaskTable::saveState(), tylko wtedy pomijane są hiperokresy
+        static const bool repeatable = true;
+
+        //! Test szeregowalności polityki
+        static const PolicyAnalysis analysis = PolicyAnalysis::NONE;
+
+        //! Czy polityka korzysta z PolicyOptions::quantum
+        static const bool usesQuantum = false;
+        //! Czy polityka korzysta z PolicyOptions::hysteresis
+        static const bool usesHysteresis = false;
+        //! Czy polityka korzysta z PolicyOptions::sticky
+        static const bool usesSticky = false;
+
+        //! Zdarzenie zwolnienia instancji zadania w chwili time
+        static void released(PolicyState&, TaskTable&, int, uint) {}
+
+        //! Zdarzenie wykonania zadania przez length cykli, w symulacji cykl po cyklu w każdym cyklu
+        static void executed(PolicyState&, TaskTable&, int, uint) {}
+
+        //! Zdarzenie zakończenia instancji zadania
+        static void completed(PolicyState&, TaskTable&, int) {}
+
+        //! Zdarzenie zmiany zadania wykonywanego na procesorze
+        /*!
+        Zmiana kolejności nie może odebrać procesora nowo wybranemu zadaniu.
+        \param previous poprzednio wykonywane zadanie lub -1
+        \param next nowo wybrane zadanie lub -1
+        \return true gdy kolejność zadań się zmieniła, silnik aktualizuje wtedy oba zadania w kolejce
+        */
+        static bool dispatched(PolicyState&, TaskTable&, int, int) { return false; }
+    };
+
+    //! DMS
+    /*!
+    Polityka algorytmu DMS.
+    Priorytety są stałe, więc zadanie wykonuje się aż do najbliższego zdarzenia.
+    */
+    struct DMSPolicy : PolicyHooks
+    {
+        //! Czy priorytety zadań są stałe, tylko wtedy zadania aperiodyczne może obsługiwać serwer
+        static const bool fixedPriority = true;
+
+        //! Test szeregowalności polityki
+        static const PolicyAnalysis analysis = PolicyAnalysis::RESPONSE_TIME;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Porównywane są terminy i wybierany jest ten z krótszym terminem
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return a.deadline < b.deadline;
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        static uint runLength(const Task&, const Task&, bool)
+        {
+            return std::numeric_limits<uint>::max();
+        }
+    };
+
+    //! LLF
+    /*!
+    Polityka algorytmu LLS.
+    */
+    struct LLFPolicy : PolicyHooks
+    {
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = false;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Porównywane są swobody czasowe i wybierane jest to zadanie z mniejszą swobodą
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return laxity(a) < laxity(b);
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        /*!
+        Swoboda wykonywanego zadania rośnie o jeden w każdym cyklu, swoboda oczekujących się nie zmienia
+        */
+        static uint runLength(const Task& running, const Task& competitor, bool tieWins)
+        {
+            return static_cast<uint>(laxity(competitor) - laxity(running) + (tieWins ? 1 : 0));
+        }
+
+        //! Funkcja obliczająca swobodę czasową dla zadania
+        static int laxity(const Task& t)
+        {
+            return t.deadline - (t.time - t.cycles);
+        }
+    };
+
+    //! Prioryty
+    /*!
+    Polityka algorytmu piorytetowego.
+    Priorytety są stałe, więc zadanie wykonuje się aż do najbliższego zdarzenia.
+    */
+    struct PriorityPolicy : PolicyHooks
+    {
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = true;
+
+        //! Test szeregowalności polityki
+        static const PolicyAnalysis analysis = PolicyAnalysis::RESPONSE_TIME;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Porównywane są piorytety i wybierany jest te z wyższym piorytetem (mniejsza liczba = wiekszy priorytet)
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return a.prioryty < b.prioryty;
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        static uint runLength(const Task&, const Task&, bool)
+        {
+            return std::numeric_limits<uint>::max();
+        }
+    };
+
+    //! RM
+    /*!
+    Polityka algorytmu RM (Rate Monotonic).
+    Priorytety są stałe i zależą od okresu, więc zadanie wykonuje się aż do najbliższego zdarzenia.
+    */
+    struct RMPolicy : PolicyHooks
+    {
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = true;
+
+        //! Test szeregowalności polityki
+        static const PolicyAnalysis analysis = PolicyAnalysis::RESPONSE_TIME;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Porównywane są okresy i wybierane jest zadanie z krótszym okresem
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return a.period < b.period;
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        static uint runLength(const Task&, const Task&, bool)
+        {
+            return std::numeric_limits<uint>::max();
+        }
+    };
+
+    //! EDF
+    /*!
+    Polityka algorytmu EDF (Earliest Deadline First).
+    Kluczem instancji jest jej termin bezwzględny, nadawany przy zwolnieniu. Klucze oczekujących
+    zadań nie zmieniają się z upływem czasu, więc kopiec wybiera zadanie w czasie O(log n),
+    a wywłaszczyć wykonywane zadanie może tylko zwolnienie, które i tak jest zdarzeniem.
+    Terminy bezwzględne nie należą do stanu zadań, więc hiperokresy nie są pomijane.
+    */
+    struct EDFPolicy : PolicyHooks
+    {
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = false;
+        //! Czy przebieg zależy tylko od stanu zadań
+        static const bool repeatable = false;
+        //! Test szeregowalności polityki
+        static const PolicyAnalysis analysis = PolicyAnalysis::DEMAND;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Porównywane są terminy bezwzględne i wybierany jest wcześniejszy
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return a.order < b.order;
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        static uint runLength(const Task&, const Task&, bool)
+        {
+            return std::numeric_limits<uint>::max();
+        }
+
+        //! Zdarzenie zwolnienia instancji, kluczem jest termin bezwzględny
+        static void released(PolicyState&, TaskTable& table, int id, uint time)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            table.order[i] = static_cast<std::uint64_t>(time) + static_cast<std::uint64_t>(std::max(table.deadline[i], 0));
+        }
+    };
+
+    //! FIFO
+    /*!
+    Polityka kolejki FIFO: zadania wykonywane są w kolejności zwolnień, bez wywłaszczania.
+    Kluczem instancji jest numer kolejny zwolnienia, więc nowe zadanie zawsze trafia na koniec
+    listy FifoQueue i wybór kosztuje O(1).
+    */
+    struct FIFOPolicy : PolicyHooks
+    {
+        //! Kolejka zadań gotowych w kolejności zwolnień
+        template <typename Less>
+        using Queue = FifoQueue<Less>;
+
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = false;
+        //! Czy przebieg zależy tylko od stanu zadań
+        static const bool repeatable = false;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Wybierane jest zadanie zwolnione wcześniej
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return a.order < b.order;
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        static uint runLength(const Task&, const Task&, bool)
+        {
+            return std::numeric_limits<uint>::max();
+        }
+
+        //! Zdarzenie zwolnienia instancji, zadanie ustawia się na końcu kolejki
+        static void released(PolicyState& state, TaskTable& table, int id, uint)
+        {
+            table.order[static_cast<std::size_t>(id)] = ++state.sequence;
+        }
+    };
+
+    //! Round-robin
+    /*!
+    Polityka karuzelowa: zadania wykonywane są w kolejności zwolnień, każde co najwyżej
+    przez kwant czasu (PolicyOptions::quantum), po którym wraca na koniec kolejki.
+    Koniec kwantu zapisywany jest w cyklach instancji (TaskTable::sliceEnd), więc wyczerpanie
+    kwantu w trakcie długiego odcinka jest rozliczane przy jego zakończeniu tak samo jak cykl po cyklu.
+    */
+    struct RoundRobinPolicy : PolicyHooks
+    {
+        //! Kolejka zadań gotowych w kolejności zwolnień i wyczerpania kwantu
+        template <typename Less>
+        using Queue = FifoQueue<Less>;
+
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = false;
+        //! Czy przebieg zależy tylko od stanu zadań
+        static const bool repeatable = false;
+        //! Czy polityka korzysta z PolicyOptions::quantum
+        static const bool usesQuantum = true;
+
+        //! Funkcja porównująca dwa zadania
+        /*!
+        Wybierane jest zadanie, które wcześniej ustawiło się w kolejce
+        */
+        static bool higher(const Task& a, const Task& b)
+        {
+            return a.order < b.order;
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        /*!
+        Oczekujące zadanie przejmuje procesor po wyczerpaniu kwantu wykonywanego zadania
+        */
+        static uint runLength(const Task& running, const Task&, bool)
+        {
+            return static_cast<uint>(std::max(running.sliceEnd - running.cycles, 1));
+        }
+
+        //! Zdarzenie zwolnienia instancji, zadanie ustawia się na końcu kolejki z pełnym kwantem
+        static void released(PolicyState& state, TaskTable& table, int id, uint)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            table.order[i] = ++state.sequence;
+            table.sliceEnd[i] = quantum(state);
+        }
+
+        //! Zdarzenie wykonania zadania, po wyczerpaniu kwantu zadanie wraca na koniec kolejki
+        static void executed(PolicyState& state, TaskTable& table, int id, uint)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            if (table.cycles[i] < table.sliceEnd[i] || table.cycles[i] >= table.time[i])
+                return;
+
+            // samotne zadanie mogło wyczerpać w odcinku kilka kwantów
+            int q = quantum(state);
+            table.sliceEnd[i] += (table.cycles[i] - table.sliceEnd[i]) / q * q + q;
+            table.order[i] = ++state.sequence;
+        }
+
+        //! Funkcja zwraca kwant czasu, co najmniej jeden cykl
+        static int quantum(const PolicyState& state)
+        {
+            return std::max(state.options.quantum, 1);
+        }
+    };
+
+    //! LLF z histerezą
+    /*!
+    Polityka LLF, w której wykonywane zadanie ma swobodę pomniejszoną o histerezę
+    (PolicyOptions::hysteresis). Oczekujące zadanie wywłaszcza je dopiero, gdy jego swoboda
+    jest mniejsza o więcej niż histereza, co ogranicza naprzemienne wywłaszczenia zadań
+    o zbliżonych swobodach. Histereza wykonywanego zadania zapisywana jest jako jego klucz
+    kolejności (TaskTable::order) przy zmianie zadania na procesorze.
+
+    Klucze są podwojonymi swobodami, dzięki czemu remis przy PolicyOptions::sticky rozstrzyga
+    dodatkowa połówka histerezy: wykonywane zadanie wygrywa go niezależnie od id. Z zerową
+    histerezą i remisami na korzyść wykonywanego zadania polityka jest LLF bez wywłaszczeń
+    przy równych swobodach.
+    */
+    struct HysteresisLLFPolicy : PolicyHooks
+    {
+        //! Czy priorytety zadań są stałe
+        static const bool fixedPriority = false;
+        //! Czy przebieg zależy tylko od stanu zadań
+        static const bool repeatable = false;
+        //! Czy polityka korzysta z PolicyOptions::hysteresis
+        static const bool usesHysteresis = true;
+        //! Czy polityka korzysta z PolicyOptions::sticky
+        static const bool usesSticky = true;
+
+        //! Funkcja porównująca dwa zadania
+        static bool higher(const Task& a, const Task& b)
+        {
+            return key(a) < key(b);
+        }
+
+        //! Funkcja zwracająca czas wykonywania zadania przed wywłaszczeniem
+        /*!
+        Tak jak w LLF swoboda wykonywanego zadania rośnie o jeden w każdym cyklu, więc klucz rośnie o dwa
+        */
+        static uint runLength(const Task& running, const Task& competitor, bool tieWins)
+        {
+            std::int64_t gap = key(competitor) - key(running);
+            return static_cast<uint>(std::max<std::int64_t>((gap + (tieWins ? 2 : 1)) / 2, 1));
+        }
+
+        //! Zdarzenie zmiany zadania na procesorze, histereza przechodzi na nowo wybrane zadanie
+        static bool dispatched(PolicyState& state, TaskTable& table, int previous, int next)
+        {
+            if (previous != -1)
+                table.order[static_cast<std::size_t>(previous)] = 0;
+            if (next != -1)
+                table.order[static_cast<std::size_t>(next)] = 2 * static_cast<std::uint64_t>(std::max(state.options.hysteresis, 0))
+                                                            + (state.options.sticky ? 1 : 0);
+            return true;
+        }
+
+        //! Funkcja zwraca podwojoną swobodę zadania pomniejszoną o histerezę wykonywanego zadania
+        static std::int64_t key(const Task& t)
+        {
+            return 2 * static_cast<std::int64_t>(LLFPolicy::laxity(t)) - static_cast<std::int64_t>(t.order);
+        }
+    };
+}
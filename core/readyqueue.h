@@ -0,0 +1,390 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace alg
+{
+    //! Kolejka zadań gotowych
+    /*!
+    Kopiec binarny przechowujący id zadań gotowych do wykonania, indeksowany numerem zadania.
+    Dzięki tablicy pozycji zadanie można wstawić, usunąć lub przesunąć po zmianie priorytetu
+    w czasie O(log n), a najlepsze zadanie odczytać w czasie O(1).
+
+    \tparam Less funktor porównujący id dwóch zadań, true gdy pierwsze jest lepsze
+    */
+    template <typename Less>
+    class ReadyQueue
+    {
+    public:
+        //! Konstruktor
+        explicit ReadyQueue(Less less = Less())
+            : mLess(less)
+        {}
+
+        //! Metoda czyści kolejkę i przygotowuje ją dla podanej liczby zadań
+        void reset(std::size_t size)
+        {
+            mHeap.clear();
+            mHeap.reserve(size);
+            mPos.assign(size, static_cast<std::size_t>(npos));
+        }
+
+        //! Funkcja sprawdza czy kolejka jest pusta
+        bool empty() const { return mHeap.empty(); }
+
+        //! Funkcja zwraca liczbę zadań w kolejce
+        std::size_t size() const { return mHeap.size(); }
+
+        //! Funkcja sprawdza czy zadanie jest w kolejce
+        bool contains(int id) const { return mPos[static_cast<std::size_t>(id)] != npos; }
+
+        //! Funkcja zwraca początek zadań w kolejce, w kolejności kopca
+        std::vector<int>::const_iterator begin() const { return mHeap.begin(); }
+        //! Funkcja zwraca koniec zadań w kolejce
+        std::vector<int>::const_iterator end() const { return mHeap.end(); }
+
+        //! Funkcja zwraca id najlepszego zadania lub -1 gdy kolejka jest pusta
+        int top() const { return mHeap.empty() ? -1 : mHeap.front(); }
+
+        //! Funkcja zwraca id najlepszego zadania z pominięciem top() lub -1
+        /*!
+        Drugie najlepsze zadanie jest zawsze jednym z dzieci korzenia
+        */
+        int runnerUp() const
+        {
+            if (mHeap.size() < 2)
+                return -1;
+            if (mHeap.size() < 3 || mLess(mHeap[1], mHeap[2]))
+                return mHeap[1];
+            return mHeap[2];
+        }
+
+        //! Metoda dodaje zadanie do kolejki
+        void push(int id)
+        {
+            mHeap.push_back(id);
+            mPos[static_cast<std::size_t>(id)] = mHeap.size() - 1;
+            siftUp(mHeap.size() - 1);
+        }
+
+        //! Metoda usuwa zadanie z kolejki
+        void erase(int id)
+        {
+            std::size_t pos = mPos[static_cast<std::size_t>(id)];
+            mPos[static_cast<std::size_t>(id)] = npos;
+
+            int last = mHeap.back();
+            mHeap.pop_back();
+            if (pos == mHeap.size())
+                return;
+
+            // ostatni element wstawiamy w miejsce usuniętego i przywracamy własność kopca
+            mHeap[pos] = last;
+            mPos[static_cast<std::size_t>(last)] = pos;
+            update(last);
+        }
+
+        //! Metoda przywraca porządek po zmianie priorytetu zadania
+        void update(int id)
+        {
+            std::size_t pos = mPos[static_cast<std::size_t>(id)];
+            if (pos > 0 && mLess(id, mHeap[(pos - 1) / 2]))
+                siftUp(pos);
+            else
+                siftDown(pos);
+        }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        //! Metoda przesuwa element w górę kopca
+        void siftUp(std::size_t pos)
+        {
+            while (pos > 0)
+            {
+                std::size_t parent = (pos - 1) / 2;
+                if (!mLess(mHeap[pos], mHeap[parent]))
+                    break;
+                swap(pos, parent);
+                pos = parent;
+            }
+        }
+
+        //! Metoda przesuwa element w dół kopca
+        void siftDown(std::size_t pos)
+        {
+            for (;;)
+            {
+                std::size_t best = pos;
+                std::size_t left = 2 * pos + 1;
+                std::size_t right = left + 1;
+
+                if (left < mHeap.size() && mLess(mHeap[left], mHeap[best]))
+                    best = left;
+                if (right < mHeap.size() && mLess(mHeap[right], mHeap[best]))
+                    best = right;
+                if (best == pos)
+                    break;
+
+                swap(pos, best);
+                pos = best;
+            }
+        }
+
+        //! Metoda zamienia miejscami dwa elementy kopca
+        void swap(std::size_t a, std::size_t b)
+        {
+            std::swap(mHeap[a], mHeap[b]);
+            mPos[static_cast<std::size_t>(mHeap[a])] = a;
+            mPos[static_cast<std::size_t>(mHeap[b])] = b;
+        }
+
+        Less mLess;                   //!< funktor porównujący zadania
+        std::vector<int> mHeap;       //!< kopiec id zadań
+        std::vector<std::size_t> mPos;//!< pozycja zadania w kopcu lub npos
+    };
+
+    //! Kolejka zadań gotowych w postaci listy uporządkowanej
+    /*!
+    Lista dwukierunkowa id zadań, indeksowana numerem zadania, od najlepszego do najgorszego.
+    Wstawiane i przesuwane zadanie szuka swojego miejsca od końca listy, więc gdy trafia
+    na koniec, jak w kolejności zwolnień (FIFO) lub po wyczerpaniu kwantu (round-robin),
+    każda operacja kosztuje O(1). Dla dowolnej kolejności jest to O(n), dlatego polityki,
+    których zadania nie trafiają na koniec kolejki, używają kopca ReadyQueue.
+
+    Interfejs jest taki sam jak ReadyQueue, a begin() i end() przeglądają zadania od najlepszego.
+
+    \tparam Less funktor porównujący id dwóch zadań, true gdy pierwsze jest lepsze
+    */
+    template <typename Less>
+    class FifoQueue
+    {
+    public:
+        //! Iterator zadań w kolejności listy
+        class const_iterator
+        {
+        public:
+            const_iterator(const FifoQueue* queue, int id) : mQueue(queue), mId(id) {}
+
+            int operator*() const { return mId; }
+            const_iterator& operator++() { mId = mQueue->mNext[static_cast<std::size_t>(mId)]; return *this; }
+            bool operator==(const const_iterator& other) const { return mId == other.mId; }
+            bool operator!=(const const_iterator& other) const { return mId != other.mId; }
+
+        private:
+            const FifoQueue* mQueue; //!< przeglądana kolejka
+            int mId;                 //!< bieżące zadanie lub -1 za końcem listy
+        };
+
+        //! Konstruktor
+        explicit FifoQueue(Less less = Less())
+            : mLess(less)
+        {}
+
+        //! Metoda czyści kolejkę i przygotowuje ją dla podanej liczby zadań
+        void reset(std::size_t size)
+        {
+            mNext.assign(size, -1);
+            mPrev.assign(size, -1);
+            mQueued.assign(size, false);
+            mHead = mTail = -1;
+            mSize = 0;
+        }
+
+        //! Funkcja sprawdza czy kolejka jest pusta
+        bool empty() const { return mSize == 0; }
+
+        //! Funkcja zwraca liczbę zadań w kolejce
+        std::size_t size() const { return mSize; }
+
+        //! Funkcja sprawdza czy zadanie jest w kolejce
+        bool contains(int id) const { return mQueued[static_cast<std::size_t>(id)]; }
+
+        //! Funkcja zwraca początek zadań w kolejce, od najlepszego
+        const_iterator begin() const { return const_iterator(this, mHead); }
+        //! Funkcja zwraca koniec zadań w kolejce
+        const_iterator end() const { return const_iterator(this, -1); }
+
+        //! Funkcja zwraca id najlepszego zadania lub -1 gdy kolejka jest pusta
+        int top() const { return mHead; }
+
+        //! Funkcja zwraca id najlepszego zadania z pominięciem top() lub -1
+        int runnerUp() const { return mHead == -1 ? -1 : mNext[static_cast<std::size_t>(mHead)]; }
+
+        //! Metoda dodaje zadanie do kolejki
+        void push(int id)
+        {
+            mQueued[static_cast<std::size_t>(id)] = true;
+            ++mSize;
+            link(id);
+        }
+
+        //! Metoda usuwa zadanie z kolejki
+        void erase(int id)
+        {
+            unlink(id);
+            mQueued[static_cast<std::size_t>(id)] = false;
+            --mSize;
+        }
+
+        //! Metoda przywraca porządek po zmianie priorytetu zadania
+        void update(int id)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+
+            // zadanie pozostaje na miejscu, gdy nadal jest pomiędzy sąsiadami
+            if ((mPrev[i] == -1 || mLess(mPrev[i], id)) && (mNext[i] == -1 || mLess(id, mNext[i])))
+                return;
+
+            unlink(id);
+            link(id);
+        }
+
+    private:
+        //! Metoda wstawia zadanie za ostatnim zadaniem lepszym od niego
+        void link(int id)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            int prev = mTail;
+            while (prev != -1 && mLess(id, prev))
+                prev = mPrev[static_cast<std::size_t>(prev)];
+
+            int next = prev == -1 ? mHead : mNext[static_cast<std::size_t>(prev)];
+            mPrev[i] = prev;
+            mNext[i] = next;
+            (prev == -1 ? mHead : mNext[static_cast<std::size_t>(prev)]) = id;
+            (next == -1 ? mTail : mPrev[static_cast<std::size_t>(next)]) = id;
+        }
+
+        //! Metoda wyjmuje zadanie z listy
+        void unlink(int id)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            int prev = mPrev[i];
+            int next = mNext[i];
+            (prev == -1 ? mHead : mNext[static_cast<std::size_t>(prev)]) = next;
+            (next == -1 ? mTail : mPrev[static_cast<std::size_t>(next)]) = prev;
+            mPrev[i] = mNext[i] = -1;
+        }
+
+        Less mLess;                 //!< funktor porównujący zadania
+        std::vector<int> mNext;     //!< następne zadanie na liście lub -1
+        std::vector<int> mPrev;     //!< poprzednie zadanie na liście lub -1
+        std::vector<bool> mQueued;  //!< czy zadanie jest w kolejce
+        int mHead {-1};             //!< najlepsze zadanie lub -1
+        int mTail {-1};             //!< najgorsze zadanie lub -1
+        std::size_t mSize {0};      //!< liczba zadań w kolejce
+    };
+
+    //! Kolejka m najlepszych zadań gotowych
+    /*!
+    Dzieli zadania gotowe na co najwyżej m wybranych (wykonywanych na m procesorach) i oczekujące.
+    Wybrane przechowywane są w kopcu z najgorszym zadaniem na szczycie, a oczekujące w kopcu
+    z najlepszym na szczycie, więc po zmianie zadań wystarczy porównać oba szczyty
+    i ewentualnie zamienić je miejscami. Każda zmiana kosztuje O(log n), zamiast
+    wybierania m najlepszych zadań spośród wszystkich w każdym kroku.
+
+    Zmiany zadań (update(), erase()) gromadzone są do wywołania rebalance(),
+    po którym wybrane są dokładnie min(m, liczba zadań) najlepsze zadania.
+
+    \tparam Less funktor porównujący id dwóch zadań, true gdy pierwsze jest lepsze,
+    musi być porządkiem liniowym (np. z rozstrzyganiem remisów według id)
+    */
+    template <typename Less>
+    class TopQueue
+    {
+    public:
+        //! Funktor odwracający porównanie, na szczycie kopca wybranych jest najgorsze zadanie
+        struct Worse
+        {
+            Less less;
+
+            bool operator()(int a, int b) const { return less(b, a); }
+        };
+
+        //! Konstruktor
+        explicit TopQueue(Less less = Less())
+            : mLess(less)
+            , mSelected(Worse{less})
+            , mWaiting(less)
+        {}
+
+        //! Metoda czyści kolejkę
+        /*!
+        \param size liczba zadań
+        \param count liczba wybieranych zadań (procesorów)
+        */
+        void reset(std::size_t size, std::size_t count)
+        {
+            mSelected.reset(size);
+            mWaiting.reset(size);
+            mSlots = count;
+        }
+
+        //! Funkcja sprawdza czy zadanie jest w kolejce
+        bool contains(int id) const { return mSelected.contains(id) || mWaiting.contains(id); }
+
+        //! Funkcja sprawdza czy zadanie jest wybrane
+        bool selected(int id) const { return mSelected.contains(id); }
+
+        //! Funkcja zwraca wybrane zadania, w dowolnej kolejności
+        const ReadyQueue<Worse>& selection() const { return mSelected; }
+
+        //! Funkcja zwraca id najlepszego oczekującego zadania lub -1
+        int bestWaiting() const { return mWaiting.top(); }
+
+        //! Metoda dodaje zadanie lub przywraca porządek po zmianie jego priorytetu
+        void update(int id)
+        {
+            if (mSelected.contains(id))
+                mSelected.update(id);
+            else if (mWaiting.contains(id))
+                mWaiting.update(id);
+            else
+                mWaiting.push(id);
+        }
+
+        //! Metoda usuwa zadanie z kolejki
+        void erase(int id)
+        {
+            if (mSelected.contains(id))
+                mSelected.erase(id);
+            else if (mWaiting.contains(id))
+                mWaiting.erase(id);
+        }
+
+        //! Metoda wybiera najlepsze zadania po zmianach
+        void rebalance()
+        {
+            // wolne miejsca zajmują najlepsze oczekujące zadania
+            while (mSelected.size() < mSlots && !mWaiting.empty())
+                move(mWaiting, mSelected);
+
+            // oczekujące zadanie lepsze od najgorszego wybranego zamienia się z nim miejscami
+            while (!mWaiting.empty() && !mSelected.empty() && mLess(mWaiting.top(), mSelected.top()))
+            {
+                int worst = mSelected.top();
+                mSelected.erase(worst);
+                move(mWaiting, mSelected);
+                mWaiting.push(worst);
+            }
+        }
+
+    private:
+        //! Metoda przenosi szczyt jednego kopca do drugiego
+        template <typename From, typename To>
+        static void move(From& from, To& to)
+        {
+            int id = from.top();
+            from.erase(id);
+            to.push(id);
+        }
+
+        Less mLess;                   //!< funktor porównujący zadania
+        ReadyQueue<Worse> mSelected;  //!< wybrane zadania, najgorsze na szczycie
+        ReadyQueue<Less> mWaiting;    //!< oczekujące zadania, najlepsze na szczycie
+        std::size_t mSlots {1};       //!< liczba wybieranych zadań
+    };
+}
@@ -0,0 +1,49 @@
+#include "registry.h"
+
+#include "policies.h"
+
+namespace alg
+{
+    namespace
+    {
+        //! Funkcja zwraca rejestr polityk, wypełniony wbudowanymi politykami przy pierwszym użyciu
+        std::vector<PolicyInfo>& registry()
+        {
+            static std::vector<PolicyInfo> list {
+                makePolicyInfo<DMSPolicy>("DMS", "stale priorytety wedlug terminow wzglednych"),
+                makePolicyInfo<LLFPolicy>("LLF", "najmniejsza swoboda czasowa"),
+                makePolicyInfo<PriorityPolicy>("Priorytetowy", "stale priorytety zadan, mniejsza liczba to wyzszy priorytet"),
+                makePolicyInfo<EDFPolicy>("EDF", "najwczesniejszy termin bezwzgledny"),
+                makePolicyInfo<RMPolicy>("RM", "stale priorytety wedlug okresow"),
+                makePolicyInfo<FIFOPolicy>("FIFO", "kolejnosc zwolnien, bez wywlaszczania"),
+                makePolicyInfo<RoundRobinPolicy>("RR", "kolejnosc zwolnien z kwantem czasu"),
+                makePolicyInfo<HysteresisLLFPolicy>("LLF-H", "najmniejsza swoboda czasowa z histereza wywlaszczen")
+            };
+            return list;
+        }
+    }
+
+    const std::vector<PolicyInfo>& policies()
+    {
+        return registry();
+    }
+
+    bool registerPolicy(const PolicyInfo& info)
+    {
+        if (info.name.empty() || !info.higher || !info.create || findPolicy(info.name))
+            return false;
+
+        registry().push_back(info);
+        return true;
+    }
+
+    const PolicyInfo* findPolicy(const std::string& name)
+    {
+        for (const PolicyInfo &info : registry())
+        {
+            if (info.name == name)
+                return &info;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "multiprocessor.h"
+#include "policies.h"
+#include "task.h"
+
+namespace alg
+{
+    //! Polityka szeregowania w rejestrze polityk
+    /*!
+    Opisuje politykę z policies.h (lub własną, dziedziczącą PolicyHooks) tak, by CLI, GUI
+    i symulacja wsadowa mogły ją wybrać po nazwie, bez osobnego kodu dla każdej polityki.
+    */
+    struct PolicyInfo
+    {
+        std::string name;             //!< nazwa algorytmu w CLI, GUI i plikach przebiegu
+        std::string description;      //!< krótki opis algorytmu, bez polskich znaków jak komunikaty CLI
+        bool fixedPriority {false};   //!< czy priorytety zadań są stałe (Policy::fixedPriority)
+        bool (*higher)(const Task&, const Task&) {nullptr}; //!< porównanie zadań (Policy::higher())
+        PolicyAnalysis analysis {PolicyAnalysis::NONE}; //!< test szeregowalności w analyze() (Policy::analysis)
+        bool usesQuantum {false};     //!< czy polityka korzysta z PolicyOptions::quantum
+        bool usesHysteresis {false};  //!< czy polityka korzysta z PolicyOptions::hysteresis
+        bool usesSticky {false};      //!< czy polityka korzysta z PolicyOptions::sticky
+        std::unique_ptr<SchedulerEngine> (*create)(const MultiprocessorOptions&) {nullptr}; //!< tworzenie silnika (createPolicyEngine())
+    };
+
+    //! Funkcja opisuje politykę do rejestru
+    /*!
+    \tparam Policy polityka szeregowania
+    \param name nazwa algorytmu
+    \param description krótki opis algorytmu
+    */
+    template <typename Policy>
+    PolicyInfo makePolicyInfo(const std::string& name, const std::string& description)
+    {
+        PolicyInfo info;
+        info.name = name;
+        info.description = description;
+        info.fixedPriority = Policy::fixedPriority;
+        info.higher = &Policy::higher;
+        info.analysis = Policy::analysis;
+        info.usesQuantum = Policy::usesQuantum;
+        info.usesHysteresis = Policy::usesHysteresis;
+        info.usesSticky = Policy::usesSticky;
+        info.create = &createPolicyEngine<Policy>;
+        return info;
+    }
+
+    //! Funkcja zwraca zarejestrowane polityki
+    /*!
+    Najpierw wbudowane polityki z policies.h, potem dopisane przez registerPolicy(),
+    w kolejności rejestracji.
+    */
+    const std::vector<PolicyInfo>& policies();
+
+    //! Funkcja dopisuje politykę do rejestru
+    /*!
+    Rejestr nie jest chroniony przed dostępem z wielu wątków, więc polityki należy
+    rejestrować przed uruchomieniem symulacji, np. na początku main().
+    \return false gdy nazwa jest pusta, polityka nie ma funkcji porównującej lub tworzącej silnik,
+    albo nazwa jest już zajęta
+    */
+    bool registerPolicy(const PolicyInfo& info);
+
+    //! Funkcja zwraca politykę o podanej nazwie
+    /*!
+    Wskaźnik przestaje być ważny po kolejnym registerPolicy().
+    \return polityka lub nullptr gdy nazwa jest nieznana
+    */
+    const PolicyInfo* findPolicy(const std::string& name);
+}
@@ -0,0 +1,265 @@
+#include "release.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace alg
+{
+    namespace
+    {
+        //! Wartość oznaczająca brak kolejnych zwolnień
+        const uint noRelease = std::numeric_limits<uint>::max();
+    }
+
+    int ArrivalReader::parse(const std::string& line, uint& time, std::size_t& task)
+    {
+        // pomijamy komentarz
+        std::string::size_type end = line.find('#');
+        if (end == std::string::npos)
+            end = line.size();
+
+        const char* p = line.c_str();
+        const char* last = p + end;
+        while (p < last && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+        if (p == last)
+            return 0;
+
+        // dwie nieujemne liczby: chwila i numer zadania
+        unsigned long long values[2];
+        for (unsigned long long &value : values)
+        {
+            if (p == last || *p < '0' || *p > '9')
+                return -1;
+
+            char* next;
+            value = std::strtoull(p, &next, 10);
+            p = next;
+            while (p < last && (*p == ' ' || *p == '\t' || *p == '\r'))
+                ++p;
+        }
+
+        if (p != last || values[0] >= noRelease || values[1] == 0 || values[1] > std::numeric_limits<int>::max())
+            return -1;
+
+        time = static_cast<uint>(values[0]);
+        task = static_cast<std::size_t>(values[1]);
+        return 1;
+    }
+
+    bool ArrivalReader::begin(const std::vector<Task>& tasks)
+    {
+        mIn.close();
+        mIn.clear();
+        mError.clear();
+        mNextTime = noRelease;
+        mLastTime = 0;
+        mLineNumber = 0;
+
+        // numer zadania w pliku to Task::index + 1
+        mLocal.clear();
+        for (std::size_t i = 0; i < tasks.size(); ++i)
+        {
+            if (tasks[i].arrival != Arrival::APERIODIC || tasks[i].index < 0)
+                continue;
+
+            std::size_t index = static_cast<std::size_t>(tasks[i].index);
+            if (index >= mLocal.size())
+                mLocal.resize(index + 1, -1);
+            mLocal[index] = static_cast<int>(i);
+        }
+
+        mIn.open(mPath);
+        if (!mIn)
+        {
+            mError = mPath + ": nie mozna otworzyc pliku";
+            return false;
+        }
+
+        read();
+        return true;
+    }
+
+    void ArrivalReader::read()
+    {
+        mNextTime = noRelease;
+
+        while (std::getline(mIn, mLine))
+        {
+            ++mLineNumber;
+
+            uint time;
+            std::size_t number;
+            int result = parse(mLine, time, number);
+            if (result == 0)
+                continue;
+
+            if (result < 0 || time < mLastTime)
+            {
+                mError = "wiersz " + std::to_string(mLineNumber)
+                       + (result < 0 ? ": oczekiwano: czas numer_zadania" : ": czasy zwolnien nie moga malec");
+                return;
+            }
+            mLastTime = time;
+
+            // zwolnienia zadań spoza zestawu pomijamy
+            if (number - 1 >= mLocal.size() || mLocal[number - 1] < 0)
+                continue;
+
+            mNextTime = time;
+            mNextTask = mLocal[number - 1];
+            return;
+        }
+    }
+
+    void ArrivalReader::pop(uint time, std::vector<int>& tasks)
+    {
+        while (mNextTime <= time)
+        {
+            tasks.push_back(mNextTask);
+            read();
+        }
+    }
+
+    bool checkArrivals(const std::string& path, std::string& error)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            error = path + ": nie mozna otworzyc pliku";
+            return false;
+        }
+
+        std::string line;
+        uint last = 0;
+        for (int lineNumber = 1; std::getline(in, line); ++lineNumber)
+        {
+            uint time;
+            std::size_t task;
+            int result = ArrivalReader::parse(line, time, task);
+            if (result < 0)
+            {
+                error = path + ": wiersz " + std::to_string(lineNumber) + ": oczekiwano: czas numer_zadania";
+                return false;
+            }
+            if (result > 0 && time < last)
+            {
+                error = path + ": wiersz " + std::to_string(lineNumber) + ": czasy zwolnien nie moga malec";
+                return false;
+            }
+            if (result > 0)
+                last = time;
+        }
+
+        return true;
+    }
+
+    bool GeneratedReleases::begin(const std::vector<Task>& tasks)
+    {
+        mTasks = tasks;
+        mWheel.reset(0);
+        mRandom.resize(tasks.size());
+        mNominal.assign(tasks.size(), 0);
+        mPending.assign(tasks.size(), noRelease);
+
+        mUseArrivals = !mOptions.arrivals.empty();
+        if (mUseArrivals)
+        {
+            mArrivals.setPath(mOptions.arrivals);
+            if (!mArrivals.begin(tasks))
+                return false;
+        }
+
+        for (std::size_t i = 0; i < tasks.size(); ++i)
+        {
+            const Task &t = tasks[i];
+            mRandom[i].seed(mOptions.seed + 0x9E3779B97F4A7C15ull * static_cast<std::uint64_t>(t.index + 1));
+
+            if (t.period <= 0 || (t.arrival == Arrival::APERIODIC && mUseArrivals))
+                continue;
+
+            std::uint64_t offset = static_cast<std::uint64_t>(std::max(t.offset, 0));
+            if (t.arrival == Arrival::APERIODIC)
+            {
+                // proces Poissona rozpoczynający się w chwili offset
+                schedule(i, offset + exponential(i, t.period));
+                continue;
+            }
+
+            mNominal[i] = offset;
+            int jitter = t.arrival == Arrival::PERIODIC ? std::min(t.jitter, t.period - 1) : t.jitter;
+            schedule(i, offset + mRandom[i].below(static_cast<std::uint64_t>(std::max(jitter, 0)) + 1));
+        }
+
+        return true;
+    }
+
+    uint GeneratedReleases::nextTime() const
+    {
+        uint next = mWheel.nextTime();
+        return mUseArrivals ? std::min(next, mArrivals.nextTime()) : next;
+    }
+
+    void GeneratedReleases::pop(uint time, std::vector<int>& tasks)
+    {
+        std::size_t first = tasks.size();
+        mWheel.advance(time, tasks);
+
+        // w miejsce każdego zwolnienia z koła wstawiamy kolejne zwolnienie zadania
+        for (std::size_t k = first; k < tasks.size(); ++k)
+        {
+            std::size_t task = static_cast<std::size_t>(tasks[k]);
+            std::uint64_t previous = mPending[task];
+            mPending[task] = noRelease;
+            scheduleNext(task, previous);
+        }
+
+        if (mUseArrivals)
+            mArrivals.pop(time, tasks);
+    }
+
+    void GeneratedReleases::scheduleNext(std::size_t task, std::uint64_t previous)
+    {
+        const Task &t = mTasks[task];
+        const std::uint64_t period = static_cast<std::uint64_t>(t.period);
+
+        switch (t.arrival)
+        {
+        case Arrival::PERIODIC:
+        {
+            mNominal[task] += period;
+            int jitter = std::min(t.jitter, t.period - 1);
+            schedule(task, mNominal[task] + mRandom[task].below(static_cast<std::uint64_t>(std::max(jitter, 0)) + 1));
+            break;
+        }
+        case Arrival::SPORADIC:
+        {
+            double slack = std::max(mOptions.sporadicSlack, 0.0) * static_cast<double>(period);
+            std::uint64_t extra = slack < 1e18 ? static_cast<std::uint64_t>(slack) : 0;
+            schedule(task, previous + period + mRandom[task].below(extra + 1));
+            break;
+        }
+        case Arrival::APERIODIC:
+            schedule(task, previous + std::max<std::uint64_t>(exponential(task, t.period), 1));
+            break;
+        }
+    }
+
+    void GeneratedReleases::schedule(std::size_t task, std::uint64_t time)
+    {
+        // zwolnienia poza zakresem czasu symulacji pomijamy
+        if (time >= noRelease)
+            return;
+
+        mPending[task] = static_cast<uint>(time);
+        mWheel.insert(static_cast<uint>(time), static_cast<int>(task));
+    }
+
+    std::uint64_t GeneratedReleases::exponential(std::size_t task, double mean)
+    {
+        double value = -std::log(1.0 - mRandom[task].uniform()) * mean;
+        return value < 1e18 ? static_cast<std::uint64_t>(std::llround(value)) : noRelease;
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "generator.h"
+#include "task.h"
+#include "timerwheel.h"
+
+namespace alg
+{
+    //! Ustawienia strumienia zwolnień zadań
+    struct ReleaseOptions
+    {
+        std::uint64_t seed   {1};   //!< ziarno losowania opóźnień i odstępów zwolnień
+        double sporadicSlack {1.0}; //!< odstęp zadania sporadycznego losowany jest z [okres, (1 + sporadicSlack) * okres]
+        std::string arrivals;       //!< plik zwolnień zadań aperiodycznych, pusty gdy zwolnienia są losowane
+    };
+
+    //! Strumień zwolnień zadań
+    /*!
+    Dostarcza silnikowi kolejne zwolnienia instancji w kolejności czasu. Silnik pyta tylko
+    o najbliższą chwilę i o zwolnienia do bieżącej chwili, więc strumień nie musi
+    rozwijać zwolnień z góry i może obsłużyć dowolnie długą symulację.
+    */
+    class ReleaseStream
+    {
+    public:
+        //! Destruktor
+        virtual ~ReleaseStream() = default;
+
+        //! Metoda przygotowuje strumień na początek symulacji
+        /*!
+        \param tasks zadania symulacji, id zadania to jego położenie w tablicy
+        \return false gdy strumienia nie da się przygotować, np. pliku nie da się otworzyć
+        */
+        virtual bool begin(const std::vector<Task>& tasks) = 0;
+
+        //! Funkcja zwraca chwilę, przed którą nie nastąpi żadne zwolnienie
+        /*!
+        \return chwila lub największa wartość typu uint gdy zwolnień już nie będzie
+        */
+        virtual uint nextTime() const = 0;
+
+        //! Metoda dopisuje id zadań zwalnianych nie później niż w podanej chwili
+        /*!
+        Chwile kolejnych wywołań nie maleją.
+        */
+        virtual void pop(uint time, std::vector<int>& tasks) = 0;
+    };
+
+    //! Zwolnienia zadań aperiodycznych wczytywane z pliku
+    /*!
+    Każdy wiersz pliku opisuje jedno zwolnienie: chwilę i numer zadania (od 1, tak jak T1
+    w wynikach), a tekst po znaku '#' jest pomijany. Chwile nie mogą maleć.
+    Numer zadania odpowiada Task::index, więc ten sam plik obsługuje zestawy podzielone
+    pomiędzy procesory. Zwolnienia zadań, które nie są aperiodyczne lub nie należą do
+    symulowanego zestawu, są pomijane.
+
+    Plik czytany jest na bieżąco, wiersz po wierszu, więc pamięć nie zależy od liczby zwolnień.
+    Niepoprawny wiersz kończy strumień, a jego opis zwraca error().
+    */
+    class ArrivalReader : public ReleaseStream
+    {
+    public:
+        //! Konstruktor
+        /*!
+        \param path ścieżka pliku zwolnień
+        */
+        explicit ArrivalReader(const std::string& path = std::string()) : mPath(path) {}
+
+        //! Metoda ustawia ścieżkę pliku zwolnień
+        void setPath(const std::string& path) { mPath = path; }
+
+        //! Funkcja zwraca opis błędu pliku lub pusty tekst
+        const std::string& error() const { return mError; }
+
+        bool begin(const std::vector<Task>& tasks) override;
+        uint nextTime() const override { return mNextTime; }
+        void pop(uint time, std::vector<int>& tasks) override;
+
+        //! Funkcja odczytuje wiersz pliku zwolnień
+        /*!
+        \param line wiersz, komentarz jest pomijany
+        \param time chwila zwolnienia
+        \param task numer zadania od 1
+        \return 1 dla zwolnienia, 0 dla pustego wiersza, -1 gdy wiersz jest niepoprawny
+        */
+        static int parse(const std::string& line, uint& time, std::size_t& task);
+
+    private:
+        //! Metoda wczytuje kolejne zwolnienie zadania z symulowanego zestawu
+        void read();
+
+        std::string mPath;           //!< ścieżka pliku zwolnień
+        std::ifstream mIn;           //!< plik zwolnień
+        std::string mLine;           //!< bufor wiersza
+        std::vector<int> mLocal;     //!< id zadania dla kolejnych numerów zadań z pliku lub -1
+        std::string mError;          //!< opis błędu pliku
+        uint mNextTime {0};          //!< chwila wczytanego zwolnienia
+        int mNextTask {-1};          //!< zadanie wczytanego zwolnienia
+        uint mLastTime {0};          //!< chwila ostatniego zwolnienia w pliku
+        int mLineNumber {0};         //!< numer ostatniego wiersza
+    };
+
+    //! Funkcja sprawdza plik zwolnień
+    /*!
+    \param path ścieżka pliku
+    \param error opis pierwszego błędu
+    \return true jeżeli plik da się otworzyć i wszystkie wiersze są poprawne
+    */
+    bool checkArrivals(const std::string& path, std::string& error);
+
+    //! Zwolnienia wyznaczane z parametrów zadań
+    /*!
+    - zadanie okresowe zwalniane jest w chwilach offset + k * okres, opóźnionych o losową
+      liczbę cykli z [0, jitter], przy czym jitter ograniczony jest do okres - 1, by zwolnienia
+      nie zamieniły się kolejnością,
+    - zadanie sporadyczne zwalniane jest pierwszy raz w chwili offset opóźnionej jak wyżej,
+      a kolejne odstępy losowane są z [okres, (1 + sporadicSlack) * okres],
+    - zadanie aperiodyczne zwalniane jest według pliku zwolnień (ReleaseOptions::arrivals),
+      a bez niego od chwili offset z odstępami o rozkładzie wykładniczym ze średnią równą okresowi.
+
+    Dla każdego zadania pamiętane jest tylko najbliższe zwolnienie, w kole czasowym (TimerWheel),
+    a kolejne losowane jest w chwili jego wystąpienia. Każde zadanie ma własny generator
+    liczb pseudolosowych zależny od ziarna i Task::index, więc zwolnienia zadania nie zależą
+    od pozostałych zadań ani od podziału zestawu pomiędzy procesory.
+    */
+    class GeneratedReleases : public ReleaseStream
+    {
+    public:
+        //! Metoda ustawia ziarno, odstępy zadań sporadycznych i plik zwolnień
+        void setOptions(const ReleaseOptions& options) { mOptions = options; }
+
+        //! Funkcja zwraca ustawienia strumienia
+        const ReleaseOptions& options() const { return mOptions; }
+
+        bool begin(const std::vector<Task>& tasks) override;
+        uint nextTime() const override;
+        void pop(uint time, std::vector<int>& tasks) override;
+
+    private:
+        //! Metoda wyznacza kolejne zwolnienie zadania po zwolnieniu w podanej chwili
+        void scheduleNext(std::size_t task, std::uint64_t previous);
+        //! Metoda dodaje zwolnienie do koła, o ile mieści się w typie uint
+        void schedule(std::size_t task, std::uint64_t time);
+        //! Funkcja losuje odstęp o rozkładzie wykładniczym z podaną średnią
+        std::uint64_t exponential(std::size_t task, double mean);
+
+        ReleaseOptions mOptions;              //!< ustawienia strumienia
+        std::vector<Task> mTasks;             //!< parametry zwalniania zadań
+        TimerWheel mWheel;                    //!< najbliższe zwolnienia zadań
+        ArrivalReader mArrivals;              //!< zwolnienia zadań aperiodycznych z pliku
+        bool mUseArrivals {false};            //!< czy zadania aperiodyczne zwalniane są z pliku
+        std::vector<Random> mRandom;          //!< generatory kolejnych zadań
+        std::vector<std::uint64_t> mNominal;  //!< chwila offset + k * okres ostatniego zwolnienia zadania okresowego
+        std::vector<uint> mPending;           //!< chwila zwolnienia zadania czekającego w kole
+    };
+}
@@ -0,0 +1,63 @@
+#include "resources.h"
+
+namespace alg
+{
+    const char* protocolName(ResourceProtocol protocol)
+    {
+        switch (protocol)
+        {
+        case ResourceProtocol::INHERITANCE:
+            return "PIP";
+        case ResourceProtocol::CEILING:
+            return "PCP";
+        default:
+            return "brak";
+        }
+    }
+
+    bool parseProtocol(const std::string& name, ResourceProtocol& protocol)
+    {
+        if (name == "none")
+            protocol = ResourceProtocol::NONE;
+        else if (name == "pip")
+            protocol = ResourceProtocol::INHERITANCE;
+        else if (name == "pcp" || name == "srp")
+            protocol = ResourceProtocol::CEILING;
+        else
+            return false;
+        return true;
+    }
+
+    void ResourceTable::load(const std::vector<Task>& tasks, bool skipAperiodic)
+    {
+        mPoints.clear();
+        mFirst.assign(1, 0);
+        int resources = 0;
+
+        for (const Task &t : tasks)
+        {
+            std::size_t first = mPoints.size();
+            if (validSections(t) && !(skipAperiodic && t.arrival == Arrival::APERIODIC))
+            {
+                for (const CriticalSection &s : t.sections)
+                {
+                    mPoints.push_back(Point{s.start, s.resource, true});
+                    mPoints.push_back(Point{s.start + s.length, s.resource, false});
+                    resources = std::max(resources, s.resource + 1);
+                }
+            }
+
+            // w tym samym cyklu zwolnienia poprzedzają zajęcia, a zajęcia zachowują kolejność sekcji
+            std::stable_sort(mPoints.begin() + static_cast<std::ptrdiff_t>(first), mPoints.end(),
+                             [](const Point& a, const Point& b) { return a.cycle != b.cycle ? a.cycle < b.cycle : !a.lock && b.lock; });
+            mFirst.push_back(mPoints.size());
+        }
+
+        mCursor.assign(mFirst.begin(), mFirst.end() - 1);
+        mHolder.assign(static_cast<std::size_t>(resources), -1);
+        mWaiters.assign(static_cast<std::size_t>(resources), std::vector<int>());
+        mHeld.assign(tasks.size(), std::vector<int>());
+        mWaitingOn.assign(tasks.size(), -1);
+        mCeiling.assign(static_cast<std::size_t>(resources), -1);
+    }
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Protokół dostępu do zasobów współdzielonych
+    enum class ResourceProtocol : unsigned char
+    {
+        NONE,        //!< zadanie czeka na zajęty zasób bez zmiany priorytetów, możliwa nieograniczona inwersja priorytetów
+        INHERITANCE, //!< dziedziczenie priorytetów (PIP): właściciel zasobu dziedziczy priorytet czekających zadań
+        CEILING      //!< pułap priorytetu (PCP/SRP): właściciel zasobu od razu przyjmuje pułap zasobu
+    };
+
+    //! Funkcja zwraca nazwę protokołu dostępu do zasobów
+    const char* protocolName(ResourceProtocol protocol);
+
+    //! Funkcja odczytuje protokół z nazwy none, pip lub pcp
+    /*!
+    \return false gdy nazwa jest nieznana
+    */
+    bool parseProtocol(const std::string& name, ResourceProtocol& protocol);
+
+    //! Stan zasobów współdzielonych w trakcie symulacji
+    /*!
+    Sekcje krytyczne zadań (Task::sections) zamieniane są na uporządkowane punkty zajęcia
+    i zwolnienia zasobu, liczone w cyklach instancji. Dla każdego zadania pamiętany jest
+    kolejny punkt, więc sprawdzenie punktów przy wykonaniu kosztuje O(1).
+
+    Zasób zwalniany jest od razu najlepszemu z czekających zadań. Kolejność zadań dostarcza
+    silnik w postaci funkcji better(a, b), zwracającej czy zadanie a ma wyższy priorytet bazowy od b.
+    Priorytety dziedziczone wyznacza silnik z właścicieli zasobów (holder()) i czekających (waiters()).
+    */
+    class ResourceTable
+    {
+    public:
+        //! Metoda przygotowuje zasoby na początek symulacji
+        /*!
+        \param tasks zadania symulacji, zadania z niepoprawnymi sekcjami (validSections()) są pomijane
+        \param skipAperiodic czy pominąć sekcje zadań aperiodycznych, np. obsługiwanych przez serwer
+        */
+        void load(const std::vector<Task>& tasks, bool skipAperiodic = false);
+
+        //! Funkcja zwraca czy któreś zadanie korzysta z zasobów
+        bool active() const { return !mPoints.empty(); }
+
+        //! Funkcja zwraca liczbę zasobów
+        std::size_t resources() const { return mHolder.size(); }
+
+        //! Funkcja zwraca właściciela zasobu lub -1
+        int holder(int resource) const { return mHolder[static_cast<std::size_t>(resource)]; }
+
+        //! Funkcja zwraca zadania czekające na zasób
+        const std::vector<int>& waiters(int resource) const { return mWaiters[static_cast<std::size_t>(resource)]; }
+
+        //! Funkcja zwraca zasoby zajęte przez zadanie
+        const std::vector<int>& held(int task) const { return mHeld[static_cast<std::size_t>(task)]; }
+
+        //! Funkcja zwraca zasób, na który czeka zadanie, lub -1
+        int waitingOn(int task) const { return mWaitingOn[static_cast<std::size_t>(task)]; }
+
+        //! Funkcja zwraca zadanie o najwyższym priorytecie korzystające z zasobu (computeCeilings())
+        int ceiling(int resource) const { return mCeiling[static_cast<std::size_t>(resource)]; }
+
+        //! Funkcja zwraca liczbę cykli instancji do kolejnego punktu zajęcia lub zwolnienia zasobu
+        /*!
+        \param task zadanie
+        \param cycles cykle wykonane przez bieżącą instancję
+        \return liczba cykli lub największa wartość typu uint gdy punktów już nie ma
+        */
+        uint nextPoint(int task, int cycles) const
+        {
+            std::size_t t = static_cast<std::size_t>(task);
+            if (mCursor[t] == mFirst[t + 1])
+                return std::numeric_limits<uint>::max();
+            return static_cast<uint>(std::max(mPoints[mCursor[t]].cycle - cycles, 1));
+        }
+
+        //! Metoda wyznacza pułapy zasobów
+        template <typename Better>
+        void computeCeilings(Better better)
+        {
+            mCeiling.assign(mHolder.size(), -1);
+            for (std::size_t t = 0; t + 1 < mFirst.size(); ++t)
+            {
+                for (std::size_t k = mFirst[t]; k < mFirst[t + 1]; ++k)
+                {
+                    int &ceiling = mCeiling[static_cast<std::size_t>(mPoints[k].resource)];
+                    if (ceiling < 0 || better(static_cast<int>(t), ceiling))
+                        ceiling = static_cast<int>(t);
+                }
+            }
+        }
+
+        //! Metoda zajmuje zasoby, których punkty zajęcia przypadają na bieżący cykl instancji
+        /*!
+        Wywoływana, gdy zadanie zostało wybrane do wykonania. Zajęty przez inne zadanie zasób
+        wstrzymuje zadanie, które dopisywane jest do czekających.
+        \param task zadanie
+        \param cycles cykle wykonane przez bieżącą instancję
+        \param better kolejność zadań przy przekazywaniu zasobów
+        \param woken zadania, którym przekazano zwolnione zasoby
+        \return zasób, na który zadanie czeka, lub -1 gdy zajęło wszystkie zasoby
+        */
+        template <typename Better>
+        int lock(int task, int cycles, Better better, std::vector<int>& woken)
+        {
+            std::size_t t = static_cast<std::size_t>(task);
+            for (; mCursor[t] < mFirst[t + 1] && mPoints[mCursor[t]].cycle <= cycles; ++mCursor[t])
+            {
+                const Point &p = mPoints[mCursor[t]];
+                if (!p.lock)
+                {
+                    release(task, p.resource, better, woken);
+                    continue;
+                }
+
+                int &holder = mHolder[static_cast<std::size_t>(p.resource)];
+                if (holder >= 0 && holder != task)
+                {
+                    mWaitingOn[t] = p.resource;
+                    mWaiters[static_cast<std::size_t>(p.resource)].push_back(task);
+                    return p.resource;
+                }
+                holder = task;
+                mHeld[t].push_back(p.resource);
+            }
+            return -1;
+        }
+
+        //! Metoda zwalnia zasoby, których punkty zwolnienia przypadają na bieżący cykl instancji
+        /*!
+        Wywoływana po wykonaniu zadania. Punkty zajęcia czekają na kolejny wybór zadania (lock()).
+        */
+        template <typename Better>
+        void unlock(int task, int cycles, Better better, std::vector<int>& woken)
+        {
+            std::size_t t = static_cast<std::size_t>(task);
+            for (; mCursor[t] < mFirst[t + 1] && mPoints[mCursor[t]].cycle <= cycles && !mPoints[mCursor[t]].lock; ++mCursor[t])
+                release(task, mPoints[mCursor[t]].resource, better, woken);
+        }
+
+        //! Metoda kończy instancję zadania: zwalnia jej zasoby i przerywa czekanie
+        /*!
+        \return zasób, na który zadanie czekało, lub -1
+        */
+        template <typename Better>
+        int drop(int task, Better better, std::vector<int>& woken)
+        {
+            std::size_t t = static_cast<std::size_t>(task);
+            while (!mHeld[t].empty())
+                release(task, mHeld[t].back(), better, woken);
+
+            int resource = mWaitingOn[t];
+            if (resource >= 0)
+            {
+                std::vector<int> &waiters = mWaiters[static_cast<std::size_t>(resource)];
+                waiters.erase(std::find(waiters.begin(), waiters.end(), task));
+                mWaitingOn[t] = -1;
+            }
+
+            mCursor[t] = mFirst[t];
+            return resource;
+        }
+
+    private:
+        //! Punkt zajęcia lub zwolnienia zasobu
+        struct Point
+        {
+            int cycle;    //!< cykl instancji
+            int resource; //!< zasób
+            bool lock;    //!< czy zasób jest zajmowany
+        };
+
+        //! Metoda zwalnia zasób zadania i przekazuje go najlepszemu z czekających
+        template <typename Better>
+        void release(int task, int resource, Better better, std::vector<int>& woken)
+        {
+            std::size_t r = static_cast<std::size_t>(resource);
+            std::vector<int> &held = mHeld[static_cast<std::size_t>(task)];
+            std::vector<int>::iterator it = std::find(held.begin(), held.end(), resource);
+            if (it == held.end())
+                return;
+            held.erase(it);
+
+            std::vector<int> &waiters = mWaiters[r];
+            if (waiters.empty())
+            {
+                mHolder[r] = -1;
+                return;
+            }
+
+            // czekające zadanie zajmuje zasób, więc jego punkt zajęcia jest już wykonany
+            std::vector<int>::iterator best = waiters.begin();
+            for (std::vector<int>::iterator w = waiters.begin() + 1; w != waiters.end(); ++w)
+            {
+                if (better(*w, *best))
+                    best = w;
+            }
+            int next = *best;
+            waiters.erase(best);
+
+            std::size_t n = static_cast<std::size_t>(next);
+            mHolder[r] = next;
+            mHeld[n].push_back(resource);
+            mWaitingOn[n] = -1;
+            ++mCursor[n];
+            woken.push_back(next);
+        }
+
+        std::vector<Point> mPoints;              //!< punkty kolejnych zadań
+        std::vector<std::size_t> mFirst;         //!< pierwszy punkt zadania, na końcu liczba punktów
+        std::vector<std::size_t> mCursor;        //!< kolejny punkt bieżącej instancji zadania
+        std::vector<int> mHolder;                //!< właściciele zasobów
+        std::vector<std::vector<int>> mWaiters;  //!< zadania czekające na zasoby
+        std::vector<std::vector<int>> mHeld;     //!< zasoby zajęte przez zadania
+        std::vector<int> mWaitingOn;             //!< zasób, na który czeka zadanie, lub -1
+        std::vector<int> mCeiling;               //!< pułapy zasobów
+    };
+}
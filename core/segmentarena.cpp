@@ -0,0 +1,59 @@
+#include "segmentarena.h"
+
+namespace alg
+{
+    const std::size_t SegmentArena::chunkSize;
+
+    void SegmentArena::reset(std::size_t tasks)
+    {
+        mTracks.assign(tasks, Track());
+        mChunks.clear();
+    }
+
+    void SegmentArena::append(const Segment& segment)
+    {
+        if (segment.task < 0 || static_cast<std::size_t>(segment.task) >= mTracks.size())
+            return;
+
+        Track &track = mTracks[static_cast<std::size_t>(segment.task)];
+
+        // wykonanie przylegające do poprzedniego wykonania na tym samym procesorze przedłuża je,
+        // tak samo blokowanie przylegające do poprzedniego blokowania
+        if (track.size > 0 && hasLength(segment.kind))
+        {
+            StoredSegment &last = track.chunks[(track.size - 1) / chunkSize][(track.size - 1) % chunkSize];
+            if (last.kind == segment.kind && last.end() == segment.start && last.core == segment.core)
+            {
+                last.length += segment.length;
+                return;
+            }
+        }
+
+        if (track.size == track.chunks.size() * chunkSize)
+        {
+            mChunks.emplace_back(new StoredSegment[chunkSize]);
+            track.chunks.push_back(mChunks.back().get());
+        }
+
+        StoredSegment &s = track.chunks[track.size / chunkSize][track.size % chunkSize];
+        s.start = segment.start;
+        s.length = segment.length;
+        s.kind = segment.kind;
+        s.core = segment.core;
+        ++track.size;
+    }
+
+    std::size_t SegmentArena::firstEndingAfter(std::size_t task, double time) const
+    {
+        std::size_t lo = 0, hi = size(task);
+        while (lo < hi)
+        {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (static_cast<double>(at(task, mid).end()) <= time)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "trace.h"
+
+namespace alg
+{
+    //! Odcinek przechowywany w SegmentArena
+    struct StoredSegment
+    {
+        std::uint32_t start;  //!< chwila rozpoczęcia
+        std::uint32_t length; //!< liczba cykli
+        SegmentKind kind;     //!< rodzaj odcinka
+        std::uint16_t core;   //!< procesor wykonujący zadanie
+
+        //! Funkcja zwraca koniec odcinka, przekroczenie terminu i zwolnienie zajmują jeden cykl
+        std::uint64_t end() const { return static_cast<std::uint64_t>(start) + (hasLength(kind) ? length : 1); }
+    };
+
+    //! Magazyn odcinków przebiegu podzielonych według zadań
+    /*!
+    Odcinki każdego zadania przechowywane są w kolejności czasu, w blokach po chunkSize odcinków
+    przydzielanych z jednej puli. Dopisywanie nie przenosi wcześniejszych odcinków, więc nie wymaga
+    chwilowo podwójnej pamięci jak powiększanie wektora, a cała pamięć zwalniana jest razem z obiektem.
+    */
+    class SegmentArena
+    {
+    public:
+        //! Liczba odcinków w bloku
+        static const std::size_t chunkSize = 4096;
+
+        //! Metoda usuwa odcinki i przygotowuje magazyn dla podanej liczby zadań
+        void reset(std::size_t tasks);
+
+        //! Funkcja zwraca liczbę zadań
+        std::size_t tasks() const { return mTracks.size(); }
+
+        //! Metoda dopisuje odcinek zadania
+        /*!
+        Wykonanie przylegające do poprzedniego wykonania zadania na tym samym procesorze przedłuża poprzedni odcinek.
+        Odcinki zadań spoza zakresu są pomijane.
+        */
+        void append(const Segment& segment);
+
+        //! Funkcja zwraca liczbę odcinków zadania
+        std::size_t size(std::size_t task) const { return mTracks[task].size; }
+
+        //! Funkcja zwraca odcinek zadania
+        const StoredSegment& at(std::size_t task, std::size_t index) const
+        {
+            return mTracks[task].chunks[index / chunkSize][index % chunkSize];
+        }
+
+        //! Funkcja zwraca indeks pierwszego odcinka zadania kończącego się po podanej chwili
+        /*!
+        Odcinki zadania są posortowane zarówno według początku, jak i końca, więc wystarcza wyszukiwanie binarne.
+        \return size(task) gdy takiego odcinka nie ma
+        */
+        std::size_t firstEndingAfter(std::size_t task, double time) const;
+
+        //! Funkcja zwraca liczbę bajtów zajętych przez bloki odcinków
+        std::size_t bytes() const { return mChunks.size() * chunkSize * sizeof(StoredSegment); }
+
+    private:
+        //! Odcinki jednego zadania
+        struct Track
+        {
+            std::vector<StoredSegment*> chunks; //!< kolejne bloki zadania
+            std::size_t size {0};               //!< liczba odcinków
+        };
+
+        std::vector<Track> mTracks;                                //!< odcinki kolejnych zadań
+        std::vector<std::unique_ptr<StoredSegment[]>> mChunks;     //!< wszystkie bloki, właściciel pamięci
+    };
+}
@@ -0,0 +1,100 @@
+#include "server.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace alg
+{
+    const char* serverName(ServerKind kind)
+    {
+        switch (kind)
+        {
+        case ServerKind::POLLING:
+            return "odpytujacy";
+        case ServerKind::DEFERRABLE:
+            return "odroczony";
+        case ServerKind::SPORADIC:
+            return "sporadyczny";
+        default:
+            return "brak";
+        }
+    }
+
+    void BudgetServer::reset(const ServerOptions& options)
+    {
+        mOptions = options;
+        mBudget = static_cast<uint>(std::max(options.budget, 0));
+        mNextPeriod = static_cast<uint>(std::max(options.period, 1));
+        mActive = false;
+        mActiveStart = 0;
+        mConsumed = 0;
+        mQueue.clear();
+        mHead = 0;
+    }
+
+    uint BudgetServer::nextReplenish() const
+    {
+        if (mOptions.kind == ServerKind::SPORADIC)
+            return mHead < mQueue.size() ? mQueue[mHead].time : std::numeric_limits<uint>::max();
+        return mNextPeriod;
+    }
+
+    void BudgetServer::replenish(uint time)
+    {
+        const uint capacity = static_cast<uint>(std::max(mOptions.budget, 0));
+
+        if (mOptions.kind != ServerKind::SPORADIC)
+        {
+            // pełny budżet na początku każdego okresu, niewykorzystany budżet nie przechodzi na kolejny okres
+            const std::uint64_t period = static_cast<std::uint64_t>(std::max(mOptions.period, 1));
+            if (mNextPeriod > time)
+                return;
+
+            mBudget = capacity;
+            std::uint64_t next = mNextPeriod + (time - mNextPeriod) / period * period + period;
+            mNextPeriod = static_cast<uint>(std::min<std::uint64_t>(next, std::numeric_limits<uint>::max()));
+            return;
+        }
+
+        // odnowienia serwera sporadycznego wykonujemy w kolejności chwil
+        while (mHead < mQueue.size() && mQueue[mHead].time <= time)
+        {
+            mBudget = std::min(capacity, mBudget + mQueue[mHead].amount);
+            ++mHead;
+        }
+        if (mHead == mQueue.size())
+        {
+            mQueue.clear();
+            mHead = 0;
+        }
+    }
+
+    bool BudgetServer::update(bool pending)
+    {
+        // serwer odpytujący nie czeka na zadania, niewykorzystany budżet przepada
+        if (mOptions.kind == ServerKind::POLLING && !pending)
+            mBudget = 0;
+
+        bool ready = pending && mBudget > 0;
+        if (!ready && mActive)
+            endActive();
+
+        return ready;
+    }
+
+    void BudgetServer::endActive()
+    {
+        // serwer sporadyczny oddaje zużyty budżet okres po rozpoczęciu jego zużywania
+        if (mOptions.kind == ServerKind::SPORADIC && mConsumed > 0)
+        {
+            Replenishment r;
+            std::uint64_t time = static_cast<std::uint64_t>(mActiveStart) + static_cast<std::uint64_t>(std::max(mOptions.period, 1));
+            r.time = static_cast<uint>(std::min<std::uint64_t>(time, std::numeric_limits<uint>::max()));
+            r.amount = mConsumed;
+            mQueue.push_back(r);
+        }
+        mActive = false;
+        mConsumed = 0;
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Rodzaj serwera zadań aperiodycznych
+    enum class ServerKind : unsigned char
+    {
+        NONE,       //!< brak serwera, zadania aperiodyczne szeregowane są jak pozostałe
+        POLLING,    //!< serwer odpytujący: budżet odnawiany co okres i tracony gdy nie ma zadań
+        DEFERRABLE, //!< serwer odroczony: budżet odnawiany co okres i zachowywany do jego końca
+        SPORADIC    //!< serwer sporadyczny: zużyty budżet wraca okres po rozpoczęciu jego zużywania
+    };
+
+    //! Funkcja zwraca nazwę rodzaju serwera
+    const char* serverName(ServerKind kind);
+
+    //! Ustawienia serwera zadań aperiodycznych
+    /*!
+    Serwer jest zadaniem o czasie wykonania budget, okresie i terminie period oraz priorytecie
+    prioryty, więc w DMS i w algorytmie priorytetowym rywalizuje z zadaniami tak jak one.
+    */
+    struct ServerOptions
+    {
+        ServerKind kind {ServerKind::NONE}; //!< rodzaj serwera
+        int budget      {1};                //!< budżet, liczba cykli na okres
+        int period      {10};               //!< okres odnawiania budżetu
+        int prioryty    {0};                //!< priorytet serwera w algorytmie priorytetowym
+
+        //! Funkcja zwraca czy serwer jest włączony i ma poprawne parametry
+        bool enabled() const { return kind != ServerKind::NONE && budget > 0 && period >= budget; }
+
+        //! Funkcja zwraca serwer jako zadanie rywalizujące o procesor
+        Task task() const { return Task(-1, period, budget, period, prioryty); }
+    };
+
+    //! Budżet serwera zadań aperiodycznych
+    /*!
+    Rozlicza budżet serwera wg reguł jego rodzaju. Wszystkie operacje kosztują O(1),
+    a odnowienia serwera sporadycznego przechowywane są w kolejce FIFO, bo ich chwile rosną.
+
+    Silnik wywołuje:
+    - replenish() w każdej chwili, w której może nastąpić odnowienie (nextReplenish()),
+    - consume() po wykonaniu zadania aperiodycznego w ramach serwera,
+    - update() po każdej zmianie budżetu lub kolejki zadań aperiodycznych.
+
+    Serwer sporadyczny jest uproszczony: każdy ciągły odcinek zużywania budżetu jest odnawiany
+    w całości okres po swoim rozpoczęciu. Odcinek kończy się, gdy serwer przestaje być gotowy
+    (wyczerpał budżet lub nie ma zadań) albo zostaje wywłaszczony, dzięki czemu w żadnym
+    oknie o długości okresu serwer nie zużywa więcej niż budżet.
+    */
+    class BudgetServer
+    {
+    public:
+        //! Metoda przygotowuje serwer na początek symulacji, z pełnym budżetem w chwili 0
+        void reset(const ServerOptions& options);
+
+        //! Funkcja zwraca pozostały budżet
+        uint budget() const { return mBudget; }
+
+        //! Funkcja zwraca chwilę najbliższego odnowienia budżetu
+        /*!
+        \return chwila lub największa wartość typu uint gdy odnowień już nie będzie
+        */
+        uint nextReplenish() const;
+
+        //! Metoda odnawia budżet w podanej chwili
+        void replenish(uint time);
+
+        //! Metoda zmniejsza budżet o cykle wykonane przez zadanie aperiodyczne
+        /*!
+        \param time chwila rozpoczęcia wykonania
+        \param length liczba wykonanych cykli, nie większa niż budget()
+        */
+        void consume(uint time, uint length)
+        {
+            // przerwa w zużywaniu kończy poprzedni odcinek
+            if (mActive && time != mActiveStart + mConsumed)
+                endActive();
+            if (!mActive)
+            {
+                mActive = true;
+                mActiveStart = time;
+            }
+            mBudget -= length;
+            mConsumed += length;
+        }
+
+        //! Funkcja rozlicza zmianę stanu kolejki zadań aperiodycznych
+        /*!
+        \param pending czy w kolejce czekają zadania aperiodyczne
+        \return czy serwer jest gotowy do wykonania
+        */
+        bool update(bool pending);
+
+    private:
+        //! Metoda kończy odcinek zużywania budżetu, serwer sporadyczny planuje jego odnowienie
+        void endActive();
+
+        //! Odnowienie budżetu serwera sporadycznego
+        struct Replenishment
+        {
+            uint time;   //!< chwila odnowienia
+            uint amount; //!< odnawiany budżet
+        };
+
+        ServerOptions mOptions;              //!< ustawienia serwera
+        uint mBudget      {0};               //!< pozostały budżet
+        uint mNextPeriod  {0};               //!< chwila kolejnego odnowienia co okres
+        bool mActive      {false};           //!< czy trwa odcinek zużywania budżetu
+        uint mActiveStart {0};               //!< chwila rozpoczęcia odcinka zużywania budżetu
+        uint mConsumed    {0};               //!< budżet zużyty w bieżącym odcinku
+        std::vector<Replenishment> mQueue;   //!< zaplanowane odnowienia serwera sporadycznego
+        std::size_t mHead {0};               //!< pierwsze niewykonane odnowienie w mQueue
+    };
+}
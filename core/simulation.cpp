@@ -0,0 +1,419 @@
+#include "simulation.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "registry.h"
+
+namespace alg
+{
+    namespace
+    {
+        //! Wartość oznaczająca brak bieżącej instancji zadania
+        const uint noJob = std::numeric_limits<uint>::max();
+
+        //! Odbiorca przekazujący przebieg do dwóch odbiorców
+        /*!
+        Powtórzeń hiperokresu nie rozlicza, więc obaj odbiorcy dostają powtórzone odcinki.
+        */
+        class TeeSink : public TraceSink
+        {
+        public:
+            TeeSink(TraceSink& first, TraceSink& second)
+                : mFirst(first), mSecond(second)
+            {}
+
+            void consume(const Segment* segments, std::size_t count) override
+            {
+                mFirst.consume(segments, count);
+                mSecond.consume(segments, count);
+            }
+
+            void boundary(uint time) override
+            {
+                mFirst.boundary(time);
+                mSecond.boundary(time);
+            }
+
+            void progress(uint time) override
+            {
+                mFirst.progress(time);
+                mSecond.progress(time);
+            }
+
+        private:
+            TraceSink& mFirst;
+            TraceSink& mSecond;
+        };
+    }
+
+    std::unique_ptr<SchedulerEngine> createEngine(const std::string& name)
+    {
+        const PolicyInfo* policy = findPolicy(name);
+        if (!policy)
+            return nullptr;
+
+        return policy->create(MultiprocessorOptions());
+    }
+
+    std::vector<std::string> engineNames()
+    {
+        std::vector<std::string> names;
+        for (const PolicyInfo &policy : policies())
+            names.push_back(policy.name);
+        return names;
+    }
+
+    uint SimulationStats::misses() const
+    {
+        uint sum = 0;
+        for (const TaskStats &s : tasks)
+            sum += s.misses;
+        return sum;
+    }
+
+    uint SimulationStats::preemptions() const
+    {
+        uint sum = 0;
+        for (const TaskStats &s : tasks)
+            sum += s.preemptions;
+        return sum;
+    }
+
+    uint SimulationStats::switches() const
+    {
+        uint sum = 0;
+        for (const TaskStats &s : tasks)
+            sum += s.switches;
+        return sum;
+    }
+
+    uint SimulationStats::blocked() const
+    {
+        uint sum = 0;
+        for (const TaskStats &s : tasks)
+            sum += s.blocked;
+        return sum;
+    }
+
+    uint SimulationStats::switching() const
+    {
+        uint sum = 0;
+        for (const TaskStats &s : tasks)
+            sum += s.switching;
+        return sum;
+    }
+
+    double SimulationStats::switchOverhead() const
+    {
+        if (horizon == 0)
+            return 0.0;
+        return static_cast<double>(switching()) / horizon / std::max(cores, 1u);
+    }
+
+    uint SimulationStats::migrations() const
+    {
+        uint sum = 0;
+        for (const TaskStats &s : tasks)
+            sum += s.migrations;
+        return sum;
+    }
+
+    double SimulationStats::utilization() const
+    {
+        if (horizon == 0)
+            return 0.0;
+
+        double busy = 0.0;
+        for (const TaskStats &s : tasks)
+            busy += s.busy;
+        return busy / horizon / std::max(cores, 1u);
+    }
+
+    StatsCollector::StatsCollector(const std::vector<Task>& tasks, unsigned histogramPrecision)
+        : mTasks(tasks)
+        , mStats(tasks.size())
+        , mJobRelease(tasks.size(), noJob)
+        , mJobDone(tasks.size(), 0)
+        , mTaskCore(tasks.size(), -1)
+        , mLastTask(1, -1)
+        , mLastEnd(1, 0)
+        , mPeriodFirst(1)
+    {
+        for (TaskStats &s : mStats)
+            s.responses = Histogram(histogramPrecision);
+    }
+
+    SimulationStats StatsCollector::stats(uint horizon) const
+    {
+        SimulationStats result;
+        result.horizon = horizon;
+        result.tasks = mStats;
+
+        // zwolnienia ze strumienia policzone zostały z odcinków zwolnień
+        if (mReleaseTimes)
+            return result;
+
+        // instancje zwalniane są w chwilach 0, okres, 2 * okres, ...
+        for (std::size_t i = 0; i < mTasks.size(); ++i)
+        {
+            uint period = static_cast<uint>(std::max(mTasks[i].period, 1));
+            result.tasks[i].jobs = (horizon + period - 1) / period;
+        }
+
+        return result;
+    }
+
+    void StatsCollector::consume(const Segment* segments, std::size_t count)
+    {
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            const Segment &seg = segments[n];
+            std::size_t i = static_cast<std::size_t>(seg.task);
+
+            if (seg.kind == SegmentKind::MISS)
+            {
+                mStats[i].misses++;
+                // na wielu procesorach przekroczenie może przyjść po odcinku sięgającym już kolejnych instancji,
+                // wtedy nie dotyczy śledzonej instancji
+                if (mJobRelease[i] != noJob
+                    && mJobRelease[i] + static_cast<uint>(std::max(mTasks[i].deadline, 0)) <= seg.start)
+                    mJobRelease[i] = noJob;
+                continue;
+            }
+
+            if (seg.kind == SegmentKind::BLOCKED)
+            {
+                mStats[i].blocked += seg.length;
+                continue;
+            }
+
+            if (seg.kind == SegmentKind::RELEASE)
+            {
+                // zwolnienie ze strumienia rozpoczyna nową instancję, a poprzednia jest porzucana
+                mReleaseTimes = true;
+                mStats[i].jobs++;
+                mJobRelease[i] = seg.start;
+                mJobDone[i] = 0;
+                continue;
+            }
+
+            std::size_t core = seg.core;
+            if (core >= mLastTask.size())
+            {
+                mLastTask.resize(core + 1, -1);
+                mLastEnd.resize(core + 1, 0);
+                mPeriodFirst.resize(core + 1);
+            }
+
+            // przełączanie przedłuża ostatnie wykonanie, by wykonanie po nim było wywłaszczeniem
+            if (seg.kind == SegmentKind::SWITCH)
+            {
+                mStats[i].switching += seg.length;
+                if (mLastTask[core] >= 0 && mLastEnd[core] == seg.start)
+                    mLastEnd[core] += seg.length;
+                continue;
+            }
+
+            Dispatch d = dispatch(seg.task, seg.start, core);
+            if (d.switched)
+                mStats[i].switches++;
+            if (d.preempted >= 0)
+                mStats[static_cast<std::size_t>(d.preempted)].preemptions++;
+            if (mPeriodFirst[core].task < 0)
+                mPeriodFirst[core] = d;
+            mLastTask[core] = seg.task;
+            mLastEnd[core] = seg.start + seg.length;
+
+            mStats[i].busy += seg.length;
+
+            // rozpoczęta instancja wznowiona na innym procesorze
+            uint period = static_cast<uint>(std::max(mTasks[i].period, 1));
+            bool started = mReleaseTimes ? mJobRelease[i] != noJob && mJobDone[i] > 0
+                                         : mJobRelease[i] == seg.start / period * period;
+            if (mTaskCore[i] >= 0 && static_cast<std::size_t>(mTaskCore[i]) != core && started)
+                mStats[i].migrations++;
+            mTaskCore[i] = static_cast<int>(core);
+
+            // przy zwolnieniach ze strumienia odcinek należy do ostatnio zwolnionej instancji
+            if (mReleaseTimes)
+            {
+                if (mJobRelease[i] != noJob)
+                    jobRun(i, mJobRelease[i], seg.start, seg.length);
+                continue;
+            }
+
+            // odcinek może obejmować kilka kolejnych instancji, dzielimy go na granicach okresów
+            uint start = seg.start;
+            uint length = seg.length;
+            while (length > 0)
+            {
+                uint release = start / period * period;
+                uint part = std::min(length, release + period - start);
+                jobRun(i, release, start, part);
+                start += part;
+                length -= part;
+            }
+        }
+    }
+
+    StatsCollector::Dispatch StatsCollector::dispatch(int task, uint start, std::size_t core) const
+    {
+        Dispatch d;
+        d.task = task;
+        d.start = start;
+
+        // odcinek przylegający do poprzedniego odcinka tego samego zadania jest jego kontynuacją,
+        // np. po podziale przebiegu na fragmenty, a przerwa między wykonaniami tego samego zadania
+        // nie zmienia kontekstu
+        int last = mLastTask[core];
+        if (last >= 0 && last != task)
+        {
+            d.switched = true;
+            // instancja zwolniona ze strumienia, która nie zaczęła się wykonywać, nie jest wywłaszczana
+            std::size_t l = static_cast<std::size_t>(last);
+            if (start == mLastEnd[core] && mJobRelease[l] != noJob && mJobDone[l] > 0)
+                d.preempted = last;
+        }
+        return d;
+    }
+
+    void StatsCollector::jobRun(std::size_t i, uint release, uint start, uint length)
+    {
+        TaskStats &s = mStats[i];
+
+        if (mJobRelease[i] != release)
+        {
+            mJobRelease[i] = release;
+            mJobDone[i] = 0;
+        }
+
+        mJobDone[i] += length;
+        if (mJobDone[i] >= static_cast<uint>(mTasks[i].time))
+        {
+            uint response = start + length - release;
+            s.completed++;
+            int lateness = static_cast<int>(response) - mTasks[i].deadline;
+            s.maxLateness = s.completed == 1 ? lateness : std::max(s.maxLateness, lateness);
+            s.maxResponse = std::max(s.maxResponse, response);
+            s.sumResponse += response;
+            s.responses.add(response);
+            mJobRelease[i] = noJob;
+        }
+    }
+
+    void StatsCollector::boundary(uint time)
+    {
+        mBoundary = mStats;
+        mBoundaryTime = time;
+        mPeriodFirst.assign(mLastTask.size(), Dispatch());
+    }
+
+    bool StatsCollector::repeat(uint period, uint count)
+    {
+        if (mBoundary.size() != mStats.size())
+            return false;
+
+        // stan zadań na końcu okresu jest taki sam jak na początku, więc każdy okres wnosi te same przyrosty
+        for (std::size_t i = 0; i < mStats.size(); ++i)
+        {
+            if (mJobRelease[i] != noJob)
+                mJobRelease[i] += period * count;
+
+            TaskStats &s = mStats[i];
+            const TaskStats &b = mBoundary[i];
+            s.completed += (s.completed - b.completed) * count;
+            s.misses += (s.misses - b.misses) * count;
+            s.busy += (s.busy - b.busy) * count;
+            s.sumResponse += (s.sumResponse - b.sumResponse) * count;
+            s.preemptions += (s.preemptions - b.preemptions) * count;
+            s.switches += (s.switches - b.switches) * count;
+            s.migrations += (s.migrations - b.migrations) * count;
+            s.blocked += (s.blocked - b.blocked) * count;
+            s.switching += (s.switching - b.switching) * count;
+            s.responses.repeat(b.responses, count);
+        }
+
+        // pierwsze wykonanie okresu na procesorze następowało po wykonaniu sprzed granicy, a w powtórzeniach
+        // następuje po ostatnim wykonaniu okresu na tym procesorze, więc jego skutek może być inny
+        for (std::size_t core = 0; core < mPeriodFirst.size(); ++core)
+        {
+            const Dispatch &previous = mPeriodFirst[core];
+            if (previous.task < 0)
+                continue;
+
+            Dispatch repeated = dispatch(previous.task, previous.start + period, core);
+            TaskStats &first = mStats[static_cast<std::size_t>(previous.task)];
+            first.switches -= (previous.switched ? count : 0);
+            first.switches += (repeated.switched ? count : 0);
+            if (previous.preempted >= 0)
+                mStats[static_cast<std::size_t>(previous.preempted)].preemptions -= count;
+            if (repeated.preempted >= 0)
+                mStats[static_cast<std::size_t>(repeated.preempted)].preemptions += count;
+        }
+        for (std::size_t core = 0; core < mLastTask.size(); ++core)
+        {
+            if (mLastTask[core] >= 0)
+                mLastEnd[core] += period * count;
+        }
+
+        return true;
+    }
+
+    SimulationStats simulate(SchedulerEngine& engine, uint endTime, bool events, TraceSink* trace,
+                             unsigned histogramPrecision)
+    {
+        StatsCollector collector(engine.tasks, histogramPrecision);
+        TeeSink tee(collector, trace ? *trace : collector);
+        engine.setTraceSink(trace ? static_cast<TraceSink*>(&tee) : &collector);
+
+        if (events)
+            engine.scheduleEvents(endTime);
+        else
+            engine.schedule(endTime);
+
+        engine.setTraceSink(nullptr);
+        SimulationStats stats = collector.stats(endTime);
+        stats.cores = engine.cores();
+        stats.systemOk = engine.systemOk();
+        stats.locking = engine.locking();
+        stats.switchCost = static_cast<uint>(std::max(engine.policyOptions().switchCost, 0));
+        if (engine.serving())
+            collectServerStats(stats, engine.tasks, histogramPrecision);
+        return stats;
+    }
+
+    void collectServerStats(SimulationStats& stats, const std::vector<Task>& tasks, unsigned histogramPrecision)
+    {
+        TaskStats server;
+        server.responses = Histogram(histogramPrecision);
+        server.maxLateness = std::numeric_limits<int>::min();
+
+        for (std::size_t i = 0; i < tasks.size() && i < stats.tasks.size(); ++i)
+        {
+            if (tasks[i].arrival != Arrival::APERIODIC)
+                continue;
+
+            const TaskStats &t = stats.tasks[i];
+            server.jobs += t.jobs;
+            server.completed += t.completed;
+            server.misses += t.misses;
+            server.busy += t.busy;
+            server.maxResponse = std::max(server.maxResponse, t.maxResponse);
+            server.sumResponse += t.sumResponse;
+            if (t.completed)
+                server.maxLateness = std::max(server.maxLateness, t.maxLateness);
+            server.preemptions += t.preemptions;
+            server.switches += t.switches;
+            server.migrations += t.migrations;
+            server.blocked += t.blocked;
+            server.switching += t.switching;
+            server.responses.merge(t.responses);
+        }
+
+        if (server.maxLateness == std::numeric_limits<int>::min())
+            server.maxLateness = 0;
+        stats.served = true;
+        stats.server = server;
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "basicscheduler.h"
+#include "histogram.h"
+
+namespace alg
+{
+    //! Funkcja tworzy silnik harmonogramu dla podanej nazwy algorytmu
+    /*!
+    Algorytmy pochodzą z rejestru polityk (policies()).
+    \param name nazwa algorytmu, np. "DMS", "LLF", "EDF"
+    \return silnik lub nullptr gdy algorytm jest nieznany
+    */
+    std::unique_ptr<SchedulerEngine> createEngine(const std::string& name);
+
+    //! Funkcja zwraca nazwy dostępnych algorytmów, w kolejności rejestru polityk
+    std::vector<std::string> engineNames();
+
+    //! Statystyki zadania
+    struct TaskStats
+    {
+        uint jobs        {0}; //!< liczba zwolnionych instancji zadania
+        uint completed   {0}; //!< liczba instancji zakończonych
+        uint misses      {0}; //!< liczba przekroczonych terminów
+        uint busy        {0}; //!< liczba cykli wykonywania zadania
+        uint maxResponse {0}; //!< najdłuższy czas odpowiedzi
+        double sumResponse {0.0}; //!< suma czasów odpowiedzi
+        int maxLateness  {0}; //!< największe spóźnienie zakończonej instancji względem terminu, ujemne gdy wszystkie zdążyły
+        uint preemptions {0}; //!< liczba wywłaszczeń niezakończonej instancji przez inne zadanie
+        uint switches    {0}; //!< liczba przełączeń kontekstu na to zadanie z innego zadania
+        uint migrations  {0}; //!< liczba wznowień rozpoczętej instancji na innym procesorze
+        uint blocked     {0}; //!< liczba cykli blokowania przez zadania o niższym priorytecie (SegmentKind::BLOCKED)
+        uint switching   {0}; //!< liczba cykli przełączania kontekstu na to zadanie (SegmentKind::SWITCH)
+        Histogram responses;  //!< rozkład czasów odpowiedzi
+
+        //! Funkcja zwraca średni czas odpowiedzi
+        double avgResponse() const { return completed ? sumResponse / completed : 0.0; }
+        //! Funkcja zwraca percentyl czasu odpowiedzi, np. 0.99, lub 0 gdy histogram jest wyłączony
+        uint responsePercentile(double q) const { return std::min(responses.percentile(q), maxResponse); }
+        //! Funkcja zwraca wykorzystanie procesora przez zadanie w podanym czasie symulacji
+        double utilization(uint horizon) const { return horizon ? static_cast<double>(busy) / horizon : 0.0; }
+    };
+
+    //! Statystyki symulacji
+    struct SimulationStats
+    {
+        uint horizon {0};             //!< czas symulacji
+        uint cores {1};               //!< liczba procesorów (SchedulerEngine::cores())
+        bool systemOk {true};         //!< czy żadna instancja nie przekroczyła terminu (SchedulerEngine::systemOk())
+        std::vector<TaskStats> tasks; //!< statystyki kolejnych zadań
+        bool served {false};          //!< czy zadania aperiodyczne obsługiwał serwer (SchedulerEngine::serving())
+        TaskStats server;             //!< łączne statystyki zadań obsłużonych przez serwer
+        bool locking {false};         //!< czy zadania korzystały z zasobów (SchedulerEngine::locking())
+        uint switchCost {0};          //!< koszt przełączenia kontekstu (PolicyOptions::switchCost)
+
+        //! Funkcja zwraca łączną liczbę przekroczonych terminów
+        uint misses() const;
+        //! Funkcja zwraca łączną liczbę wywłaszczeń
+        uint preemptions() const;
+        //! Funkcja zwraca łączną liczbę przełączeń kontekstu
+        uint switches() const;
+        //! Funkcja zwraca łączną liczbę migracji
+        uint migrations() const;
+        //! Funkcja zwraca łączną liczbę cykli blokowania
+        uint blocked() const;
+        //! Funkcja zwraca łączną liczbę cykli przełączania kontekstu
+        uint switching() const;
+        //! Funkcja zwraca część czasu procesorów straconą na przełączanie kontekstu
+        double switchOverhead() const;
+        //! Funkcja zwraca wykorzystanie procesora, przy wielu procesorach średnie na procesor
+        double utilization() const;
+    };
+
+    //! Funkcja sumuje statystyki zadań aperiodycznych w statystyki serwera
+    /*!
+    Czasy odpowiedzi serwera to czasy odpowiedzi wszystkich obsłużonych instancji,
+    a wywłaszczenia, przełączenia i cykle przełączania to suma tych z zadań aperiodycznych.
+    \param stats statystyki symulacji, uzupełniane są pola served i server
+    \param tasks tablica zadań symulacji
+    \param histogramPrecision precyzja histogramów czasów odpowiedzi
+    */
+    void collectServerStats(SimulationStats& stats, const std::vector<Task>& tasks,
+                            unsigned histogramPrecision = Histogram::defaultPrecision);
+
+    //! Odbiorca przebiegu zbierający statystyki symulacji
+    /*!
+    Czasy odpowiedzi wyznaczane są z odcinków wykonania: instancja zadania zwalniana jest
+    w chwilach k * okres, a kończy się gdy suma jej odcinków osiągnie czas wykonania.
+    Gdy przebieg zawiera odcinki zwolnień (SegmentKind::RELEASE), chwile zwolnień
+    i liczba instancji brane są z nich.
+
+    Przełączenie kontekstu to zmiana wykonywanego zadania, tak jak zmiana SchedulerEngine::mLastTaskId,
+    przy czym przerwa bez zadania pomiędzy wykonaniami tego samego zadania nie jest przełączeniem.
+    Wywłaszczenie to przełączenie, w którym poprzednie zadanie nie zakończyło bieżącej instancji.
+    Przy wielu procesorach przełączenia i wywłaszczenia liczone są osobno dla każdego procesora
+    (Segment::core), a migracja to wznowienie rozpoczętej instancji na innym procesorze niż poprzednio.
+    Odcinek przełączania kontekstu (SegmentKind::SWITCH) nie jest wykonaniem, ale wykonanie
+    po nim przylega do poprzedniego wykonania na procesorze, więc jest liczone jako wywłaszczenie.
+
+    Powtórzenia hiperokresu rozliczane są bez odcinków, przez dodanie przyrostu
+    statystyk od ostatniej granicy pomnożonego przez liczbę powtórzeń.
+    */
+    class StatsCollector : public TraceSink
+    {
+    public:
+        //! Konstruktor
+        /*!
+        \param tasks tablica zadań symulowanego harmonogramu
+        \param histogramPrecision precyzja histogramów czasów odpowiedzi (Histogram), 0 wyłącza histogramy
+        */
+        explicit StatsCollector(const std::vector<Task>& tasks, unsigned histogramPrecision = Histogram::defaultPrecision);
+
+        //! Funkcja zwraca statystyki dla podanego czasu symulacji
+        SimulationStats stats(uint horizon) const;
+
+        void consume(const Segment* segments, std::size_t count) override;
+        void boundary(uint time) override;
+        bool repeat(uint period, uint count) override;
+
+    private:
+        //! Skutek rozpoczęcia wykonania zadania dla statystyk przełączeń
+        struct Dispatch
+        {
+            int task      {-1};    //!< rozpoczynające się zadanie, -1 gdy brak
+            uint start    {0};     //!< chwila rozpoczęcia
+            bool switched {false}; //!< czy nastąpiło przełączenie kontekstu
+            int preempted {-1};    //!< wywłaszczone zadanie lub -1
+        };
+
+        //! Funkcja wyznacza skutek rozpoczęcia wykonania zadania po ostatnim odcinku wykonania na procesorze
+        Dispatch dispatch(int task, uint start, std::size_t core) const;
+        //! Metoda rozlicza wykonanie zadania należące do jednej instancji
+        void jobRun(std::size_t taskId, uint release, uint start, uint length);
+
+        const std::vector<Task>& mTasks;  //!< tablica zadań
+        std::vector<TaskStats> mStats;    //!< statystyki kolejnych zadań
+        std::vector<TaskStats> mBoundary; //!< statystyki z chwili ostatniej granicy okresu
+        std::vector<uint> mJobRelease;    //!< chwila zwolnienia bieżącej instancji zadania
+        std::vector<uint> mJobDone;       //!< cykle wykonane przez bieżącą instancję
+        std::vector<int> mTaskCore;       //!< procesor ostatniego odcinka wykonania zadania lub -1
+        std::vector<int> mLastTask;       //!< zadanie ostatniego odcinka wykonania na procesorze
+        std::vector<uint> mLastEnd;       //!< koniec ostatniego odcinka wykonania na procesorze
+        uint mBoundaryTime {0};           //!< chwila ostatniej granicy okresu
+        bool mReleaseTimes {false};       //!< czy zwolnienia pochodzą z odcinków zwolnień
+        std::vector<Dispatch> mPeriodFirst; //!< pierwsze wykonanie na procesorze po ostatniej granicy okresu
+    };
+
+    //! Funkcja uruchamia symulację i zwraca statystyki
+    /*!
+    \param engine silnik z wczytanymi zadaniami
+    \param endTime czas zakończenia symulacji
+    \param events czy użyć symulacji sterowanej zdarzeniami
+    \param trace dodatkowy odbiorca przebiegu, np. TraceWriter, lub nullptr
+    \param histogramPrecision precyzja histogramów czasów odpowiedzi, 0 wyłącza histogramy
+    */
+    SimulationStats simulate(SchedulerEngine& engine, uint endTime, bool events = true, TraceSink* trace = nullptr,
+                             unsigned histogramPrecision = Histogram::defaultPrecision);
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace alg
+{
+    // skracam nazwę typu
+    using uint = unsigned int;
+
+    //! Sposób zwalniania kolejnych instancji zadania
+    enum class Arrival : unsigned char
+    {
+        PERIODIC, //!< co okres, od chwili przesunięcia, z opóźnieniem do jitter cykli
+        SPORADIC, //!< okres jest najmniejszym odstępem pomiędzy kolejnymi zwolnieniami
+        APERIODIC //!< zwolnienia z pliku zwolnień lub losowane ze średnim odstępem równym okresowi
+    };
+
+    //! Sekcja krytyczna zadania
+    /*!
+    Instancja zadania zajmuje zasób po wykonaniu start cykli i zwalnia go po kolejnych length cyklach.
+    */
+    struct CriticalSection
+    {
+        int resource {0}; //!< numer zasobu, od 0 (w plikach i w aplikacji R1, R2, ...)
+        int start    {0}; //!< cykl instancji, przed którym zasób jest zajmowany
+        int length   {0}; //!< liczba cykli wykonywanych z zajętym zasobem
+    };
+
+    //! Zadanie
+    /*!
+    Struktura danych reprezentująca zadanie w harmonogramie
+    */
+    struct Task
+    {
+        Task() = default;
+        Task(int index, int period, int time, int deadline, int prioryty)
+            : index(index)
+            , period(period)
+            , time(time)
+            , deadline(deadline)
+            , prioryty(prioryty)
+            , timeToDeadline(deadline)
+        {}
+
+        int index   {0};  //!< koleny indeks zadania 
+        int period  {0};  //!< okres 
+        int time    {0};  //!< czas wykonania zadania
+        int deadline{0};  //!< termin
+        int prioryty{0};  //!< priorytet
+        int offset  {0};  //!< chwila pierwszego zwolnienia
+        int jitter  {0};  //!< największe opóźnienie zwolnienia względem chwili offset + k * okres
+        Arrival arrival {Arrival::PERIODIC}; //!< sposób zwalniania instancji
+        std::vector<CriticalSection> sections; //!< sekcje krytyczne instancji w kolejności rozpoczęcia
+
+        int cycles         {0}; //!< liczba cykli trwania zadania
+        int timeToDeadline {0}; //!< cykle pozostałe do nstępnego terminu
+        int timeToEnd  {0}; //!< cykle pozostałe do zakończenia zadania
+        std::uint64_t order {0}; //!< klucz kolejności instancji nadawany przez politykę, np. termin bezwzględny w EDF (tylko w TaskTable::row())
+        int sliceEnd   {0}; //!< cykl instancji, w którym kończy się kwant czasu w RoundRobinPolicy (tylko w TaskTable::row())
+    };
+
+    //! Funkcja sprawdza czy zadnie się zakończyło
+    inline bool isTaskSchedulable(const Task &t)
+    {
+        return t.cycles < t.time;
+    }
+
+    //! Funkcja sprawdza czy zadanie zwalniane jest dokładnie w chwilach k * okres
+    inline bool isStrictlyPeriodic(const Task &t)
+    {
+        return t.arrival == Arrival::PERIODIC && t.offset == 0 && t.jitter == 0;
+    }
+
+    //! Funkcja sprawdza czy wszystkie zadania zwalniane są dokładnie w chwilach k * okres
+    /*!
+    Tylko wtedy silnik zwalnia zadania licznikami okresów w TaskTable. W przeciwnym razie
+    zwolnienia pochodzą ze strumienia zwolnień (ReleaseStream).
+    */
+    inline bool isStrictlyPeriodic(const std::vector<Task> &tasks)
+    {
+        for (const Task &t : tasks)
+        {
+            if (!isStrictlyPeriodic(t))
+                return false;
+        }
+        return true;
+    }
+
+    //! Funkcja sprawdza poprawność sekcji krytycznych zadania
+    /*!
+    Sekcje muszą mieścić się w czasie wykonania, być uporządkowane według początku
+    i być rozłączne lub zagnieżdżone, a zagnieżdżona sekcja nie może zajmować tego samego zasobu.
+    */
+    inline bool validSections(const Task &t)
+    {
+        for (std::size_t i = 0; i < t.sections.size(); ++i)
+        {
+            const CriticalSection &s = t.sections[i];
+            if (s.resource < 0 || s.start < 0 || s.length <= 0 || s.start > t.time - s.length)
+                return false;
+
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                const CriticalSection &outer = t.sections[j];
+                if (outer.start > s.start)
+                    return false;
+                bool nested = s.start < outer.start + outer.length;
+                if (nested && (s.start + s.length > outer.start + outer.length || s.resource == outer.resource))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    //! Funkcja sprawdza czy któreś zadanie ma sekcje krytyczne
+    inline bool hasCriticalSections(const std::vector<Task> &tasks)
+    {
+        for (const Task &t : tasks)
+        {
+            if (!t.sections.empty())
+                return true;
+        }
+        return false;
+    }
+
+    //! Funkcja zwraca hiperokres zadań (najmniejszą wspólną wielokrotność okresów)
+    /*!
+    \return hiperokres lub 0 gdy nie mieści się w typie uint albo któryś okres nie jest dodatni
+    */
+    inline uint hyperperiod(const std::vector<Task> &tasks)
+    {
+        if (tasks.empty())
+            return 0;
+
+        std::uint64_t lcm = 1;
+        for (const Task &t : tasks)
+        {
+            if (t.period <= 0)
+                return 0;
+
+            // nwd liczymy algorytmem Euklidesa
+            std::uint64_t a = lcm;
+            std::uint64_t b = static_cast<std::uint64_t>(t.period);
+            while (b)
+            {
+                std::uint64_t r = a % b;
+                a = b;
+                b = r;
+            }
+
+            lcm = lcm / a * static_cast<std::uint64_t>(t.period);
+            if (lcm > std::numeric_limits<uint>::max())
+                return 0;
+        }
+
+        return static_cast<uint>(lcm);
+    }
+}
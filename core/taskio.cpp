@@ -0,0 +1,195 @@
+#include "taskio.h"
+
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace alg
+{
+    namespace
+    {
+        //! Funkcja odczytuje liczbę całkowitą zajmującą cały tekst
+        bool parseInt(const std::string& text, int& value)
+        {
+            char* end;
+            long number = std::strtol(text.c_str(), &end, 10);
+            if (end == text.c_str() || *end != '\0' || number < -2147483647L || number > 2147483647L)
+                return false;
+            value = static_cast<int>(number);
+            return true;
+        }
+
+        //! Funkcja odczytuje sekcję krytyczną zapisaną jako Rn:początek:długość
+        bool parseSection(const std::string& token, CriticalSection& section)
+        {
+            if (token.size() < 2 || token[0] != 'R')
+                return false;
+
+            std::string::size_type first = token.find(':');
+            std::string::size_type second = first == std::string::npos ? first : token.find(':', first + 1);
+            if (second == std::string::npos)
+                return false;
+
+            int number;
+            if (!parseInt(token.substr(1, first - 1), number) || number < 1
+                || !parseInt(token.substr(first + 1, second - first - 1), section.start)
+                || !parseInt(token.substr(second + 1), section.length))
+                return false;
+
+            section.resource = number - 1;
+            return true;
+        }
+
+        //! Funkcja zwraca literę rodzaju zwalniania zadania
+        char arrivalLetter(Arrival arrival)
+        {
+            switch (arrival)
+            {
+            case Arrival::SPORADIC:
+                return 's';
+            case Arrival::APERIODIC:
+                return 'a';
+            default:
+                return 'p';
+            }
+        }
+    }
+
+    bool readTaskSets(std::istream& in, std::vector<TaskSet>& sets, std::string& error)
+    {
+        TaskSet current;
+        std::string line;
+        int lineNumber = 0;
+
+        while (std::getline(in, line))
+        {
+            ++lineNumber;
+
+            // pomijamy komentarz
+            std::string::size_type comment = line.find('#');
+            if (comment != std::string::npos)
+                line.erase(comment);
+
+            std::istringstream fields(line);
+            int time {0};
+            int period {0};
+            int deadline {0};
+            int prioryty {0};
+
+            // pusty wiersz kończy zestaw
+            if (!(fields >> time))
+            {
+                if (line.find_first_not_of(" \t\r") != std::string::npos)
+                {
+                    error = "wiersz " + std::to_string(lineNumber) + ": niepoprawny czas wykonania";
+                    return false;
+                }
+                if (!current.empty())
+                    sets.push_back(std::move(current));
+                current.clear();
+                continue;
+            }
+
+            if (!(fields >> period >> deadline) || time < 1 || period < 1 || deadline < 1)
+            {
+                error = "wiersz " + std::to_string(lineNumber) + ": oczekiwano dodatnich wartosci: czas okres termin [priorytet]";
+                return false;
+            }
+
+            // priorytet, przesunięcie, jitter i rodzaj zwalniania są opcjonalne
+            int optional[3] = {0, 0, 0};
+            int numbers = 0;
+            Arrival arrival = Arrival::PERIODIC;
+            bool kind = false;
+            std::vector<CriticalSection> sections;
+            std::string token;
+            while (fields >> token)
+            {
+                // sekcje krytyczne kończą wiersz
+                CriticalSection section;
+                if (parseSection(token, section))
+                {
+                    sections.push_back(section);
+                    continue;
+                }
+
+                if (!kind && sections.empty() && (token == "p" || token == "s" || token == "a"))
+                {
+                    arrival = token == "p" ? Arrival::PERIODIC : token == "s" ? Arrival::SPORADIC : Arrival::APERIODIC;
+                    kind = true;
+                    continue;
+                }
+
+                // rodzaj zwalniania kończy wiersz, a przesunięcie i jitter nie mogą być ujemne
+                if (kind || !sections.empty() || numbers == 3 || !parseInt(token, optional[numbers]) || (numbers > 0 && optional[numbers] < 0))
+                {
+                    error = "wiersz " + std::to_string(lineNumber)
+                          + ": oczekiwano: czas okres termin [priorytet [przesuniecie [jitter]]] [p|s|a] [Rn:poczatek:dlugosc ...]";
+                    return false;
+                }
+                ++numbers;
+            }
+            prioryty = optional[0];
+
+            current.emplace_back(static_cast<int>(current.size()), period, time, deadline, prioryty);
+            current.back().offset = optional[1];
+            current.back().jitter = optional[2];
+            current.back().arrival = arrival;
+            current.back().sections = std::move(sections);
+
+            if (!validSections(current.back()))
+            {
+                error = "wiersz " + std::to_string(lineNumber)
+                      + ": sekcje krytyczne musza miescic sie w czasie wykonania i byc rozlaczne lub zagniezdzone";
+                return false;
+            }
+        }
+
+        if (!current.empty())
+            sets.push_back(std::move(current));
+
+        return true;
+    }
+
+    void writeTaskSet(std::ostream& out, const TaskSet& tasks)
+    {
+        out << "# czas okres termin priorytet\n";
+        for (const Task &t : tasks)
+        {
+            out << t.time << ' ' << t.period << ' ' << t.deadline << ' ' << t.prioryty;
+            if (!isStrictlyPeriodic(t))
+                out << ' ' << t.offset << ' ' << t.jitter << ' ' << arrivalLetter(t.arrival);
+            if (!t.sections.empty())
+                out << ' ' << formatSections(t.sections);
+            out << '\n';
+        }
+    }
+
+    bool parseSections(const std::string& text, std::vector<CriticalSection>& sections)
+    {
+        std::istringstream fields(text);
+        std::string token;
+        sections.clear();
+        while (fields >> token)
+        {
+            CriticalSection section;
+            if (!parseSection(token, section))
+                return false;
+            sections.push_back(section);
+        }
+        return true;
+    }
+
+    std::string formatSections(const std::vector<CriticalSection>& sections)
+    {
+        std::string text;
+        for (const CriticalSection &s : sections)
+        {
+            if (!text.empty())
+                text += ' ';
+            text += 'R' + std::to_string(s.resource + 1) + ':' + std::to_string(s.start) + ':' + std::to_string(s.length);
+        }
+        return text;
+    }
+}
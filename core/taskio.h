@@ -0,0 +1,46 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Zestaw zadań
+    using TaskSet = std::vector<Task>;
+
+    //! Funkcja wczytuje zestawy zadań ze strumienia
+    /*!
+    Każdy wiersz opisuje jedno zadanie: czas wykonania, okres, termin i opcjonalnie priorytet,
+    przesunięcie pierwszego zwolnienia i jitter (Task::offset, Task::jitter), a na końcu
+    rodzaj zwalniania: p - okresowe, s - sporadyczne, a - aperiodyczne (Arrival).
+    Wiersz mogą kończyć sekcje krytyczne zapisane jak w parseSections().
+    Zestawy oddzielone są pustymi wierszami, a tekst po znaku '#' jest pomijany.
+    \param in strumień wejściowy
+    \param sets wczytane zestawy zadań
+    \param error opis błędu gdy wczytanie się nie powiodło
+    \return true jeżeli udało się wczytać wszystkie wiersze
+    */
+    bool readTaskSets(std::istream& in, std::vector<TaskSet>& sets, std::string& error);
+
+    //! Metoda zapisuje zestaw zadań do strumienia w formacie czytanym przez readTaskSets()
+    /*!
+    Pola zwolnień zapisywane są tylko dla zadań, które nie są ściśle okresowe.
+    */
+    void writeTaskSet(std::ostream& out, const TaskSet& tasks);
+
+    //! Funkcja odczytuje sekcje krytyczne zadania
+    /*!
+    Sekcje oddzielone są białymi znakami, a każda zapisana jest jako Rn:początek:długość,
+    gdzie n to numer zasobu od 1, a początek to cykl instancji, przed którym zasób jest zajmowany.
+    \param text tekst sekcji, pusty gdy zadanie nie korzysta z zasobów
+    \param sections odczytane sekcje
+    \return false gdy któraś sekcja jest niepoprawnie zapisana
+    */
+    bool parseSections(const std::string& text, std::vector<CriticalSection>& sections);
+
+    //! Funkcja zapisuje sekcje krytyczne zadania w formacie czytanym przez parseSections()
+    std::string formatSections(const std::vector<CriticalSection>& sections);
+}
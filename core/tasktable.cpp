@@ -0,0 +1,261 @@
+#include "tasktable.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TASKTABLE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TASKTABLE_SSE2
+#endif
+
+namespace alg
+{
+    namespace
+    {
+        //! Liczba zadań przetwarzanych jednocześnie
+#if defined(TASKTABLE_AVX2)
+        const std::size_t lanes = 8;
+#elif defined(TASKTABLE_SSE2)
+        const std::size_t lanes = 4;
+#else
+        const std::size_t lanes = 1;
+#endif
+
+#if defined(TASKTABLE_AVX2)
+        using Vec = __m256i;
+
+        inline Vec loadVec(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p)); }
+        inline void storeVec(int* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(p), v); }
+        inline Vec splat(int a) { return _mm256_set1_epi32(a); }
+        inline Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+        inline Vec sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+        inline Vec cmpgt(Vec a, Vec b) { return _mm256_cmpgt_epi32(a, b); }
+        inline Vec cmpeq(Vec a, Vec b) { return _mm256_cmpeq_epi32(a, b); }
+        inline Vec bitAnd(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+        inline Vec bitAndNot(Vec a, Vec b) { return _mm256_andnot_si256(a, b); }
+        inline Vec bitOr(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+        inline std::uint64_t bits(Vec m) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+#elif defined(TASKTABLE_SSE2)
+        using Vec = __m128i;
+
+        inline Vec loadVec(const int* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+        inline void storeVec(int* p, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(p), v); }
+        inline Vec splat(int a) { return _mm_set1_epi32(a); }
+        inline Vec add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+        inline Vec sub(Vec a, Vec b) { return _mm_sub_epi32(a, b); }
+        inline Vec cmpgt(Vec a, Vec b) { return _mm_cmpgt_epi32(a, b); }
+        inline Vec cmpeq(Vec a, Vec b) { return _mm_cmpeq_epi32(a, b); }
+        inline Vec bitAnd(Vec a, Vec b) { return _mm_and_si128(a, b); }
+        inline Vec bitAndNot(Vec a, Vec b) { return _mm_andnot_si128(a, b); }
+        inline Vec bitOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+        inline std::uint64_t bits(Vec m) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(m))); }
+#endif
+
+#if defined(TASKTABLE_AVX2) || defined(TASKTABLE_SSE2)
+        //! Funkcja wybiera a tam gdzie maska jest ustawiona, w przeciwnym razie b
+        inline Vec select(Vec mask, Vec a, Vec b) { return bitOr(bitAnd(mask, a), bitAndNot(mask, b)); }
+#endif
+    }
+
+    void TaskTable::load(const std::vector<Task>& tasks, bool periodic)
+    {
+        std::size_t n = tasks.size();
+
+        for (std::vector<int>* v : {&period, &time, &deadline, &prioryty, &cycles, &timeToDeadline, &timeToEnd})
+            v->resize(n);
+
+        // klucze kolejności należą do bieżącej symulacji, nadaje je polityka przy zwolnieniu
+        order.assign(n, 0);
+        sliceEnd.assign(n, 0);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Task &t = tasks[i];
+            period[i] = t.period;
+            time[i] = t.time;
+            deadline[i] = t.deadline;
+            prioryty[i] = t.prioryty;
+            cycles[i] = t.cycles;
+            timeToDeadline[i] = t.timeToDeadline;
+            timeToEnd[i] = t.timeToEnd;
+        }
+
+        // zatrzymany licznik okresu nigdy nie dochodzi do zera, a instancje czekają na release()
+        mPeriodStep = periodic ? 1 : 0;
+        if (!periodic)
+        {
+            std::fill(timeToEnd.begin(), timeToEnd.end(), std::numeric_limits<int>::max() - 1);
+            std::fill(timeToDeadline.begin(), timeToDeadline.end(), 0);
+            cycles = time;
+        }
+    }
+
+    void TaskTable::store(std::vector<Task>& tasks) const
+    {
+        for (std::size_t i = 0; i < tasks.size() && i < size(); ++i)
+        {
+            Task &t = tasks[i];
+            t.cycles = cycles[i];
+            t.timeToDeadline = timeToDeadline[i];
+            t.timeToEnd = timeToEnd[i];
+        }
+    }
+
+    void TaskTable::saveState(std::vector<int>& state) const
+    {
+        state.clear();
+        state.insert(state.end(), cycles.begin(), cycles.end());
+        state.insert(state.end(), timeToDeadline.begin(), timeToDeadline.end());
+        state.insert(state.end(), timeToEnd.begin(), timeToEnd.end());
+    }
+
+    bool TaskTable::sameState(const std::vector<int>& state) const
+    {
+        std::size_t n = size();
+        return state.size() == 3 * n
+            && std::equal(cycles.begin(), cycles.end(), state.begin())
+            && std::equal(timeToDeadline.begin(), timeToDeadline.end(), state.begin() + n)
+            && std::equal(timeToEnd.begin(), timeToEnd.end(), state.begin() + 2 * n);
+    }
+
+    bool TaskTable::tick(TaskMask& misses, TaskMask& releases)
+    {
+        std::size_t n = size();
+        misses.assign((n + 63) / 64, 0);
+        releases.assign((n + 63) / 64, 0);
+
+        std::uint64_t any = 0;
+        std::size_t i = 0;
+
+#if defined(TASKTABLE_AVX2) || defined(TASKTABLE_SSE2)
+        const Vec zero = splat(0);
+        const Vec one = splat(1);
+        const Vec periodStep = splat(mPeriodStep);
+
+        for (; i + lanes <= n; i += lanes)
+        {
+            Vec ttd = loadVec(&timeToDeadline[i]);
+            Vec tte = loadVec(&timeToEnd[i]);
+            Vec cyc = loadVec(&cycles[i]);
+            Vec tim = loadVec(&time[i]);
+
+            // termin jeszcze nie minął: odliczamy, w przeciwnym razie niezakończone zadanie przekroczyło termin
+            Vec ttdPositive = cmpgt(ttd, zero);
+            Vec miss = bitAndNot(ttdPositive, bitAndNot(cmpeq(cyc, tim), splat(-1)));
+            ttd = add(ttd, ttdPositive);
+            cyc = select(miss, tim, cyc);
+
+            // okres się zakończył: resetujemy dane zadania
+            Vec release = bitAndNot(cmpgt(tte, zero), splat(-1));
+            tte = select(release, sub(loadVec(&period[i]), one), sub(tte, periodStep));
+            ttd = select(release, sub(loadVec(&deadline[i]), one), ttd);
+            cyc = bitAndNot(release, cyc);
+
+            storeVec(&timeToDeadline[i], ttd);
+            storeVec(&timeToEnd[i], tte);
+            storeVec(&cycles[i], cyc);
+
+            std::uint64_t missBits = bits(miss);
+            any |= missBits;
+            misses[i / 64] |= missBits << (i % 64);
+            releases[i / 64] |= bits(release) << (i % 64);
+        }
+#endif
+
+        // pozostałe zadania, lub wszystkie gdy brak instrukcji wektorowych
+        for (; i < n; ++i)
+        {
+            int ttd = timeToDeadline[i];
+            int tte = timeToEnd[i];
+            int cyc = cycles[i];
+
+            bool ttdPositive = ttd > 0;
+            bool miss = !ttdPositive && cyc != time[i];
+            ttd -= ttdPositive;
+            cyc = miss ? time[i] : cyc;
+
+            bool release = tte <= 0;
+            tte = release ? period[i] - 1 : tte - mPeriodStep;
+            ttd = release ? deadline[i] - 1 : ttd;
+            cyc = release ? 0 : cyc;
+
+            timeToDeadline[i] = ttd;
+            timeToEnd[i] = tte;
+            cycles[i] = cyc;
+
+            any |= miss;
+            misses[i / 64] |= static_cast<std::uint64_t>(miss) << (i % 64);
+            releases[i / 64] |= static_cast<std::uint64_t>(release) << (i % 64);
+        }
+
+        return any != 0;
+    }
+
+    void TaskTable::skip(int length)
+    {
+        std::size_t n = size();
+        std::size_t i = 0;
+
+#if defined(TASKTABLE_AVX2) || defined(TASKTABLE_SSE2)
+        const Vec step = splat(length);
+        const Vec periodStep = splat(length * mPeriodStep);
+
+        for (; i + lanes <= n; i += lanes)
+        {
+            // termin nie schodzi poniżej zera: max(ttd - length, 0)
+            Vec ttd = loadVec(&timeToDeadline[i]);
+            storeVec(&timeToDeadline[i], bitAnd(cmpgt(ttd, step), sub(ttd, step)));
+            storeVec(&timeToEnd[i], sub(loadVec(&timeToEnd[i]), periodStep));
+        }
+#endif
+
+        for (; i < n; ++i)
+        {
+            int ttd = timeToDeadline[i];
+            timeToDeadline[i] = ttd > length ? ttd - length : 0;
+            timeToEnd[i] -= length * mPeriodStep;
+        }
+    }
+
+    int TaskTable::nextEvent() const
+    {
+        std::size_t n = size();
+        std::size_t i = 0;
+        int distance = std::numeric_limits<int>::max();
+
+#if defined(TASKTABLE_AVX2) || defined(TASKTABLE_SSE2)
+        const Vec none = splat(std::numeric_limits<int>::max());
+        Vec best = none;
+
+        for (; i + lanes <= n; i += lanes)
+        {
+            // zwolnienie kolejnego zadania
+            Vec tte = loadVec(&timeToEnd[i]);
+            best = select(cmpgt(best, tte), tte, best);
+
+            // termin niezakończonego zadania
+            Vec pending = cmpgt(loadVec(&time[i]), loadVec(&cycles[i]));
+            Vec ttd = select(pending, loadVec(&timeToDeadline[i]), none);
+            best = select(cmpgt(best, ttd), ttd, best);
+        }
+
+        alignas(32) int lane[lanes];
+        storeVec(lane, best);
+        for (std::size_t j = 0; j < lanes; ++j)
+            distance = lane[j] < distance ? lane[j] : distance;
+#endif
+
+        for (; i < n; ++i)
+        {
+            int ttd = cycles[i] < time[i] ? timeToDeadline[i] : std::numeric_limits<int>::max();
+            int tte = timeToEnd[i];
+            distance = tte < distance ? tte : distance;
+            distance = ttd < distance ? ttd : distance;
+        }
+
+        return distance == std::numeric_limits<int>::max() ? distance : distance + 1;
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "task.h"
+
+namespace alg
+{
+    //! Maska bitowa zadań, bit i odpowiada zadaniu o id i
+    using TaskMask = std::vector<std::uint64_t>;
+
+    //! Funkcja zwraca numer najmłodszego ustawionego bitu
+    inline int lowestBit(std::uint64_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    //! Tablica zadań
+    /*!
+    Przechowuje zadania jako struktura tablic (każde pole w osobnej, ciągłej tablicy),
+    dzięki czemu odliczanie terminów, wykrywanie przekroczeń i zwalnianie zadań
+    wykonywane jest bez rozgałęzień, kilkoma przebiegami wektorowymi (AVX2, SSE2
+    lub zwykła pętla, w zależności od flag kompilacji).
+
+    Gdy zadania zwalniane są ze strumienia zwolnień (load() z periodic równym false),
+    liczniki okresów są zatrzymane, a instancje rozpoczyna metoda release().
+    */
+    class TaskTable
+    {
+    public:
+        //! Metoda kopiuje zadania do tablicy
+        /*!
+        \param tasks zadania
+        \param periodic czy zwalniać zadania co okres; gdy false żadne zadanie nie ma
+        rozpoczętej instancji, a kolejne rozpoczyna release()
+        */
+        void load(const std::vector<Task>& tasks, bool periodic = true);
+
+        //! Metoda zapisuje stan zadań z powrotem do tablicy struktur
+        void store(std::vector<Task>& tasks) const;
+
+        //! Funkcja zwraca ilość zadań
+        std::size_t size() const { return period.size(); }
+
+        //! Funkcja zwraca zadanie o podanym id złożone z kolejnych tablic
+        Task row(int id) const
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            Task t(id, period[i], time[i], deadline[i], prioryty[i]);
+            t.cycles = cycles[i];
+            t.timeToDeadline = timeToDeadline[i];
+            t.timeToEnd = timeToEnd[i];
+            t.order = order[i];
+            t.sliceEnd = sliceEnd[i];
+            return t;
+        }
+
+        //! Funkcja sprawdza czy zadanie ma jeszcze cykle do wykonania
+        bool isSchedulable(int id) const
+        {
+            return cycles[static_cast<std::size_t>(id)] < time[static_cast<std::size_t>(id)];
+        }
+
+        //! Metoda rozpoczyna nową instancję zadania
+        /*!
+        Działa tak jak zwolnienie co okres w tick(), więc termin instancji zwolnionej
+        w bieżącym cyklu mija po deadline cyklach.
+        \return true jeżeli poprzednia instancja nie zakończyła się ani nie przekroczyła terminu
+        i została porzucona
+        */
+        bool release(int id)
+        {
+            std::size_t i = static_cast<std::size_t>(id);
+            bool pending = cycles[i] < time[i];
+            cycles[i] = 0;
+            timeToDeadline[i] = deadline[i] - 1;
+            return pending;
+        }
+
+        //! Metoda symuluje jeden cykl dla wszystkich zadań
+        /*!
+        Zmniejsza liczniki, oznacza zadania które przekroczyły termin i zwalnia zadania
+        których okres się zakończył.
+        \param misses maska zadań które przekroczyły termin
+        \param releases maska zadań zwolnionych w tym cyklu
+        \return true jeżeli któreś zadanie przekroczyło termin
+        */
+        bool tick(TaskMask& misses, TaskMask& releases);
+
+        //! Metoda przesuwa liczniki wszystkich zadań o podaną liczbę cykli bez zdarzeń
+        void skip(int length);
+
+        //! Funkcja zwraca liczbę cykli do najbliższego zwolnienia lub terminu niezakończonego zadania
+        int nextEvent() const;
+
+        //! Metoda zapisuje stan zadań (cykle, czas do terminu i do końca okresu)
+        /*!
+        Klucze kolejności i kwanty nie należą do stanu, dlatego polityki, których kolejność
+        od nich zależy (Policy::repeatable równe false), wyłączają pomijanie hiperokresów.
+        */
+        void saveState(std::vector<int>& state) const;
+
+        //! Funkcja sprawdza czy stan zadań jest taki sam jak zapisany przez saveState()
+        bool sameState(const std::vector<int>& state) const;
+
+        std::vector<int> period;   //!< okresy
+        std::vector<int> time;     //!< czasy wykonania zadań
+        std::vector<int> deadline; //!< terminy
+        std::vector<int> prioryty; //!< priorytety
+
+        std::vector<int> cycles;         //!< liczby cykli trwania zadań
+        std::vector<int> timeToDeadline; //!< cykle pozostałe do nstępnego terminu
+        std::vector<int> timeToEnd;      //!< cykle pozostałe do zakończenia zadania
+
+        std::vector<std::uint64_t> order; //!< klucze kolejności instancji, zmieniane przez zdarzenia polityki
+        std::vector<int> sliceEnd;        //!< cykle instancji, w których kończą się kwanty czasu
+
+    private:
+        int mPeriodStep {1}; //!< ubytek licznika okresu w cyklu, 0 gdy liczniki są zatrzymane
+    };
+}
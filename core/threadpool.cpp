@@ -0,0 +1,141 @@
+#include "threadpool.h"
+
+#include <algorithm>
+
+namespace alg
+{
+    ThreadPool::ThreadPool(std::size_t threads)
+    {
+        if (threads == 0)
+            threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+        mRanges.reset(new Range[threads]);
+
+        // wątek wywołujący run() jest wątkiem 0, uruchamiamy pozostałe
+        mThreads.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i)
+            mThreads.emplace_back(&ThreadPool::loop, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mStop = true;
+        }
+        mStart.notify_all();
+
+        for (std::thread &thread : mThreads)
+            thread.join();
+    }
+
+    void ThreadPool::run(std::size_t count, const Job& job)
+    {
+        if (count == 0)
+            return;
+
+        // dzielimy zadania na ciągłe zakresy o podobnej długości
+        std::size_t threads = size();
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            std::lock_guard<std::mutex> guard(mRanges[i].lock);
+            mRanges[i].begin = count * i / threads;
+            mRanges[i].end = count * (i + 1) / threads;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mJob = &job;
+            mActive = mThreads.size();
+            ++mGeneration;
+        }
+        mStart.notify_all();
+
+        work(0);
+
+        // czekamy aż pozostałe wątki skończą swoje ostatnie zadania
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this] { return mActive == 0; });
+        mJob = nullptr;
+    }
+
+    bool ThreadPool::take(std::size_t worker, std::size_t& index)
+    {
+        Range &range = mRanges[worker];
+        std::lock_guard<std::mutex> guard(range.lock);
+
+        if (range.begin == range.end)
+            return false;
+
+        index = range.begin++;
+        return true;
+    }
+
+    bool ThreadPool::steal(std::size_t worker, std::size_t& index)
+    {
+        std::size_t threads = size();
+
+        // przeglądamy pozostałe wątki zaczynając od sąsiada, by złodzieje nie trafiali w ten sam zakres
+        for (std::size_t k = 1; k < threads; ++k)
+        {
+            Range &victim = mRanges[(worker + k) % threads];
+            std::size_t begin;
+            std::size_t end;
+
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                std::size_t left = victim.end - victim.begin;
+                if (left == 0)
+                    continue;
+
+                // zabieramy tylną połowę zakresu, ofiara dalej pracuje na przedniej
+                end = victim.end;
+                begin = victim.end - (left + 1) / 2;
+                victim.end = begin;
+            }
+
+            // pierwsze zadanie wykonujemy od razu, resztę odkładamy do własnego zakresu
+            Range &own = mRanges[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            own.begin = begin + 1;
+            own.end = end;
+            index = begin;
+            return true;
+        }
+
+        return false;
+    }
+
+    void ThreadPool::work(std::size_t worker)
+    {
+        const Job &job = *mJob;
+        std::size_t index;
+
+        while (take(worker, index) || steal(worker, index))
+            job(worker, index);
+    }
+
+    void ThreadPool::loop(std::size_t worker)
+    {
+        std::size_t generation = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mStart.wait(lock, [&] { return mStop || mGeneration != generation; });
+                if (mStop)
+                    return;
+                generation = mGeneration;
+            }
+
+            work(worker);
+
+            {
+                std::lock_guard<std::mutex> guard(mMutex);
+                --mActive;
+            }
+            mDone.notify_one();
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace alg
+{
+    //! Pula wątków z podkradaniem pracy
+    /*!
+    Każdy wątek dostaje na początku ciągły zakres numerów zadań do wykonania.
+    Wątek, który skończył swój zakres, podkrada połowę zakresu innego wątku,
+    dzięki czemu zadania o różnym czasie trwania rozkładają się równomiernie.
+
+    Wątek wywołujący run() pracuje jako wątek o numerze 0.
+    */
+    class ThreadPool
+    {
+    public:
+        //! Zadanie wykonywane w puli
+        /*!
+        \param worker numer wątku (od 0 do size() - 1)
+        \param index numer zadania
+        */
+        using Job = std::function<void(std::size_t worker, std::size_t index)>;
+
+        //! Konstruktor
+        /*!
+        \param threads liczba wątków, 0 oznacza liczbę rdzeni procesora
+        */
+        explicit ThreadPool(std::size_t threads = 0);
+
+        //! Destruktor, czeka na zakończenie wątków
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        //! Funkcja zwraca liczbę wątków razem z wątkiem wywołującym
+        std::size_t size() const { return mThreads.size() + 1; }
+
+        //! Metoda wykonuje zadania o numerach od 0 do count - 1 i czeka na ich zakończenie
+        void run(std::size_t count, const Job& job);
+
+    private:
+        //! Zakres zadań wątku
+        struct Range
+        {
+            std::mutex lock;            //!< blokada zakresu
+            std::size_t begin {0};      //!< pierwsze niewykonane zadanie
+            std::size_t end   {0};      //!< koniec zakresu
+            char padding[64];           //!< oddziela zakresy różnych wątków w pamięci podręcznej
+        };
+
+        //! Funkcja pobiera kolejne zadanie z własnego zakresu wątku
+        bool take(std::size_t worker, std::size_t& index);
+        //! Funkcja podkrada połowę zakresu innego wątku i pobiera z niej zadanie
+        bool steal(std::size_t worker, std::size_t& index);
+        //! Metoda wykonuje zadania do wyczerpania wszystkich zakresów
+        void work(std::size_t worker);
+        //! Pętla wątku puli
+        void loop(std::size_t worker);
+
+        std::vector<std::thread> mThreads;  //!< wątki puli
+        std::unique_ptr<Range[]> mRanges;   //!< zakresy zadań kolejnych wątków
+
+        std::mutex mMutex;                  //!< blokada stanu puli
+        std::condition_variable mStart;     //!< sygnał rozpoczęcia pracy
+        std::condition_variable mDone;      //!< sygnał zakończenia pracy
+        const Job* mJob          {nullptr}; //!< wykonywane zadanie
+        std::size_t mGeneration  {0};       //!< numer wywołania run()
+        std::size_t mActive      {0};       //!< liczba pracujących wątków puli
+        bool mStop               {false};   //!< flaga zakończenia wątków
+    };
+}
@@ -0,0 +1,141 @@
+#include "timerwheel.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "tasktable.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace alg
+{
+    namespace
+    {
+        //! Funkcja zwraca numer najstarszego ustawionego bitu
+        inline int highestBit(uint word)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse(&index, word);
+            return static_cast<int>(index);
+#else
+            return 31 - __builtin_clz(word);
+#endif
+        }
+    }
+
+    const int TimerWheel::slotBits;
+    const uint TimerWheel::slotCount;
+    const int TimerWheel::levels;
+
+    TimerWheel::TimerWheel()
+        : mSlots(static_cast<std::size_t>(levels) * slotCount)
+    {
+        std::fill(mOccupied, mOccupied + levels, 0);
+    }
+
+    void TimerWheel::reset(uint now)
+    {
+        for (int level = 0; level < levels; ++level)
+        {
+            // czyścimy tylko niepuste przegródki, pamięć zostaje do kolejnej symulacji
+            std::uint64_t occupied = mOccupied[level];
+            while (occupied)
+            {
+                mSlots[static_cast<std::size_t>(level) * slotCount + static_cast<std::size_t>(lowestBit(occupied))].clear();
+                occupied &= occupied - 1;
+            }
+            mOccupied[level] = 0;
+        }
+
+        mNow = now;
+        mSize = 0;
+    }
+
+    void TimerWheel::insert(uint time, int id)
+    {
+        Entry entry;
+        entry.time = std::max(time, mNow);
+        entry.id = id;
+        place(entry);
+        ++mSize;
+    }
+
+    void TimerWheel::place(const Entry& entry)
+    {
+        // poziom najstarszej grupy bitów różniącej chwilę zdarzenia od bieżącej
+        uint diff = entry.time ^ mNow;
+        int level = diff < slotCount ? 0 : highestBit(diff) / slotBits;
+        uint slot = (entry.time >> (level * slotBits)) & (slotCount - 1);
+
+        mSlots[static_cast<std::size_t>(level) * slotCount + slot].push_back(entry);
+        mOccupied[level] |= std::uint64_t(1) << slot;
+    }
+
+    uint TimerWheel::nextTime() const
+    {
+        // zdarzenia niższego poziomu poprzedzają wszystkie zdarzenia wyższych poziomów
+        for (int level = 0; level < levels; ++level)
+        {
+            if (!mOccupied[level])
+                continue;
+
+            std::uint64_t slot = static_cast<std::uint64_t>(lowestBit(mOccupied[level]));
+            int shift = (level + 1) * slotBits;
+            std::uint64_t base = shift < 32 ? (static_cast<std::uint64_t>(mNow) >> shift) << shift : 0;
+            return static_cast<uint>(base | (slot << (level * slotBits)));
+        }
+
+        return std::numeric_limits<uint>::max();
+    }
+
+    void TimerWheel::advance(uint time, std::vector<int>& due)
+    {
+        // zdarzenia wcześniejsze niż nowa chwila zwracamy po kolei, chwila po chwili
+        while (mSize > 0)
+        {
+            uint next = nextTime();
+            if (next >= time)
+                break;
+            step(next, due);
+        }
+
+        step(std::max(time, mNow), due);
+    }
+
+    void TimerWheel::step(uint time, std::vector<int>& due)
+    {
+        mNow = time;
+
+        // przegródki wyższych poziomów, do których weszła bieżąca chwila, rozkładamy względem niej
+        for (int level = levels - 1; level > 0; --level)
+        {
+            uint slot = (time >> (level * slotBits)) & (slotCount - 1);
+            if (!((mOccupied[level] >> slot) & 1))
+                continue;
+
+            mCascade.swap(mSlots[static_cast<std::size_t>(level) * slotCount + slot]);
+            mOccupied[level] &= ~(std::uint64_t(1) << slot);
+            for (const Entry &entry : mCascade)
+                place(entry);
+            mCascade.clear();
+        }
+
+        // na najniższym poziomie przegródka bieżącej chwili zawiera tylko zdarzenia z tej chwili
+        uint slot = time & (slotCount - 1);
+        if (!((mOccupied[0] >> slot) & 1))
+            return;
+
+        std::vector<Entry> &entries = mSlots[slot];
+        std::size_t first = due.size();
+        for (const Entry &entry : entries)
+            due.push_back(entry.id);
+        std::sort(due.begin() + static_cast<std::ptrdiff_t>(first), due.end());
+
+        mSize -= entries.size();
+        entries.clear();
+        mOccupied[0] &= ~(std::uint64_t(1) << slot);
+    }
+}
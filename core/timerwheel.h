@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Hierarchiczne koło czasowe
+    /*!
+    Przechowuje przyszłe zdarzenia (chwila, id) w levels poziomach po slotCount przegródek.
+    Zdarzenie trafia na poziom odpowiadający najstarszej grupie 6 bitów, którą jego chwila
+    różni się od bieżącej chwili, więc wstawienie kosztuje O(1). Przy przesuwaniu czasu
+    przegródka, do której wchodzi bieżąca chwila, rozkładana jest na niższe poziomy,
+    a każde zdarzenie przenoszone jest co najwyżej levels razy.
+
+    Niepuste przegródki zaznaczone są w maskach bitowych, więc najbliższe zdarzenie
+    wyszukiwane jest kilkoma instrukcjami, bez przeglądania przegródek.
+    */
+    class TimerWheel
+    {
+    public:
+        //! Liczba bitów czasu przypadających na poziom
+        static const int slotBits = 6;
+        //! Liczba przegródek poziomu
+        static const uint slotCount = 1u << slotBits;
+        //! Liczba poziomów, obejmują cały zakres typu uint
+        static const int levels = 6;
+
+        //! Konstruktor
+        TimerWheel();
+
+        //! Metoda usuwa wszystkie zdarzenia i ustawia bieżącą chwilę
+        void reset(uint now = 0);
+
+        //! Metoda dodaje zdarzenie
+        /*!
+        \param time chwila zdarzenia, nie wcześniejsza niż bieżąca chwila
+        \param id identyfikator zdarzenia, np. id zadania
+        */
+        void insert(uint time, int id);
+
+        //! Funkcja zwraca czy koło jest puste
+        bool empty() const { return mSize == 0; }
+
+        //! Funkcja zwraca liczbę zdarzeń
+        std::size_t size() const { return mSize; }
+
+        //! Funkcja zwraca bieżącą chwilę
+        uint now() const { return mNow; }
+
+        //! Funkcja zwraca chwilę, przed którą nie ma żadnego zdarzenia
+        /*!
+        Dla najbliższego zdarzenia na najniższym poziomie jest to dokładnie jego chwila,
+        a na wyższych poziomach początek jego przegródki.
+        \return chwila lub największa wartość typu uint gdy koło jest puste
+        */
+        uint nextTime() const;
+
+        //! Metoda przesuwa bieżącą chwilę i zwraca zdarzenia, które nastąpiły
+        /*!
+        \param time nowa bieżąca chwila, nie wcześniejsza niż obecna
+        \param due tablica, do której dopisywane są id zdarzeń nie późniejszych niż time,
+        w kolejności chwil, a w tej samej chwili w kolejności id
+        */
+        void advance(uint time, std::vector<int>& due);
+
+    private:
+        //! Zdarzenie
+        struct Entry
+        {
+            uint time; //!< chwila zdarzenia
+            int id;    //!< identyfikator zdarzenia
+        };
+
+        //! Metoda umieszcza zdarzenie w przegródce wyznaczonej względem bieżącej chwili
+        void place(const Entry& entry);
+
+        //! Metoda ustawia bieżącą chwilę, nie późniejszą niż najbliższe zdarzenie
+        /*!
+        Rozkłada przegródki, do których wchodzi nowa chwila, i zwraca zdarzenia z tej chwili.
+        */
+        void step(uint time, std::vector<int>& due);
+
+        std::vector<std::vector<Entry>> mSlots; //!< przegródki kolejnych poziomów
+        std::uint64_t mOccupied[levels];        //!< maski niepustych przegródek poziomów
+        std::vector<Entry> mCascade;            //!< bufor rozkładanej przegródki
+        uint mNow {0};                          //!< bieżąca chwila
+        std::size_t mSize {0};                  //!< liczba zdarzeń
+    };
+}
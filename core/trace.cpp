@@ -0,0 +1,142 @@
+#include "trace.h"
+
+namespace alg
+{
+    const std::size_t TraceRecorder::batchSize;
+    const std::size_t TraceRecorder::windowSize;
+
+    void TraceRecorder::begin(TraceSink* sink, uint cores)
+    {
+        mSink = sink && sink->enabled() ? sink : nullptr;
+        mOpen.assign(std::max(cores, 1u), Segment());
+        for (std::size_t core = 0; core < mOpen.size(); ++core)
+            mOpen[core].core = static_cast<std::uint16_t>(core);
+        mHeld.clear();
+        mBlocked.clear();
+        mBatch.clear();
+        mWindow.clear();
+        mWindowValid = false;
+        if (mSink)
+            mBatch.reserve(batchSize);
+    }
+
+    void TraceRecorder::end()
+    {
+        if (!mSink)
+            return;
+
+        closeRuns();
+        flush();
+        mSink = nullptr;
+        mWindowValid = false;
+    }
+
+    void TraceRecorder::boundary(uint time)
+    {
+        if (!mSink)
+            return;
+
+        // odcinek trwający przez granicę dzielimy, by cały należał do jednego okresu
+        closeRuns();
+        flush();
+        mSink->boundary(time);
+
+        mWindow.clear();
+        mWindowValid = true;
+    }
+
+    bool TraceRecorder::repeat(uint period, uint count)
+    {
+        if (!mSink)
+            return true;
+
+        closeRuns();
+        flush();
+
+        if (mSink->repeat(period, count))
+        {
+            mWindowValid = false;
+            return true;
+        }
+
+        if (!mWindowValid)
+            return false;
+
+        // powtarzane odcinki nie trafiają już do zapamiętanego fragmentu
+        mWindowValid = false;
+        for (uint k = 1; k <= count; ++k)
+        {
+            for (Segment s : mWindow)
+            {
+                s.start += k * period;
+                push(s);
+            }
+        }
+
+        return true;
+    }
+
+    void TraceRecorder::progress(uint time)
+    {
+        if (!mSink)
+            return;
+
+        closeRuns();
+        flush();
+        mSink->progress(time);
+    }
+
+    void TraceRecorder::closeRuns()
+    {
+        for (uint core = 0; core < mOpen.size(); ++core)
+            closeRun(core);
+
+        // bez otwartych odcinków wszystkie czekające odcinki mogą zostać przekazane
+        while (!mHeld.empty())
+        {
+            std::pop_heap(mHeld.begin(), mHeld.end(), later);
+            push(mHeld.back());
+            mHeld.pop_back();
+        }
+    }
+
+    void TraceRecorder::hold(const Segment& s)
+    {
+        mHeld.push_back(s);
+        std::push_heap(mHeld.begin(), mHeld.end(), later);
+
+        for (;;)
+        {
+            // kolejne odcinki nie zaczną się przed najwcześniejszym otwartym odcinkiem
+            Segment *first = nullptr;
+            for (Segment &open : mOpen)
+            {
+                if (open.length > 0 && (!first || open.start < first->start))
+                    first = &open;
+            }
+
+            while (!mHeld.empty() && (!first || mHeld.front().start <= first->start))
+            {
+                std::pop_heap(mHeld.begin(), mHeld.end(), later);
+                push(mHeld.back());
+                mHeld.pop_back();
+            }
+
+            if (!first || mHeld.size() < batchSize)
+                return;
+
+            // zbyt wiele odcinków czeka na długie wykonanie, więc je dzielimy,
+            // a kolejny cykl tego zadania otworzy nowy odcinek
+            mHeld.push_back(*first);
+            std::push_heap(mHeld.begin(), mHeld.end(), later);
+            first->length = 0;
+        }
+    }
+
+    void TraceRecorder::flush()
+    {
+        if (!mBatch.empty())
+            mSink->consume(mBatch.data(), mBatch.size());
+        mBatch.clear();
+    }
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "task.h"
+
+namespace alg
+{
+    //! Rodzaj odcinka przebiegu symulacji
+    enum class SegmentKind : unsigned char
+    {
+        TASK,   //!< Wykonanie zadania
+        MISS,   //!< Przekroczenie terminu
+        RELEASE, //!< Zwolnienie instancji zadania ze strumienia zwolnień
+        BLOCKED, //!< Blokowanie zadania przez zadanie o niższym priorytecie zajmujące zasób
+        SWITCH   //!< Przełączenie kontekstu na zadanie, procesor nie wykonuje wtedy żadnego zadania
+    };
+
+    //! Funkcja sprawdza czy odcinek danego rodzaju ma długość, pozostałe zajmują jedną chwilę
+    inline bool hasLength(SegmentKind kind)
+    {
+        return kind == SegmentKind::TASK || kind == SegmentKind::BLOCKED || kind == SegmentKind::SWITCH;
+    }
+
+    //! Odcinek przebiegu symulacji
+    /*!
+    Kolejne cykle wykonania tego samego zadania na tym samym procesorze łączone są w jeden odcinek.
+    Przekroczenie terminu zapisywane jest jako odcinek o długości 1 w chwili terminu.
+    Gdy zadania zwalniane są ze strumienia zwolnień, każde zwolnienie zapisywane jest jako odcinek
+    RELEASE o długości 1 w chwili zwolnienia. Przy zwolnieniach co okres odcinków RELEASE nie ma.
+    Odcinek BLOCKED obejmuje cykle, w których gotowe zadanie czekało na zadanie o niższym
+    priorytecie bazowym, zajmujące zasób lub wykonujące się z podwyższonym priorytetem.
+    Odcinek SWITCH obejmuje cykle przełączania kontekstu na zadanie (PolicyOptions::switchCost)
+    i poprzedza jego odcinek wykonania na tym samym procesorze.
+    */
+    struct Segment
+    {
+        int task       {-1};  //!< id zadania
+        uint start     {0};   //!< chwila rozpoczęcia
+        uint length    {0};   //!< liczba cykli
+        SegmentKind kind {SegmentKind::TASK}; //!< rodzaj odcinka
+        std::uint16_t core {0}; //!< numer procesora, zajmuje wyrównanie struktury
+    };
+
+    //! Odbiorca przebiegu symulacji
+    /*!
+    Otrzymuje odcinki w paczkach, w kolejności czasu rozpoczęcia.
+    Odcinki rozpoczynające się w tej samej chwili na różnych procesorach mogą mieć dowolną kolejność.
+    */
+    class TraceSink
+    {
+    public:
+        //! Destruktor
+        virtual ~TraceSink() = default;
+
+        //! Metoda przyjmuje paczkę odcinków
+        virtual void consume(const Segment* segments, std::size_t count) = 0;
+
+        //! Funkcja zwraca czy odbiorca potrzebuje odcinków
+        /*!
+        Gdy zwraca false silnik w ogóle nie zapisuje przebiegu.
+        */
+        virtual bool enabled() const { return true; }
+
+        //! Metoda zgłasza granicę okresu, od której silnik sprawdza powtarzanie się stanu
+        /*!
+        Wszystkie odcinki sprzed tej chwili zostały już przekazane odbiorcy.
+        */
+        virtual void boundary(uint time) { (void)time; }
+
+        //! Metoda zgłasza, że przebieg od ostatniej granicy powtórzy się jeszcze count razy
+        /*!
+        Odbiorca może rozliczyć powtórzenia samodzielnie, bez otrzymywania odcinków.
+        \param period długość powtarzanego fragmentu
+        \param count liczba powtórzeń
+        \return true jeżeli odbiorca rozliczył powtórzenia, false gdy silnik ma przekazać powtórzone odcinki
+        */
+        virtual bool repeat(uint period, uint count) { (void)period; (void)count; return false; }
+
+        //! Metoda zgłasza postęp symulacji
+        /*!
+        Wywoływana na granicach fragmentów symulacji, gdy silnik ma ustawiony rozmiar fragmentu.
+        Wszystkie odcinki sprzed tej chwili zostały już przekazane odbiorcy.
+        */
+        virtual void progress(uint time) { (void)time; }
+    };
+
+    //! Odbiorca pomijający przebieg, do symulacji zbierających tylko statystyki
+    class NullTraceSink : public TraceSink
+    {
+    public:
+        void consume(const Segment*, std::size_t) override {}
+        bool enabled() const override { return false; }
+    };
+
+    //! Bufor przebiegu
+    /*!
+    Łączy kolejne cykle tego samego zadania w odcinki i przekazuje je odbiorcy
+    w paczkach po batchSize odcinków.
+
+    Przy wielu procesorach każdy procesor ma własny otwarty odcinek. Zamknięte odcinki
+    czekają w kopcu, aż żaden otwarty odcinek nie zaczyna się wcześniej, dzięki czemu
+    odbiorca nadal dostaje je w kolejności czasu rozpoczęcia. Gdy czeka ich batchSize,
+    najwcześniejszy otwarty odcinek jest dzielony, więc pamięć bufora jest ograniczona.
+    */
+    class TraceRecorder
+    {
+    public:
+        //! Rozmiar paczki odcinków
+        static const std::size_t batchSize = 4096;
+
+        //! Metoda rozpoczyna zapis przebiegu do odbiorcy
+        /*!
+        \param sink odbiorca lub nullptr gdy przebieg nie jest potrzebny
+        \param cores liczba procesorów
+        */
+        void begin(TraceSink* sink, uint cores = 1);
+
+        //! Metoda kończy zapis i przekazuje odbiorcy pozostałe odcinki
+        void end();
+
+        //! Funkcja zwraca czy przebieg jest zapisywany
+        bool active() const { return mSink != nullptr; }
+
+        //! Maksymalna liczba odcinków zapamiętywanych od ostatniej granicy
+        static const std::size_t windowSize = 1 << 18;
+
+        //! Metoda zaznacza granicę okresu i zaczyna zapamiętywać kolejne odcinki
+        void boundary(uint time);
+
+        //! Metoda powtarza przebieg od ostatniej granicy
+        /*!
+        Gdy odbiorca nie rozlicza powtórzeń sam, przekazuje mu zapamiętane odcinki
+        przesunięte o kolejne wielokrotności okresu.
+        \param period długość powtarzanego fragmentu
+        \param count liczba powtórzeń
+        \return false gdy fragment był zbyt długi by go zapamiętać, przebieg nie jest wtedy zmieniany
+        */
+        bool repeat(uint period, uint count);
+
+        //! Metoda przekazuje odbiorcy zebrane odcinki i postęp symulacji
+        /*!
+        Otwarte odcinki są zamykane, więc wykonanie trwające przez tę chwilę
+        zostanie przekazane jako dwa przylegające odcinki.
+        */
+        void progress(uint time);
+
+        //! Metoda dodaje wykonanie zadania, łącząc je z poprzednim odcinkiem tego zadania na tym procesorze
+        void run(int task, uint start, uint length, uint core = 0)
+        {
+            extend(SegmentKind::TASK, task, start, length, core);
+        }
+
+        //! Metoda dodaje przełączanie kontekstu na zadanie, łącząc je z poprzednim przełączaniem na tym procesorze
+        void contextSwitch(int task, uint start, uint length, uint core = 0)
+        {
+            extend(SegmentKind::SWITCH, task, start, length, core);
+        }
+
+        //! Metoda dodaje przekroczenie terminu
+        void miss(int task, uint time)
+        {
+            Segment s;
+            s.task = task;
+            s.start = time;
+            s.length = 1;
+            s.kind = SegmentKind::MISS;
+
+            // otwarty odcinek zamykamy, by zachować kolejność czasu,
+            // a przy wielu procesorach przekroczenie czeka na wcześniejsze otwarte odcinki
+            if (mOpen.size() == 1)
+            {
+                closeRun(0);
+                push(s);
+            }
+            else
+                hold(s);
+        }
+
+        //! Metoda dodaje zwolnienie instancji zadania
+        void release(int task, uint time)
+        {
+            Segment s;
+            s.task = task;
+            s.start = time;
+            s.length = 1;
+            s.kind = SegmentKind::RELEASE;
+
+            // tak jak przekroczenie terminu, a przy wielu procesorach zamykamy tylko odcinek
+            // tego zadania, by jeden odcinek nie obejmował dwóch instancji
+            if (mOpen.size() == 1)
+            {
+                closeRun(0);
+                push(s);
+                return;
+            }
+
+            for (uint core = 0; core < mOpen.size(); ++core)
+            {
+                if (mOpen[core].task == task)
+                    closeRun(core);
+            }
+            hold(s);
+        }
+
+        //! Metoda dodaje blokowanie zadania, łącząc je z poprzednim blokowaniem tego zadania
+        /*!
+        Blokowanie występuje tylko na jednym procesorze. Otwarte odcinki blokowania zamykane są
+        razem z odcinkiem wykonania, więc kolejne odcinki zaczynają się nie wcześniej.
+        Wywoływana po run() dla tego samego przedziału czasu.
+        */
+        void blocked(int task, uint start, uint length)
+        {
+            for (Segment &open : mBlocked)
+            {
+                if (open.task == task && open.start + open.length == start)
+                {
+                    open.length += length;
+                    return;
+                }
+            }
+
+            Segment s;
+            s.task = task;
+            s.start = start;
+            s.length = length;
+            s.kind = SegmentKind::BLOCKED;
+            mBlocked.push_back(s);
+        }
+
+    private:
+        //! Metoda przedłuża otwarty odcinek procesora tego samego rodzaju i zadania albo otwiera nowy
+        void extend(SegmentKind kind, int task, uint start, uint length, uint core)
+        {
+            Segment &open = mOpen[core];
+            if (open.length > 0 && open.kind == kind && open.task == task && open.start + open.length == start)
+            {
+                open.length += length;
+                return;
+            }
+
+            closeRun(core);
+            open.task = task;
+            open.start = start;
+            open.length = length;
+            open.kind = kind;
+        }
+
+        //! Metoda zamyka otwarty odcinek procesora
+        void closeRun(uint core)
+        {
+            Segment &open = mOpen[core];
+            if (open.length > 0)
+            {
+                Segment closed = open;
+                open.length = 0;
+                if (mOpen.size() == 1)
+                    push(closed);
+                else
+                    hold(closed);
+            }
+
+            // otwarte blokowania zaczęły się nie wcześniej niż zamknięte wykonanie
+            if (!mBlocked.empty())
+            {
+                for (const Segment &s : mBlocked)
+                    push(s);
+                mBlocked.clear();
+            }
+        }
+
+        //! Metoda zamyka otwarte odcinki wszystkich procesorów i przekazuje czekające odcinki
+        void closeRuns();
+
+        //! Metoda odkłada zamknięty odcinek do czasu zamknięcia wcześniejszych odcinków
+        void hold(const Segment& s);
+
+        //! Funkcja porównująca odcinki w kopcu czekających, na szczycie jest najwcześniejszy
+        /*!
+        Przy równym początku przekroczenie terminu poprzedza zwolnienie, a zwolnienie wykonanie i przełączanie, tak jak
+        przy jednym procesorze, gdzie zdarzenia zgłaszane są w tej kolejności przed wyborem zadania w danej chwili.
+        */
+        static bool later(const Segment& a, const Segment& b)
+        {
+            if (a.start != b.start)
+                return a.start > b.start;
+            return rank(a.kind) > rank(b.kind);
+        }
+
+        //! Funkcja zwraca kolejność rodzaju odcinka wśród odcinków o tym samym początku
+        static int rank(SegmentKind kind)
+        {
+            return kind == SegmentKind::MISS ? 0 : kind == SegmentKind::RELEASE ? 1 : kind == SegmentKind::TASK || kind == SegmentKind::SWITCH ? 2 : 3;
+        }
+
+        //! Metoda dodaje odcinek do paczki i przekazuje pełną paczkę odbiorcy
+        void push(const Segment& s)
+        {
+            if (mWindowValid)
+            {
+                if (mWindow.size() < windowSize)
+                    mWindow.push_back(s);
+                else
+                    mWindowValid = false;
+            }
+
+            mBatch.push_back(s);
+            if (mBatch.size() == batchSize)
+                flush();
+        }
+
+        //! Metoda przekazuje paczkę odbiorcy
+        void flush();
+
+        TraceSink* mSink {nullptr};   //!< odbiorca przebiegu
+        std::vector<Segment> mOpen {Segment()}; //!< otwarte odcinki wykonania kolejnych procesorów
+        std::vector<Segment> mHeld;   //!< kopiec zamkniętych odcinków czekających na wcześniejsze
+        std::vector<Segment> mBlocked; //!< otwarte odcinki blokowania
+        std::vector<Segment> mBatch;  //!< paczka odcinków
+        std::vector<Segment> mWindow; //!< odcinki od ostatniej granicy
+        bool mWindowValid {false};    //!< czy mWindow zawiera wszystkie odcinki od ostatniej granicy
+    };
+}
@@ -0,0 +1,458 @@
+#include "tracefile.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace alg
+{
+    namespace
+    {
+        //! Znacznik początku i końca pliku
+        const char traceMagic[8] = {'S', 'C', 'H', 'T', 'R', 'A', 'C', 'E'};
+        //! Wersja formatu
+        const std::uint32_t traceVersion = 1;
+        //! Liczba bitów rodzaju odcinka
+        const int kindBits = 3;
+        //! Rozmiar opisu zadania w nagłówku
+        const std::size_t taskEntrySize = 28;
+        //! Rozmiar wpisu indeksu
+        const std::size_t indexEntrySize = 16;
+        //! Rozmiar stopki
+        const std::size_t footerSize = 32;
+
+        void putU32(std::string& out, std::uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+
+        void putU64(std::string& out, std::uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i)
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+
+        void putVarint(std::string& out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        std::uint32_t getU32(const unsigned char* p)
+        {
+            std::uint32_t value = 0;
+            for (int i = 3; i >= 0; --i)
+                value = (value << 8) | p[i];
+            return value;
+        }
+
+        std::uint64_t getU64(const unsigned char* p)
+        {
+            std::uint64_t value = 0;
+            for (int i = 7; i >= 0; --i)
+                value = (value << 8) | p[i];
+            return value;
+        }
+
+        //! Funkcja odczytuje liczbę zmiennej długości, przesuwając wskaźnik
+        bool getVarint(const unsigned char*& p, const unsigned char* end, std::uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64 && p < end; shift += 7)
+            {
+                unsigned char byte = *p++;
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        //! Kodowanie liczb ze znakiem, małe wartości bezwzględne dają krótkie liczby
+        std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        //! Funkcja zwraca koniec odcinka, przekroczenie terminu i zwolnienie zajmują jeden cykl
+        std::uint64_t segmentEnd(const Segment& s)
+        {
+            return static_cast<std::uint64_t>(s.start) + (hasLength(s.kind) ? s.length : 1);
+        }
+    }
+
+    const std::size_t TraceWriter::blockSegments;
+
+    bool TraceWriter::open(const std::string& path, const std::string& policy, const std::vector<Task>& tasks, uint cores)
+    {
+        mOut.open(path, std::ios::binary | std::ios::trunc);
+        if (!mOut)
+            return false;
+
+        mBlock.clear();
+        mIndex.clear();
+        mOffset = 0;
+        mSegments = 0;
+        mReach = 0;
+        mCores = std::max(cores, 1u);
+
+        mBuffer.assign(traceMagic, sizeof(traceMagic));
+        putU32(mBuffer, traceVersion);
+        putU32(mBuffer, mCores);
+        putU32(mBuffer, static_cast<std::uint32_t>(policy.size()));
+        mBuffer += policy;
+        putU32(mBuffer, static_cast<std::uint32_t>(tasks.size()));
+        for (const Task &t : tasks)
+        {
+            putU32(mBuffer, static_cast<std::uint32_t>(t.period));
+            putU32(mBuffer, static_cast<std::uint32_t>(t.time));
+            putU32(mBuffer, static_cast<std::uint32_t>(t.deadline));
+            putU32(mBuffer, static_cast<std::uint32_t>(t.prioryty));
+            putU32(mBuffer, static_cast<std::uint32_t>(t.offset));
+            putU32(mBuffer, static_cast<std::uint32_t>(t.jitter));
+            putU32(mBuffer, static_cast<std::uint32_t>(t.arrival));
+        }
+        write(mBuffer);
+
+        return static_cast<bool>(mOut);
+    }
+
+    void TraceWriter::consume(const Segment* segments, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (segments[i].task < 0)
+                continue;
+
+            mBlock.push_back(segments[i]);
+            if (mBlock.size() == blockSegments)
+                writeBlock();
+        }
+    }
+
+    bool TraceWriter::close(uint horizon)
+    {
+        if (!mOut.is_open())
+            return false;
+
+        writeBlock();
+
+        // indeks bloków i stopka
+        std::uint64_t indexOffset = mOffset;
+        mBuffer.clear();
+        for (const IndexEntry &e : mIndex)
+        {
+            putU64(mBuffer, e.offset);
+            putU32(mBuffer, e.start);
+            putU32(mBuffer, e.reach);
+        }
+        putU64(mBuffer, indexOffset);
+        putU64(mBuffer, mSegments);
+        putU32(mBuffer, static_cast<std::uint32_t>(mIndex.size()));
+        putU32(mBuffer, horizon);
+        mBuffer.append(traceMagic, sizeof(traceMagic));
+        write(mBuffer);
+
+        bool ok = static_cast<bool>(mOut);
+        mOut.close();
+        return ok && !mOut.fail();
+    }
+
+    void TraceWriter::writeBlock()
+    {
+        if (mBlock.empty())
+            return;
+
+        // odcinki grupujemy według zadań, zachowując kolejność czasu w obrębie zadania
+        mSorted = mBlock;
+        std::stable_sort(mSorted.begin(), mSorted.end(), [](const Segment& a, const Segment& b)
+        {
+            return a.task < b.task;
+        });
+
+        IndexEntry entry;
+        entry.offset = mOffset;
+        entry.start = mBlock.front().start;
+        for (const Segment &s : mBlock)
+        {
+            entry.start = std::min(entry.start, s.start);
+            mReach = static_cast<uint>(std::max<std::uint64_t>(mReach, segmentEnd(s)));
+        }
+        entry.reach = mReach;
+
+        // liczba zadań w bloku
+        std::size_t records = 0;
+        for (std::size_t i = 0; i < mSorted.size(); ++i)
+        {
+            if (i == 0 || mSorted[i].task != mSorted[i - 1].task)
+                ++records;
+        }
+
+        mBuffer.clear();
+        putVarint(mBuffer, records);
+
+        int previousTask = 0;
+        for (std::size_t i = 0; i < mSorted.size();)
+        {
+            std::size_t j = i;
+            while (j < mSorted.size() && mSorted[j].task == mSorted[i].task)
+                ++j;
+
+            putVarint(mBuffer, static_cast<std::uint64_t>(mSorted[i].task - previousTask));
+            putVarint(mBuffer, j - i);
+            previousTask = mSorted[i].task;
+
+            // przesunięcia liczone są od końca poprzedniego odcinka zadania
+            std::int64_t cursor = entry.start;
+            for (; i < j; ++i)
+            {
+                const Segment &s = mSorted[i];
+                bool run = hasLength(s.kind);
+                std::uint64_t shift = zigzag(static_cast<std::int64_t>(s.start) - cursor);
+                putVarint(mBuffer, (shift << kindBits) | static_cast<std::uint64_t>(s.kind));
+                if (run)
+                    putVarint(mBuffer, s.length);
+                if (mCores > 1)
+                    putVarint(mBuffer, s.core);
+                cursor = static_cast<std::int64_t>(s.start) + (run ? s.length : 0);
+            }
+        }
+
+        write(mBuffer);
+        mIndex.push_back(entry);
+        mSegments += mBlock.size();
+        mBlock.clear();
+    }
+
+    void TraceWriter::write(const std::string& bytes)
+    {
+        mOut.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        mOffset += bytes.size();
+    }
+
+    bool TraceView::open(const void* data, std::size_t size, std::string& error)
+    {
+        mData = static_cast<const unsigned char*>(data);
+        mSize = size;
+        mBlocks = 0;
+        mTasks.clear();
+        mPolicy.clear();
+
+        if (size < sizeof(traceMagic) + 12 + footerSize || std::memcmp(mData, traceMagic, sizeof(traceMagic)) != 0)
+        {
+            error = "to nie jest plik przebiegu";
+            return false;
+        }
+
+        const unsigned char* footer = mData + size - footerSize;
+        if (std::memcmp(footer + 24, traceMagic, sizeof(traceMagic)) != 0)
+        {
+            error = "plik przebiegu jest niekompletny";
+            return false;
+        }
+
+        const unsigned char* p = mData + sizeof(traceMagic);
+        const unsigned char* headerEnd = footer;
+        if (getU32(p) != traceVersion)
+        {
+            error = "nieobslugiwana wersja pliku przebiegu";
+            return false;
+        }
+        p += 4;
+
+        if (headerEnd - p < 8)
+        {
+            error = "uszkodzony naglowek";
+            return false;
+        }
+        mCores = getU32(p);
+        p += 4;
+        if (mCores == 0 || mCores > 0xffff)
+        {
+            error = "uszkodzony naglowek";
+            return false;
+        }
+
+        // nazwa algorytmu i zadania
+        std::uint32_t length = getU32(p);
+        p += 4;
+        if (length > static_cast<std::size_t>(headerEnd - p) || static_cast<std::size_t>(headerEnd - p) - length < 4)
+        {
+            error = "uszkodzony naglowek";
+            return false;
+        }
+        mPolicy.assign(reinterpret_cast<const char*>(p), length);
+        p += length;
+
+        std::uint32_t tasks = getU32(p);
+        p += 4;
+        if (tasks > static_cast<std::size_t>(headerEnd - p) / taskEntrySize)
+        {
+            error = "uszkodzony naglowek";
+            return false;
+        }
+        mTasks.reserve(tasks);
+        for (std::uint32_t i = 0; i < tasks; ++i, p += taskEntrySize)
+        {
+            mTasks.emplace_back(static_cast<int>(i), static_cast<int>(getU32(p)), static_cast<int>(getU32(p + 4)),
+                                static_cast<int>(getU32(p + 8)), static_cast<int>(getU32(p + 12)));
+
+            std::uint32_t arrival = getU32(p + 24);
+            if (arrival > static_cast<std::uint32_t>(Arrival::APERIODIC))
+            {
+                error = "uszkodzony naglowek";
+                return false;
+            }
+            mTasks.back().offset = static_cast<int>(getU32(p + 16));
+            mTasks.back().jitter = static_cast<int>(getU32(p + 20));
+            mTasks.back().arrival = static_cast<Arrival>(arrival);
+        }
+
+        // stopka i indeks
+        std::uint64_t indexOffset = getU64(footer);
+        mSegments = getU64(footer + 8);
+        std::uint32_t blocks = getU32(footer + 16);
+        mHorizon = getU32(footer + 20);
+
+        std::size_t dataEnd = size - footerSize;
+        if (indexOffset < static_cast<std::uint64_t>(p - mData) || indexOffset > dataEnd
+            || (dataEnd - indexOffset) / indexEntrySize != blocks || (dataEnd - indexOffset) % indexEntrySize != 0)
+        {
+            error = "uszkodzony indeks";
+            return false;
+        }
+        mIndex = mData + indexOffset;
+        mBlocks = blocks;
+
+        for (std::size_t i = 0; i < mBlocks; ++i)
+        {
+            if (blockOffset(i) >= indexOffset || (i > 0 && (blockOffset(i) <= blockOffset(i - 1) || blockStart(i) < blockStart(i - 1))))
+            {
+                error = "uszkodzony indeks";
+                mBlocks = 0;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint TraceView::blockStart(std::size_t index) const
+    {
+        return getU32(mIndex + index * indexEntrySize + 8);
+    }
+
+    uint TraceView::blockReach(std::size_t index) const
+    {
+        return getU32(mIndex + index * indexEntrySize + 12);
+    }
+
+    std::uint64_t TraceView::blockOffset(std::size_t index) const
+    {
+        return getU64(mIndex + index * indexEntrySize);
+    }
+
+    bool TraceView::block(std::size_t index, std::vector<Segment>& out) const
+    {
+        if (index >= mBlocks)
+            return false;
+
+        const unsigned char* p = mData + blockOffset(index);
+        const unsigned char* end = index + 1 < mBlocks ? mData + blockOffset(index + 1) : mIndex;
+        const std::int64_t start = blockStart(index);
+
+        std::uint64_t records;
+        if (!getVarint(p, end, records))
+            return false;
+
+        std::uint64_t task = 0;
+        for (std::uint64_t r = 0; r < records; ++r)
+        {
+            std::uint64_t delta, count;
+            if (!getVarint(p, end, delta) || !getVarint(p, end, count) || count > static_cast<std::uint64_t>(end - p))
+                return false;
+
+            task += delta;
+            if (task >= mTasks.size())
+                return false;
+
+            std::int64_t cursor = start;
+            for (std::uint64_t k = 0; k < count; ++k)
+            {
+                std::uint64_t value, length = 1;
+                if (!getVarint(p, end, value))
+                    return false;
+
+                // rodzaj odcinka zajmuje najmłodsze bity
+                std::uint64_t kindValue = value & ((1u << kindBits) - 1);
+                if (kindValue > static_cast<std::uint64_t>(SegmentKind::SWITCH))
+                    return false;
+                SegmentKind kind = static_cast<SegmentKind>(kindValue);
+                value >>= kindBits;
+
+                bool run = hasLength(kind);
+                if (run && !getVarint(p, end, length))
+                    return false;
+
+                std::uint64_t core = 0;
+                if (mCores > 1 && (!getVarint(p, end, core) || core >= mCores))
+                    return false;
+
+                std::int64_t begin = cursor + unzigzag(value);
+                if (begin < 0 || begin + static_cast<std::int64_t>(length) > static_cast<std::int64_t>(mHorizon) + 1)
+                    return false;
+
+                Segment s;
+                s.task = static_cast<int>(task);
+                s.start = static_cast<uint>(begin);
+                s.length = static_cast<uint>(length);
+                s.kind = kind;
+                s.core = static_cast<std::uint16_t>(core);
+                out.push_back(s);
+
+                cursor = begin + (run ? static_cast<std::int64_t>(length) : 0);
+            }
+        }
+
+        return p == end;
+    }
+
+    bool TraceView::segments(uint from, uint to, std::vector<Segment>& out) const
+    {
+        // pierwszy blok, w którym któryś odcinek sięga za from
+        std::size_t lo = 0, hi = mBlocks;
+        while (lo < hi)
+        {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (blockReach(mid) <= from)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        for (std::size_t i = lo; i < mBlocks && blockStart(i) < to; ++i)
+        {
+            std::size_t first = out.size();
+            if (!block(i, out))
+                return false;
+
+            // zostawiamy tylko odcinki przecinające przedział
+            auto last = std::remove_if(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(), [from, to](const Segment& s)
+            {
+                return s.start >= to || segmentEnd(s) <= from;
+            });
+            out.erase(last, out.end());
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "task.h"
+#include "trace.h"
+
+namespace alg
+{
+    //! Zapis przebiegu symulacji do pliku binarnego
+    /*!
+    Format pliku (liczby całkowite little-endian):
+    - nagłówek: znacznik "SCHTRACE", wersja (u32), liczba procesorów (u32),
+      nazwa algorytmu (u32 długość i znaki), liczba zadań (u32) i dla każdego zadania
+      okres, czas wykonania, termin, priorytet, przesunięcie, jitter i rodzaj zwalniania (Arrival) (i32),
+    - bloki odcinków: liczba zadań w bloku, a dla każdego z nich przyrost id zadania,
+      liczba odcinków i odcinki zakodowane liczbami zmiennej długości (varint)
+      jako przesunięcie początku względem końca poprzedniego odcinka zadania połączone
+      z rodzajem odcinka (trzy najmłodsze bity SegmentKind), długość odcinka wykonania,
+      blokowania lub przełączania i, gdy procesorów jest więcej niż jeden, numer procesora,
+    - indeks: dla każdego bloku położenie w pliku (u64), początek bloku (u32)
+      i największy koniec odcinka w blokach do tego włącznie (u32),
+    - stopka: położenie indeksu (u64), liczba odcinków (u64), liczba bloków (u32),
+      czas symulacji (u32) i znacznik "SCHTRACE".
+
+    Odcinki zapisywane są na bieżąco, w blokach po blockSegments odcinków,
+    więc zapis nie wymaga pamięci proporcjonalnej do długości przebiegu.
+    Sekcje krytyczne zadań nie są zapisywane, przebieg zawiera tylko ich skutek.
+    */
+    class TraceWriter : public TraceSink
+    {
+    public:
+        //! Liczba odcinków w bloku
+        static const std::size_t blockSegments = 4096;
+
+        //! Funkcja tworzy plik i zapisuje nagłówek
+        /*!
+        \param path ścieżka pliku
+        \param policy nazwa algorytmu
+        \param tasks zadania symulacji
+        \param cores liczba procesorów
+        \return false gdy nie udało się utworzyć pliku
+        */
+        bool open(const std::string& path, const std::string& policy, const std::vector<Task>& tasks, uint cores = 1);
+
+        //! Funkcja zapisuje ostatni blok, indeks i stopkę, a następnie zamyka plik
+        /*!
+        \param horizon czas zakończenia symulacji
+        \return false gdy któryś zapis się nie powiódł
+        */
+        bool close(uint horizon);
+
+        void consume(const Segment* segments, std::size_t count) override;
+
+    private:
+        //! Wpis indeksu bloków
+        struct IndexEntry
+        {
+            std::uint64_t offset; //!< położenie bloku w pliku
+            uint start;           //!< początek pierwszego odcinka bloku
+            uint reach;           //!< największy koniec odcinka w blokach do tego włącznie
+        };
+
+        //! Metoda koduje i zapisuje zebrane odcinki jako jeden blok
+        void writeBlock();
+        //! Metoda zapisuje bufor do pliku
+        void write(const std::string& bytes);
+
+        std::ofstream mOut;              //!< plik przebiegu
+        std::vector<Segment> mBlock;     //!< odcinki bieżącego bloku
+        std::vector<Segment> mSorted;    //!< odcinki bloku pogrupowane według zadań
+        std::vector<IndexEntry> mIndex;  //!< indeks zapisanych bloków
+        std::string mBuffer;             //!< zakodowany blok
+        std::uint64_t mOffset {0};       //!< rozmiar zapisanej części pliku
+        std::uint64_t mSegments {0};     //!< liczba zapisanych odcinków
+        uint mReach {0};                 //!< największy koniec zapisanego odcinka
+        uint mCores {1};                 //!< liczba procesorów
+    };
+
+    //! Odczyt przebiegu symulacji z pamięci
+    /*!
+    Działa bezpośrednio na obszarze pamięci zawierającym cały plik, np. zmapowanym
+    przez mmap lub QFile::map, bez kopiowania odcinków. Bloki dekodowane są dopiero
+    przy odczycie, a indeks pozwala odczytać tylko bloki przecinające podany przedział czasu.
+    Obszar pamięci musi istnieć przez cały czas korzystania z obiektu.
+    */
+    class TraceView
+    {
+    public:
+        //! Funkcja sprawdza nagłówek, stopkę i indeks pliku
+        /*!
+        \param data początek pliku w pamięci
+        \param size rozmiar pliku
+        \param error opis błędu gdy plik jest niepoprawny
+        */
+        bool open(const void* data, std::size_t size, std::string& error);
+
+        //! Funkcja zwraca nazwę algorytmu
+        const std::string& policy() const { return mPolicy; }
+        //! Funkcja zwraca zadania symulacji
+        const std::vector<Task>& tasks() const { return mTasks; }
+        //! Funkcja zwraca czas symulacji
+        uint horizon() const { return mHorizon; }
+        //! Funkcja zwraca liczbę procesorów
+        uint cores() const { return mCores; }
+        //! Funkcja zwraca liczbę odcinków
+        std::uint64_t segmentCount() const { return mSegments; }
+        //! Funkcja zwraca liczbę bloków
+        std::size_t blockCount() const { return mBlocks; }
+
+        //! Funkcja dekoduje blok i dopisuje jego odcinki
+        /*!
+        Odcinki bloku pogrupowane są według zadań, a odcinki jednego zadania są w kolejności czasu.
+        \return false gdy blok jest uszkodzony
+        */
+        bool block(std::size_t index, std::vector<Segment>& out) const;
+
+        //! Funkcja dopisuje odcinki przecinające przedział czasu [from, to)
+        /*!
+        Odcinki jednego zadania są w kolejności czasu.
+        \return false gdy któryś blok jest uszkodzony
+        */
+        bool segments(uint from, uint to, std::vector<Segment>& out) const;
+
+    private:
+        //! Funkcja zwraca początek bloku z indeksu
+        uint blockStart(std::size_t index) const;
+        //! Funkcja zwraca największy koniec odcinka w blokach do podanego włącznie
+        uint blockReach(std::size_t index) const;
+        //! Funkcja zwraca położenie bloku w pliku
+        std::uint64_t blockOffset(std::size_t index) const;
+
+        const unsigned char* mData {nullptr}; //!< początek pliku
+        std::size_t mSize {0};                //!< rozmiar pliku
+        const unsigned char* mIndex {nullptr};//!< początek indeksu
+        std::size_t mBlocks {0};              //!< liczba bloków
+        std::uint64_t mSegments {0};          //!< liczba odcinków
+        uint mHorizon {0};                    //!< czas symulacji
+        uint mCores {1};                      //!< liczba procesorów
+        std::string mPolicy;                  //!< nazwa algorytmu
+        std::vector<Task> mTasks;             //!< zadania symulacji
+    };
+}
@@ -0,0 +1,179 @@
+#include "tracepyramid.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace alg
+{
+    const std::uint32_t TracePyramid::baseBucket;
+    const std::uint32_t TracePyramid::fanout;
+
+    void TracePyramid::reset(std::size_t tasks)
+    {
+        mTasks.assign(tasks, TaskLevels());
+        mHorizon = 0;
+        for (TaskLevels &t : mTasks)
+            t.levels.resize(1);
+    }
+
+    PyramidCell& TracePyramid::cell(TaskLevels& levels, std::size_t index)
+    {
+        std::vector<PyramidCell> &base = levels.levels[0];
+        levels.size = std::max(levels.size, index + 1);
+
+        // zapamiętujemy od której komórki trzeba przeliczyć wyższe poziomy
+        if (!levels.dirty || index < levels.dirtyFrom)
+            levels.dirtyFrom = index;
+        levels.dirty = true;
+
+        // odcinki przychodzą w kolejności czasu, więc zwykle komórka jest ostatnia lub nowa
+        std::size_t pos = !base.empty() && base.back().index < index ? base.size() : lowerBound(base, index);
+        if (pos == base.size() || base[pos].index != index)
+        {
+            PyramidCell c;
+            c.index = static_cast<std::uint32_t>(index);
+            base.insert(base.begin() + static_cast<std::ptrdiff_t>(pos), c);
+        }
+
+        return base[pos];
+    }
+
+    void TracePyramid::add(const Segment& segment)
+    {
+        if (segment.task < 0 || static_cast<std::size_t>(segment.task) >= mTasks.size() || segment.length == 0)
+            return;
+
+        TaskLevels &levels = mTasks[static_cast<std::size_t>(segment.task)];
+
+        if (segment.kind == SegmentKind::MISS)
+        {
+            PyramidCell &c = cell(levels, segment.start / baseBucket);
+            if (c.misses < std::numeric_limits<std::uint16_t>::max())
+                c.misses++;
+            return;
+        }
+
+        // zwolnienia rysowane są ze znaczników, nie z poziomów piramidy
+        if (segment.kind != SegmentKind::TASK)
+            return;
+
+        // rozdzielamy odcinek na kolejne komórki poziomu 0
+        std::uint64_t start = segment.start;
+        std::uint64_t end = start + segment.length;
+        while (start < end)
+        {
+            std::uint64_t index = start / baseBucket;
+            std::uint64_t cellEnd = std::min(end, (index + 1) * baseBucket);
+            cell(levels, static_cast<std::size_t>(index)).busy += static_cast<std::uint32_t>(cellEnd - start);
+            start = cellEnd;
+        }
+    }
+
+    void TracePyramid::finish(uint horizon)
+    {
+        std::size_t baseCount = (static_cast<std::size_t>(horizon) + baseBucket - 1) / baseBucket;
+
+        // ostatnia komórka poprzedniego przebiegu mogła być niepełna
+        std::size_t tail = mHorizon / baseBucket;
+        bool grown = horizon != mHorizon;
+        mHorizon = horizon;
+
+        for (TaskLevels &levels : mTasks)
+        {
+            // poziom 0 obejmuje cały przebieg, również cykle bez wykonania
+            levels.size = std::max(levels.size, baseCount);
+
+            // nowe puste komórki zmieniają najmniejsze wypełnienie komórek wyższych poziomów
+            if (grown && tail < levels.size)
+            {
+                if (!levels.dirty || tail < levels.dirtyFrom)
+                    levels.dirtyFrom = tail;
+                levels.dirty = true;
+            }
+
+            if (!levels.dirty)
+                continue;
+
+            // wypełnienie komórki poziomu 0 względem liczby jej cykli w przebiegu
+            std::vector<PyramidCell> &base = levels.levels[0];
+            for (std::size_t i = lowerBound(base, levels.dirtyFrom); i < base.size(); ++i)
+            {
+                PyramidCell &c = base[i];
+                std::uint64_t first = static_cast<std::uint64_t>(c.index) * baseBucket;
+                std::uint64_t ticks = horizon > first ? std::min<std::uint64_t>(baseBucket, horizon - first) : baseBucket;
+
+                c.minOccupancy = static_cast<std::uint8_t>(std::min<std::uint64_t>(255, c.busy * 255 / ticks));
+                c.maxOccupancy = c.minOccupancy;
+            }
+
+            // przeliczamy wyższe poziomy od pierwszej zmienionej komórki
+            std::size_t from = levels.dirtyFrom;
+            std::size_t lowerSize = levels.size;
+            for (std::size_t l = 1; lowerSize > 1; ++l)
+            {
+                if (levels.levels.size() <= l)
+                    levels.levels.resize(l + 1);
+
+                const std::vector<PyramidCell> &lower = levels.levels[l - 1];
+                std::vector<PyramidCell> &upper = levels.levels[l];
+                from /= fanout;
+                upper.erase(upper.begin() + static_cast<std::ptrdiff_t>(lowerBound(upper, from)), upper.end());
+
+                std::size_t k = lowerBound(lower, static_cast<std::uint64_t>(from) * fanout);
+                while (k < lower.size())
+                {
+                    PyramidCell c;
+                    c.index = lower[k].index / fanout;
+                    c.minOccupancy = 255;
+
+                    std::size_t present = 0;
+                    for (; k < lower.size() && lower[k].index / fanout == c.index; ++k, ++present)
+                    {
+                        const PyramidCell &child = lower[k];
+                        c.busy += child.busy;
+                        c.misses = static_cast<std::uint16_t>(std::min<std::uint32_t>(c.misses + child.misses, std::numeric_limits<std::uint16_t>::max()));
+
+                        c.minOccupancy = std::min(c.minOccupancy, child.minOccupancy);
+                        c.maxOccupancy = std::max(c.maxOccupancy, child.maxOccupancy);
+                    }
+
+                    // brakujące komórki niższego poziomu są puste
+                    std::size_t children = std::min(lowerSize, (static_cast<std::size_t>(c.index) + 1) * fanout) - static_cast<std::size_t>(c.index) * fanout;
+                    if (present < children)
+                        c.minOccupancy = 0;
+
+                    upper.push_back(c);
+                }
+
+                lowerSize = (lowerSize + fanout - 1) / fanout;
+            }
+
+            levels.dirty = false;
+        }
+    }
+
+    std::uint64_t TracePyramid::bucketSize(std::size_t level)
+    {
+        std::uint64_t size = baseBucket;
+        for (std::size_t l = 0; l < level; ++l)
+            size *= fanout;
+        return size;
+    }
+
+    std::size_t TracePyramid::levelFor(double unitsPerTick, double minWidth)
+    {
+        std::size_t level = 0;
+        while (level < 32 && bucketSize(level) * unitsPerTick < minWidth)
+            ++level;
+        return level;
+    }
+
+    std::size_t TracePyramid::lowerBound(const std::vector<PyramidCell>& cells, std::uint64_t index)
+    {
+        auto it = std::lower_bound(cells.begin(), cells.end(), index, [](const PyramidCell &c, std::uint64_t i)
+        {
+            return c.index < i;
+        });
+        return static_cast<std::size_t>(it - cells.begin());
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "trace.h"
+
+namespace alg
+{
+    //! Komórka piramidy przebiegu
+    /*!
+    Opisuje przedział czasu o długości TracePyramid::bucketSize() danego poziomu.
+    Wypełnienia zapisane są jako ułamki 0..255 i dotyczą komórek poziomu 0 zawartych w tej komórce.
+    */
+    struct PyramidCell
+    {
+        std::uint32_t index {0};         //!< numer komórki w poziomie
+        std::uint32_t busy {0};          //!< liczba cykli wykonywania zadania
+        std::uint16_t misses {0};        //!< liczba przekroczonych terminów (nasycana)
+        std::uint8_t minOccupancy {0};   //!< najmniejsze wypełnienie komórki poziomu 0
+        std::uint8_t maxOccupancy {0};   //!< największe wypełnienie komórki poziomu 0
+    };
+
+    //! Wielopoziomowa piramida przebiegu
+    /*!
+    Dla każdego zadania przechowuje kolejne poziomy agregacji przebiegu:
+    poziom 0 łączy baseBucket cykli, a każdy kolejny fanout komórek poprzedniego poziomu.
+    Przy rysowaniu wybierany jest poziom, w którym jedna komórka zajmuje co najmniej piksel,
+    więc koszt rysowania nie zależy od długości symulacji.
+
+    Poziomy są rzadkie: przechowywane są tylko komórki z wykonaniem lub przekroczeniem terminu,
+    uporządkowane według numeru, a pozostałe komórki mają zerowe wypełnienie. Pamięć zależy więc
+    od aktywności zadania, a nie od długości symulacji.
+
+    Odcinki dodawane są w kolejności czasu, a wyższe poziomy przeliczane są w finish()
+    tylko od pierwszej zmienionej komórki, dzięki czemu piramidę można budować przyrostowo.
+    */
+    class TracePyramid
+    {
+    public:
+        //! Liczba cykli w komórce poziomu 0
+        static const std::uint32_t baseBucket = 16;
+        //! Liczba komórek łączonych w komórkę wyższego poziomu
+        static const std::uint32_t fanout = 4;
+
+        //! Metoda czyści piramidę i przygotowuje ją dla podanej liczby zadań
+        void reset(std::size_t tasks);
+
+        //! Metoda dodaje odcinek przebiegu
+        void add(const Segment& segment);
+
+        //! Metoda przelicza zmienione komórki wszystkich poziomów
+        /*!
+        \param horizon czas zakończenia przebiegu, ogranicza ostatnią komórkę
+        */
+        void finish(uint horizon);
+
+        //! Funkcja zwraca liczbę zadań
+        std::size_t tasks() const { return mTasks.size(); }
+
+        //! Funkcja zwraca liczbę poziomów zadania
+        std::size_t levels(std::size_t task) const { return mTasks[task].levels.size(); }
+
+        //! Funkcja zwraca niepuste komórki poziomu zadania, uporządkowane według numeru
+        const std::vector<PyramidCell>& level(std::size_t task, std::size_t level) const { return mTasks[task].levels[level]; }
+
+        //! Funkcja zwraca liczbę cykli w komórce poziomu
+        static std::uint64_t bucketSize(std::size_t level);
+
+        //! Funkcja zwraca najniższy poziom, w którym komórka ma co najmniej minWidth jednostek
+        /*!
+        \param unitsPerTick szerokość cyklu, np. w pikselach
+        \param minWidth najmniejsza szerokość komórki
+        */
+        static std::size_t levelFor(double unitsPerTick, double minWidth = 1.0);
+
+        //! Funkcja zwraca pozycję pierwszej komórki o numerze nie mniejszym niż index
+        static std::size_t lowerBound(const std::vector<PyramidCell>& cells, std::uint64_t index);
+
+    private:
+        //! Piramida jednego zadania
+        struct TaskLevels
+        {
+            std::vector<std::vector<PyramidCell>> levels; //!< kolejne poziomy
+            std::size_t size {0};                         //!< liczba komórek poziomu 0, także pustych
+            std::size_t dirtyFrom {0};                    //!< pierwsza zmieniona komórka poziomu 0
+            bool dirty {false};                           //!< czy są zmiany od ostatniego finish()
+        };
+
+        //! Funkcja zwraca komórkę poziomu 0, dodając ją w razie potrzeby
+        PyramidCell& cell(TaskLevels& levels, std::size_t index);
+
+        std::vector<TaskLevels> mTasks; //!< piramidy kolejnych zadań
+        uint mHorizon {0};              //!< czas zakończenia przebiegu z ostatniego finish()
+    };
+}
@@ -1,70 +0,0 @@
-#pragma once
-
-#include <vector>
-
-#include <QWidget>
-
-// deklaracja zapowiadajaa klasy alg::Scheduler
-namespace alg
-{
-    class Scheduler;
-}
-
-//! GanttWidget
-/*!
-Klasa reprezentuje widget wykresu Gantt'a.
-Obuguje ona rysowanie wykresu i skalowanie wykresu na podstawie
-przekazanych danych
-*/
-class GanttWidget : public QWidget
-{
-    Q_OBJECT
-
-public:
-    //! Konstruktor
-    GanttWidget(QWidget *parent = nullptr);
-
-    //! Metoda rysujca wykres Gantt'a
-    void paint(QPainter *painter);
-
-public slots:
-    //! Slot obugujcy dodanie zadnia
-    void notifyTask(alg::Scheduler* scheduler, int taskId);
-    //! Slot obugujcy przekroczenie terminu
-    void notifyDeadlineMiss(alg::Scheduler* scheduler, int taskId);
-    //! Slot obugujcy czyszczeie danych
-    void clear();
-
-protected:
-    //! Przeciony event rysowania widgetu
-    void paintEvent(QPaintEvent *event);
-    //! Przeciony event obugi kka myszki
-    void wheelEvent(QWheelEvent *event);
-
-private:
-    //! Typty powiadomie
-    enum class NotifyType
-    {
-        TASK, //!< Zadanie
-        MISS  //!< Przekroczenie terminu
-    };
-
-    //! Struktura reprezentujc prostokt. Dziediczy po QRectF i dodaje pole typu powidomienia.
-    struct GanttRect : public QRectF
-    {
-        NotifyType notifyType;
-    };
-
-    //! Metoda obuguje odpowiednie powiadamoenia. Dodaje kolenjne prostokty dla odpowiednich zada.
-    void notify(const alg::Scheduler* scheduler, int taskId, int time, NotifyType notifyType);
-    //! Funkcja zwraca rozmiar wykresu Gantt'a
-    QSize getGanttSize() const;
-
-    const alg::Scheduler* mSchedulerPtr {nullptr}; //!< wskanik na harmonogram
-
-    // skracacmy nazw
-    using VecRec = std::vector<GanttRect>;
-    VecRec* mRectanglesArray {nullptr}; //!< tablica 2D prostoktw
-    double scale {1.0}; //!< wspczynnik skali wykresu
-    double timeWidth {2.0}; //!< szeroko jednostki czasu na wykrsie
-};
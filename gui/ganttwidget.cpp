@@ -0,0 +1,689 @@
+#include "ganttwidget.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <QtGui>
+
+#include "scheduler.h"
+#include "tracefile.h"
+
+#include <QReadLocker>
+#include <QRunnable>
+#include <QScrollArea>
+#include <QWriteLocker>
+
+//! Zadanie rysujące kafelek wykresu w puli wątków
+class GanttWidget::TileJob : public QRunnable
+{
+public:
+    TileJob(GanttWidget *widget, const TileKey &key, int generation)
+        : mWidget(widget), mKey(key), mGeneration(generation)
+    {}
+
+    void run() override
+    {
+        mWidget->renderTile(mKey, mGeneration);
+    }
+
+private:
+    GanttWidget *mWidget;
+    TileKey mKey;
+    int mGeneration;
+};
+
+// Funkcja szablonowa dokonująca konwersji do int
+template < typename T>
+int toInt( T a) { return static_cast<int>(a); }
+
+// Funkcja zamienia położenie w pikselach na int, nasycając je do największego rozmiaru widgetu
+int toPixels(double x) { return toInt(qBound(0.0, x, double(QWIDGETSIZE_MAX))); }
+
+GanttWidget::GanttWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    // ustawimy minimalną szerokośc widgetu
+    setMinimumWidth(600);
+}
+
+QSize GanttWidget::getGanttSize() const
+{
+    // jeżli nie mamy harmonogramu zwracamy szerokość widgetu
+    if(mTasks.empty())
+        return size();
+
+    // obliczmy szerokośc dla pełnego wykresu
+    // szerokość = czas_symulacji + 10 * 2 + 30
+    // wysokość  = (ilośc_zadań + ilość_procesorów) * 20 + 30
+    return QSize( toPixels((mHorizon+10.0)*timeWidth +30), (rows() * 20) + 30);
+}
+
+int GanttWidget::rows() const
+{
+    // wiersze procesorów rysujemy tylko dla wielu procesorów
+    return toInt(mTasks.size()) + (mCores > 1 ? toInt(mCores) : 0);
+}
+
+void GanttWidget::updateGanttSize()
+{
+    // bez przebiegu wracamy do minimalnej szerokości z konstruktora
+    if (mTasks.empty())
+    {
+        setMinimumSize(600, 0);
+        return;
+    }
+
+    // szerszego widgetu nie dałoby się przewinąć do końca, więc przy długim przebiegu zmniejszamy skalę
+    if (timeWidth > maxTimeWidth())
+    {
+        timeWidth = maxTimeWidth();
+        scale = timeWidth / 2;
+    }
+    setMinimumSize(getGanttSize());
+}
+
+GanttWidget::~GanttWidget()
+{
+    // czekamy na zadania rysujące kafelki, bo odwołują się do widgetu
+    mTilePool.clear();
+    mTilePool.waitForDone();
+}
+
+void GanttWidget::paintEvent(QPaintEvent* event)
+{
+    // tworzymy obiekt QPainter po którym bedziemy rysować
+    QPainter painter;
+    painter.begin(this);
+
+    // rysujemy tylko odsłonięty fragment widgetu
+    const QRect exposed = event->rect();
+    painter.setClipRect(exposed);
+
+    // rysujemy białe tło
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::white);
+    painter.drawRect(exposed);
+
+    if (!mTasks.empty())
+    {
+        // kopiujemy gotowe kafelki, a brakujące zlecamy do narysowania w tle
+        for (int ty = exposed.top() / tileSize; ty <= exposed.bottom() / tileSize; ++ty)
+        {
+            for (int tx = exposed.left() / tileSize; tx <= exposed.right() / tileSize; ++tx)
+            {
+                const TileKey key {timeWidth, tx, ty};
+                const QRect tileRect(tx * tileSize, ty * tileSize, tileSize, tileSize);
+
+                if (const QImage *image = mTiles.find(key))
+                {
+                    painter.drawImage(tileRect.topLeft(), *image);
+                    continue;
+                }
+
+                requestTile(key);
+
+                // zanim kafelek będzie gotowy rysujemy jego odsłoniętą część bezpośrednio
+                const QRect part = tileRect & exposed;
+                painter.save();
+                painter.setClipRect(part);
+                // ustawimy typ renderowania
+                painter.setRenderHint(QPainter::Antialiasing);
+                // wywołujemy metodę rusowania wykresu
+                paint(&painter, part);
+                painter.restore();
+            }
+        }
+
+        // kafelki wokół widocznego obszaru przygotowujemy zawczasu, by przewijanie tylko je kopiowało
+        prefetchTiles(visibleRegion().boundingRect());
+    }
+
+    painter.end();
+}
+
+void GanttWidget::requestTile(const TileKey &key)
+{
+    // kafelek już czeka na narysowanie
+    if (!mPendingTiles.insert(key).second)
+        return;
+
+    mTilePool.start(new TileJob(this, key, mGeneration));
+}
+
+void GanttWidget::prefetchTiles(const QRect &visible)
+{
+    if (visible.isEmpty())
+        return;
+
+    const QSize size = getGanttSize();
+    const int lastX = qMin(visible.right() / tileSize + 1, (size.width() - 1) / tileSize);
+    const int lastY = qMin(visible.bottom() / tileSize + 1, (size.height() - 1) / tileSize);
+
+    for (int ty = qMax(0, visible.top() / tileSize - 1); ty <= lastY; ++ty)
+    {
+        for (int tx = qMax(0, visible.left() / tileSize - 1); tx <= lastX; ++tx)
+        {
+            const TileKey key {timeWidth, tx, ty};
+            if (!mTiles.contains(key))
+                requestTile(key);
+        }
+    }
+}
+
+void GanttWidget::renderTile(const TileKey &key, int generation)
+{
+    QReadLocker locker(&mDataLock);
+
+    // przebieg zmienił się od zlecenia kafelka
+    if (generation != mGeneration || mTasks.empty())
+        return;
+
+    QImage image(tileSize, tileSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(QColor(Qt::white).rgb());
+
+    // rysujemy kafelek przesuwając układ współrzędnych widgetu
+    const QRect rect(key.x * tileSize, key.y * tileSize, tileSize, tileSize);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(-rect.topLeft());
+    painter.setClipRect(rect);
+    paint(&painter, rect, key.zoom);
+    painter.end();
+
+    locker.unlock();
+
+    // gotowy kafelek przekazujemy do wątku okna
+    QMetaObject::invokeMethod(this, "tileReady", Qt::QueuedConnection,
+                              Q_ARG(int, generation), Q_ARG(double, key.zoom),
+                              Q_ARG(int, key.x), Q_ARG(int, key.y), Q_ARG(QImage, image));
+}
+
+void GanttWidget::tileReady(int generation, double zoom, int x, int y, const QImage &image)
+{
+    // kafelek narysowany dla nieaktualnego przebiegu
+    if (generation != mGeneration)
+        return;
+
+    const TileKey key {zoom, x, y};
+    mPendingTiles.erase(key);
+    mTiles.insert(key, image);
+
+    if (zoom == timeWidth)
+        update(QRect(x * tileSize, y * tileSize, tileSize, tileSize));
+}
+
+double GanttWidget::minTimeWidth() const
+{
+    if (mTasks.empty())
+        return 2.0;
+
+    // szukamy obszaru przewijania, w którym leży wykres
+    int width = this->width();
+    for (QWidget *w = parentWidget(); w; w = w->parentWidget())
+    {
+        if (QScrollArea *area = qobject_cast<QScrollArea*>(w))
+        {
+            width = area->viewport()->width();
+            break;
+        }
+    }
+
+    // najmniejsza skala mieści cały przebieg w widocznym obszarze
+    double fit = qMax(1, width - 40) / double(mHorizon + 10);
+    return qMin(2.0, fit);
+}
+
+double GanttWidget::maxTimeWidth() const
+{
+    // największa skala, przy której szerokość wykresu nie przekracza QWIDGETSIZE_MAX
+    return (QWIDGETSIZE_MAX - 30) / (mHorizon + 10.0);
+}
+
+void GanttWidget::wheelEvent(QWheelEvent * event)
+{
+    // ustawimy i ograniczmy skalę, poniżej 2 pikseli na cykl zmieniamy ją mnożąc
+    if (scale > 1.0 || (scale == 1.0 && event->delta() > 0))
+        scale += (event->delta() / 480.0);
+    else
+        scale *= std::pow(1.25, event->delta() / 120.0);
+    scale = qMax(minTimeWidth() / 2, qMin(15.0, scale));
+    timeWidth = scale*2;
+    updateGanttSize();
+    update();
+}
+
+bool GanttWidget::isMiss(int taskId, double time) const
+{
+    const std::size_t task = static_cast<std::size_t>(taskId);
+
+    // sprawdzamy tylko odcinki obejmujące podaną chwilę
+    for (std::size_t k = mSegments.firstEndingAfter(task, time); k < mSegments.size(task) && mSegments.at(task, k).start <= time; ++k)
+    {
+        if (mSegments.at(task, k).kind == alg::SegmentKind::MISS)
+            return true;
+    }
+    return false;
+}
+
+void GanttWidget::paint(QPainter *painter, const QRect &exposed) const
+{
+    paint(painter, exposed, timeWidth);
+}
+
+void GanttWidget::paint(QPainter *painter, const QRect &exposed, double zoom) const
+{
+    // sparawdzamy czy mamy do narysowania jakieś prostokąty
+    if (mTasks.empty())
+    {
+        return;
+    }
+
+    // widoczny przedział czasu, poszerzony o szerokość podpisów osi (30 pikseli)
+    const double firstTime = qMax(0.0, (exposed.left() - 30 - 30) / zoom);
+    const double lastTime = (exposed.right() - 30 + 30) / zoom + 1;
+    // widoczne wiersze zadań, poszerzone o znaczniki terminów wystające poniżej wiersza
+    const int firstRow = qMax(0, (exposed.top() - 25) / 20);
+    const int lastRow = qMin(rows() - 1, exposed.bottom() / 20);
+    // wiersze procesorów leżą pod wierszami zadań
+    const int tasks = toInt(mTasks.size());
+    const int lastTaskRow = qMin(lastRow, tasks - 1);
+
+    painter->setPen(QPen(Qt::black));
+
+    // wypisujemy kolejne nazwy dla zadań i procesorów
+    if (exposed.left() < 30)
+    {
+        for (int i = firstRow; i <= lastRow; ++i)
+        {
+            QString name = i < tasks ? "T" + QString::number(i + 1) : "P" + QString::number(i - tasks + 1);
+            painter->drawText(5, (i * 20 + 15), name);
+        }
+    }
+
+    // 1. rysujamy układ współrzędnych
+
+    // obliczmy wysokość lini pionowej
+    int height = rows() * 20 + 5;
+    // rysujemy line pionową
+    painter->drawLine(25, 0, 25, height);
+    // rysujemy linie poziomą
+    painter->drawLine(QPointF(25, height), QPointF((mHorizon+10.0)*zoom +30, height));
+
+    // 2. rysujemy kolejne odzinki czasu
+
+    // odstęp pomiędzy liniami siatki zależy od szerokości jednostki czasu
+    uint step = zoom > 20.0 ? 1 : zoom > 10.0 ? 5 : zoom >= 5.0 ? 10 : 20;
+    // przy mniejszej skali wybieramy odstęp 1, 2 lub 5 * 10^k, by linie były co najmniej 40 pikseli od siebie
+    while (step * zoom < 40.0)
+    {
+        uint digits = step;
+        while (digits % 10 == 0)
+            digits /= 10;
+        step = digits == 2 ? step / 2 * 5 : step * 2;
+    }
+    uint gridEnd = static_cast<uint>(qMin(mHorizon + 10.0, lastTime + 1));
+
+    // pętla dla widocznych próbek czasu
+    for (uint i = static_cast<uint>(firstTime) / step * step; i < gridEnd; i += step)
+    {
+        // wyznaczamy x
+        double x = 30 + i*zoom;
+
+        // rysujemy pionową szarą kreskowaną linię
+        painter->setPen(QPen(Qt::lightGray, 0, Qt::DashLine));
+        painter->drawLine(QPointF(x, 0.0), QPointF(x, height));
+        // piszemy kolejny licznik
+        painter->setPen(QPen(Qt::black));
+        QRectF rect(x-30, (height + 10 )-30, 60,60);
+        painter->drawText(rect, Qt::AlignCenter, QString::number(i ) );
+    }
+
+    // oddzielamy wiersze procesorów od wierszy zadań
+    if (mCores > 1)
+    {
+        painter->setPen(QPen(Qt::gray));
+        painter->drawLine(QPointF(25, tasks * 20), QPointF((mHorizon + 10.0) * zoom + 30, tasks * 20));
+    }
+    
+    // 3. rysujemy prostokąty dla zadań
+
+    painter->setPen(Qt::NoPen);
+
+    double golden_ratio = 0.618033988749895;
+    double h = 0;
+
+    // gdy cykl jest węższy niż piksel rysujemy zagregowane wypełnienie z piramidy
+    if (zoom < 1.0)
+    {
+        paintPyramid(painter, zoom, firstTime, lastTime, firstRow, lastRow);
+        return;
+    }
+
+    // wiersze procesorów wymagają przejrzenia odcinków wszystkich zadań
+    const bool coreRows = lastRow >= tasks;
+    const QBrush switchBrush(Qt::darkGray, Qt::Dense4Pattern);
+
+    // dla widocznych zadań, a gdy widoczne są wiersze procesorów dla wszystkich zadań
+    for (int i = coreRows ? 0 : firstRow; i <= (coreRows ? tasks - 1 : lastTaskRow); ++i)
+    {
+        h = golden_ratio * 360 / toInt(mTasks.size()) * (i+1);
+        const std::size_t task = static_cast<std::size_t>(i);
+        const QBrush brush(QColor::fromHsv(int(h), 245, 245, 255));
+        const QBrush blockedBrush(QColor::fromHsv(int(h), 245, 160, 255), Qt::BDiagPattern);
+        const bool taskRow = i >= firstRow && i <= lastTaskRow;
+
+        // dla odcinków przecinających widoczny przedział czasu
+        for (std::size_t k = mSegments.firstEndingAfter(task, firstTime); k < mSegments.size(task) && mSegments.at(task, k).start < lastTime; ++k)
+        {
+            const alg::StoredSegment &seg = mSegments.at(task, k);
+
+            // blokowanie na zasobie zakreskowane w wierszu zadania, bez wiersza procesora
+            if (seg.kind == alg::SegmentKind::BLOCKED)
+            {
+                if (taskRow)
+                    painter->fillRect(QRectF(30 + seg.start * zoom, i * 20 + 4, seg.length * zoom, 12), blockedBrush);
+                continue;
+            }
+
+            // przełączanie kontekstu na zadanie zajmuje procesor, więc jest też w wierszu procesora
+            if (seg.kind == alg::SegmentKind::SWITCH)
+            {
+                if (taskRow)
+                    painter->fillRect(QRectF(30 + seg.start * zoom, i * 20, seg.length * zoom, 20), switchBrush);
+                int coreRow = tasks + seg.core;
+                if (coreRows && coreRow >= firstRow && coreRow <= lastRow)
+                    painter->fillRect(QRectF(30 + seg.start * zoom, coreRow * 20, seg.length * zoom, 20), switchBrush);
+                continue;
+            }
+
+            // przekroczenia terminów rysowane są razem ze znacznikami terminów
+            if (seg.kind != alg::SegmentKind::TASK)
+                continue;
+
+            // rysujemy prostokąt o odpowiednim kolorze
+            if (taskRow)
+                painter->fillRect(QRectF(30 + seg.start * zoom, i * 20, seg.length * zoom, 20), brush);
+
+            // i ten sam odcinek w wierszu procesora, który wykonywał zadanie
+            int coreRow = tasks + seg.core;
+            if (coreRows && coreRow >= firstRow && coreRow <= lastRow)
+                painter->fillRect(QRectF(30 + seg.start * zoom, coreRow * 20, seg.length * zoom, 20), brush);
+        }
+    }
+
+    // 4. rysujemy znacznik rozpoczęcia zadania (strzałka), końca terminu (okrąg), przekroczenia terminu (czerwone koło)
+
+    // pętla po widocznych zadaniach
+    for (int i = firstRow; i <= lastTaskRow; ++i)
+    {
+        // pobieramy zadanie
+        const alg::Scheduler::Task &t = mTasks[static_cast<size_t>(i)];
+        if (t.period <= 0)
+            continue;
+
+        // pierwsze zwolnienie, którego strzałka lub termin może być widoczny
+        uint period = static_cast<uint>(t.period);
+        // zbyt gęste znaczniki zlewają się, więc je pomijamy
+        if (period * zoom < 4.0)
+            continue;
+        double from = qMax(0.0, firstTime - qMax(t.deadline, 0));
+
+        // zwolnienia ze strumienia odczytujemy z odcinków zwolnień zadania
+        if (mReleaseMarkers)
+        {
+            const std::size_t task = static_cast<std::size_t>(i);
+            for (std::size_t k = mSegments.firstEndingAfter(task, from); k < mSegments.size(task) && mSegments.at(task, k).start < lastTime; ++k)
+            {
+                const alg::StoredSegment &seg = mSegments.at(task, k);
+                if (seg.kind == alg::SegmentKind::RELEASE && seg.start < mHorizon)
+                    paintRelease(painter, i, seg.start, zoom);
+            }
+            continue;
+        }
+
+        // dla kolejnych widocznych zwolnień zadania
+        uint first = static_cast<uint>(from) / period * period;
+        for (uint time = first; time<mHorizon && time < lastTime; time += period)
+            paintRelease(painter, i, time, zoom);
+    }
+
+}
+
+void GanttWidget::paintRelease(QPainter *painter, int taskId, uint time, double zoom) const
+{
+    const alg::Scheduler::Task &t = mTasks[static_cast<size_t>(taskId)];
+
+    // obliczmy x początku zadania
+    double x = time*zoom + 30;
+    // obliczamy x terminu zadania
+    double x2 = x + t.deadline*zoom;
+    // obliczamy y zadania
+    int y = taskId * 20;
+
+    // rysujemy strzałkę
+     painter->setPen(QPen(Qt::black,2));
+    painter->drawLine(QPointF(x, y), QPointF(x, y+20));
+    painter->drawLine(QPointF(x - 5, y + 15), QPointF( x, y + 20));
+    painter->drawLine(QPointF(x + 5, y + 15), QPointF(x, y + 20));
+
+    // jeżeli x terminu zadania jest mniejszy od czasu zakończenia symulacji
+    // to rysujemy znacznik terminu
+    painter->setPen(QPen(Qt::black));
+     painter->setBrush(QBrush(Qt::white));
+    if( isMiss(taskId, time + t.deadline) )
+     {
+         //painter->setPen(QPen(Qt::red));
+         painter->setBrush(QBrush(Qt::red));
+     }
+
+    if( x2 < mHorizon*zoom )
+        painter->drawEllipse(QPointF(x2, y + 20), 4.0, 4.0);
+}
+
+void GanttWidget::paintPyramid(QPainter *painter, double zoom, double firstTime, double lastTime, int firstRow, int lastRow) const
+{
+    // piramida jest przeliczana przy każdej paczce odcinków, tu tylko z niej czytamy
+    const uint horizon = mHorizon;
+
+    // poziom, w którym komórka ma co najmniej piksel szerokości
+    std::size_t level = alg::TracePyramid::levelFor(zoom);
+    double golden_ratio = 0.618033988749895;
+
+    painter->setPen(Qt::NoPen);
+
+    const int tasks = toInt(mTasks.size());
+    for (int i = firstRow; i <= lastRow; ++i)
+    {
+        // wiersze procesorów czytamy z piramidy procesorów, bez podziału na zadania
+        const bool taskRow = i < tasks;
+        const alg::TracePyramid &pyramid = taskRow ? mPyramid : mCorePyramid;
+        std::size_t task = static_cast<std::size_t>(taskRow ? i : i - tasks);
+        std::size_t l = std::min(level, pyramid.levels(task) - 1);
+        const std::vector<alg::PyramidCell> &cells = pyramid.level(task, l);
+        const double bucket = double(alg::TracePyramid::bucketSize(l));
+
+        QColor color = taskRow ? QColor::fromHsv(int(golden_ratio * 360 / tasks * (i+1)), 245, 245, 255) : QColor(Qt::darkGray);
+        QColor light = color;
+        light.setAlpha(80);
+
+        // widoczne komórki poziomu, puste komórki nie są przechowywane ani rysowane
+        std::size_t first = alg::TracePyramid::lowerBound(cells, static_cast<std::uint64_t>(firstTime / bucket));
+        std::uint64_t last = static_cast<std::uint64_t>(lastTime / bucket) + 1;
+        for (std::size_t k = first; k < cells.size() && cells[k].index < last; ++k)
+        {
+            const alg::PyramidCell &cell = cells[k];
+            double x = 30 + cell.index * bucket * zoom;
+            double width = bucket * zoom;
+            double ticks = qMin(bucket, horizon - cell.index * bucket);
+            int y = i * 20;
+
+            // jasny pasek pokazuje największe, a pełny średnie wypełnienie komórki
+            if (cell.maxOccupancy > 0)
+                painter->fillRect(QRectF(x, y + 20 - 20 * cell.maxOccupancy / 255.0, width, 20 * cell.maxOccupancy / 255.0), light);
+            if (cell.busy > 0)
+                painter->fillRect(QRectF(x, y + 20 - 20 * cell.busy / ticks, width, 20 * cell.busy / ticks), color);
+
+            // przekroczenia terminów zaznaczamy czerwonym paskiem pod wierszem
+            if (cell.misses > 0)
+                painter->fillRect(QRectF(x, y + 18, qMax(width, 2.0), 4), Qt::red);
+        }
+    }
+}
+
+void GanttWidget::start(const std::vector<alg::Task>& tasks, uint cores)
+{
+    clear();
+
+    {
+        QWriteLocker locker(&mDataLock);
+
+        // kopia zadań pozwala rysować bez odwoływania się do harmonogramu działającego w innym wątku
+        mTasks = tasks;
+        mCores = qMax(1u, cores);
+        mReleaseMarkers = !alg::isStrictlyPeriodic(mTasks);
+        mSegments.reset(mTasks.size());
+        mPyramid.reset(mTasks.size());
+        mCorePyramid.reset(mCores > 1 ? mCores : 0);
+        ++mGeneration;
+    }
+
+    updateGanttSize();
+    update();
+}
+
+bool GanttWidget::load(const alg::TraceView& view)
+{
+    start(view.tasks(), view.cores());
+
+    bool ok = true;
+    {
+        QWriteLocker locker(&mDataLock);
+
+        // bloki dekodujemy kolejno prosto z pamięci pliku, bez wczytywania go w całości
+        std::vector<alg::Segment> segments;
+        for (std::size_t b = 0; b < view.blockCount() && ok; ++b)
+        {
+            segments.clear();
+            ok = view.block(b, segments);
+
+            for (const alg::Segment &seg : segments)
+                append(seg);
+        }
+
+        mHorizon = view.horizon();
+        mPyramid.finish(mHorizon);
+        mCorePyramid.finish(mHorizon);
+        ++mGeneration;
+    }
+
+    invalidateTiles(0);
+    updateGanttSize();
+    update();
+    return ok;
+}
+
+void GanttWidget::notifySegments(alg::Scheduler* scheduler, const std::vector<alg::Segment>& segments)
+{
+    if (!mTasks.empty())
+    {
+        // kafelki mogą być właśnie rysowane w tle, więc dane zmieniamy pod blokadą
+        QWriteLocker locker(&mDataLock);
+
+        // dodajemy całą paczkę odcinków jednym wywołaniem
+        for (const alg::Segment &seg : segments)
+            append(seg);
+
+        mPyramid.finish(mHorizon);
+        mCorePyramid.finish(mHorizon);
+        ++mGeneration;
+    }
+
+    // odcinki zaczynają się po ostatnio zgłoszonym postępie
+    invalidateTiles(mHorizon);
+
+    // potwierdzamy odbiór paczki, by harmonogram mógł przekazać kolejne
+    if (scheduler)
+        scheduler->segmentsConsumed();
+
+    update();
+}
+
+void GanttWidget::notifyProgress(uint time)
+{
+    if (mTasks.empty())
+        return;
+
+    const uint previousHorizon = mHorizon;
+
+    {
+        QWriteLocker locker(&mDataLock);
+        mHorizon = time;
+        mPyramid.finish(mHorizon);
+        mCorePyramid.finish(mHorizon);
+        ++mGeneration;
+    }
+
+    // oś czasu i znaczniki terminów sięgają do końca przebiegu
+    invalidateTiles(previousHorizon);
+
+    updateGanttSize();
+    update();
+}
+
+void GanttWidget::append(const alg::Segment &seg)
+{
+    mSegments.append(seg);
+    mPyramid.add(seg);
+
+    // wykonania zliczamy też w wierszu procesora, przekroczenia terminów dotyczą tylko zadań
+    if (mCores > 1 && seg.kind == alg::SegmentKind::TASK && seg.core < mCores)
+    {
+        alg::Segment core = seg;
+        core.task = seg.core;
+        mCorePyramid.add(core);
+    }
+}
+
+int GanttWidget::timePosition(uint time) const
+{
+    return toPixels(30 + time * timeWidth);
+}
+
+void GanttWidget::invalidateTiles(uint time)
+{
+    // kafelki przed podaną chwilą się nie zmieniły, usuwamy tylko te za nią,
+    // z zapasem na podpisy osi, komórki piramidy i znaczniki terminów
+    mPendingTiles.clear();
+    mTiles.removeIf([time](const TileKey &key)
+    {
+        return (key.x + 1) * tileSize > 30 + time * key.zoom - 50;
+    });
+}
+
+void GanttWidget::clear()
+{
+    if(mTasks.empty())
+        return;
+
+    {
+        QWriteLocker locker(&mDataLock);
+
+        // zwalniamy odcinki poprzedniego przebiegu
+        mSegments.reset(0);
+        mPyramid.reset(0);
+        mCorePyramid.reset(0);
+        mTasks.clear();
+        mCores = 1;
+        mReleaseMarkers = false;
+        mHorizon = 0;
+        ++mGeneration;
+    }
+
+    // kafelki poprzedniego przebiegu są już nieaktualne
+    mTilePool.clear();
+    mPendingTiles.clear();
+    mTiles.clear();
+
+    updateGanttSize();
+    update();
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include <QImage>
+#include <QReadWriteLock>
+#include <QThreadPool>
+#include <QWidget>
+
+#include "segmentarena.h"
+#include "trace.h"
+#include "tracepyramid.h"
+#include "tilecache.h"
+
+// deklaracje zapowiadające klas alg::Scheduler i alg::TraceView
+namespace alg
+{
+    class Scheduler;
+    class TraceView;
+}
+
+//! GanttWidget
+/*!
+Klasa reprezentuje widget wykresu Gantt'a.
+Obługuje ona rysowanie wykresu i skalowanie wykresu na podstawie
+przekazanych danych. Blokowanie zadania na zasobie (alg::SegmentKind::BLOCKED)
+rysowane jest węższym, zakreskowanym paskiem w wierszu zadania, a przełączanie kontekstu
+(alg::SegmentKind::SWITCH) szarym, kropkowanym paskiem w wierszach zadania i procesora.
+*/
+class GanttWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    //! Konstruktor
+    GanttWidget(QWidget *parent = nullptr);
+    //! Destruktor, czeka na zakończenie rysowania kafelków
+    ~GanttWidget();
+
+    //! Metoda rysująca wykres Gantt'a
+    /*!
+    Rysowane są tylko elementy przecinające odsłonięty prostokąt.
+    \param painter obiekt rysujący
+    \param exposed odsłonięty prostokąt we współrzędnych widgetu
+    */
+    void paint(QPainter *painter, const QRect &exposed) const;
+
+    //! Metoda przygotowuje wykres dla nowego przebiegu
+    /*!
+    Dla wielu procesorów pod wierszami zadań rysowane są wiersze procesorów P1..Pm,
+    z odcinkami w kolorach wykonywanych zadań.
+    \param tasks zadania symulacji, widget przechowuje ich kopię
+    \param cores liczba procesorów
+    */
+    void start(const std::vector<alg::Task>& tasks, uint cores = 1);
+
+    //! Funkcja wczytuje przebieg z pliku przebiegu
+    /*!
+    \param view plik przebiegu, np. zmapowany do pamięci przez QFile::map
+    \return false gdy któryś blok pliku jest uszkodzony, wczytana jest wtedy część przebiegu
+    */
+    bool load(const alg::TraceView& view);
+
+    //! Funkcja zwraca położenie chwili na osi czasu w pikselach, nasycone do QWIDGETSIZE_MAX
+    int timePosition(uint time) const;
+
+public slots:
+    //! Slot obługujący paczkę odcinków przebiegu (wykonania zadań i przekroczenia terminów)
+    void notifySegments(alg::Scheduler* scheduler, const std::vector<alg::Segment>& segments);
+    //! Slot obsługujący postęp symulacji, przebieg jest kompletny do podanej chwili
+    void notifyProgress(uint time);
+    //! Slot obługujący czyszczeie danych
+    void clear();
+
+protected:
+    //! Przeciążony event rysowania widgetu
+    void paintEvent(QPaintEvent *event);
+    //! Przeciążony event obługi kółka myszki
+    void wheelEvent(QWheelEvent *event);
+
+private slots:
+    //! Slot przyjmujący kafelek narysowany w tle
+    void tileReady(int generation, double zoom, int x, int y, const QImage &image);
+
+private:
+    class TileJob;
+
+    //! Rozmiar boku kafelka w pikselach
+    static const int tileSize = 256;
+
+    //! Funkcja zwraca rozmiar wykresu Gantt'a
+    QSize getGanttSize() const;
+    //! Funkcja zwraca liczbę wierszy wykresu, zadań i procesorów
+    int rows() const;
+    //! Metoda dodaje odcinek do magazynu i piramid, wywoływana pod blokadą danych
+    void append(const alg::Segment &seg);
+    //! Metoda dostosowuje minimalny rozmiar widgetu do wykresu, by paski przesuwania się dostosowały
+    void updateGanttSize();
+    //! Funkcja sprawdza czy zadanie przekroczyło termin w podanej chwili
+    bool isMiss(int taskId, double time) const;
+    //! Metoda rysuje znacznik zwolnienia (strzałka) i terminu (okrąg) instancji zadania
+    void paintRelease(QPainter *painter, int taskId, uint time, double zoom) const;
+    //! Metoda rysuje wypełnienie zadań z piramidy przebiegu, gdy cykl jest węższy niż piksel
+    void paintPyramid(QPainter *painter, double zoom, double firstTime, double lastTime, int firstRow, int lastRow) const;
+    //! Metoda rysująca wykres Gantt'a dla podanej szerokości jednostki czasu
+    /*!
+    Czyta tylko kopie danych przebiegu, więc może być wywołana z wątku rysującego kafelki.
+    */
+    void paint(QPainter *painter, const QRect &exposed, double zoom) const;
+    //! Metoda zleca narysowanie kafelka w tle, jeżeli nie został już zlecony
+    void requestTile(const TileKey &key);
+    //! Metoda zleca kafelki wokół widocznego obszaru
+    void prefetchTiles(const QRect &visible);
+    //! Metoda rysuje kafelek, wywoływana w puli wątków
+    void renderTile(const TileKey &key, int generation);
+    //! Metoda usuwa kafelki, które mogą się zmienić po podanej chwili
+    void invalidateTiles(uint time);
+    //! Funkcja zwraca najmniejszą szerokość cyklu, przy której cały przebieg mieści się w widocznym obszarze
+    double minTimeWidth() const;
+    //! Funkcja zwraca największą szerokość cyklu, przy której szerokość wykresu nie przekracza QWIDGETSIZE_MAX
+    double maxTimeWidth() const;
+
+    alg::SegmentArena mSegments; //!< odcinki przebiegu kolejnych zadań
+    alg::TracePyramid mPyramid; //!< piramida przebiegu do rysowania dużych przebiegów
+    alg::TracePyramid mCorePyramid; //!< piramida wykonań na kolejnych procesorach, gdy jest ich więcej niż jeden
+    std::vector<alg::Task> mTasks; //!< kopia zadań rysowanego przebiegu
+    uint mCores {1}; //!< liczba procesorów rysowanego przebiegu
+    bool mReleaseMarkers {false}; //!< czy zwolnienia rysowane są z odcinków zwolnień, a nie co okres
+    uint mHorizon {0}; //!< czas zakończenia rysowanego przebiegu
+    double scale {1.0}; //!< współczynnik skali wykresu
+    double timeWidth {2.0}; //!< szerokość jednostki czasu na wykrsie
+
+    TileCache mTiles; //!< narysowane kafelki
+    std::set<TileKey> mPendingTiles; //!< kafelki zlecone do narysowania
+    QThreadPool mTilePool; //!< wątki rysujące kafelki
+    mutable QReadWriteLock mDataLock; //!< blokada danych przebiegu czytanych przez wątki kafelków
+    int mGeneration {0}; //!< numer wersji danych przebiegu, zmieniany przy każdej zmianie
+};
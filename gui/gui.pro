@@ -0,0 +1,23 @@
+TEMPLATE = app
+TARGET = scheduler
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+HEADERS = mainwindow.h \
+          scheduler.h \
+          ganttwidget.h \
+          tilecache.h \
+          taskmodel.h
+
+SOURCES = main.cpp \
+          mainwindow.cpp \
+          scheduler.cpp \
+          ganttwidget.cpp \
+          tilecache.cpp \
+          taskmodel.cpp
+
+FORMS = mainwindow.ui
+
+INCLUDEPATH += $$PWD
+
+include(../core/core.pri)
@@ -0,0 +1,435 @@
+#include "mainwindow.h"
+#include <iostream> 
+#include <random>
+
+#include "ui_mainwindow.h"
+#include "analysis.h"
+#include <QScrollBar>
+#include <QHeaderView>
+#include <QMetaObject>
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+
+#include "tracefile.h"
+
+MainWindow::MainWindow(QWidget *parent) :
+    QMainWindow(parent),
+    ui(new Ui::MainWindow)
+{
+    //przygotowujemy elemty graficzne okna
+    ui->setupUi(this);
+    // ustawiomy tytuł okna
+    setWindowTitle("Symulacja");
+    // dodajemy nazwy algorytmów z rejestru polityk, opis algorytmu jest podpowiedzią pozycji
+    for (const alg::PolicyInfo &policy : alg::policies())
+    {
+        ui->comboBox->addItem(QString::fromStdString(policy.name));
+        ui->comboBox->setItemData(ui->comboBox->count() - 1, QString::fromStdString(policy.description), Qt::ToolTipRole);
+    }
+
+    // szeregowanie globalne lub heurystyki podziału zadań pomiędzy procesory
+    ui->modeComboBox->addItem("globalne");
+    for (alg::PartitionHeuristic heuristic : {alg::PartitionHeuristic::FIRST_FIT, alg::PartitionHeuristic::NEXT_FIT,
+                                              alg::PartitionHeuristic::BEST_FIT, alg::PartitionHeuristic::WORST_FIT})
+    {
+        for (bool decreasing : {true, false})
+        {
+            QString name = QString::fromStdString(alg::heuristicName(heuristic, decreasing));
+            ui->modeComboBox->addItem("podział " + name, name);
+        }
+    }
+
+    // serwery zadań aperiodycznych, pozycje przechowują rodzaj serwera
+    for (alg::ServerKind kind : {alg::ServerKind::NONE, alg::ServerKind::POLLING, alg::ServerKind::DEFERRABLE,
+                                 alg::ServerKind::SPORADIC})
+        ui->serverComboBox->addItem(alg::serverName(kind), static_cast<int>(kind));
+
+    // protokoły dostępu do zasobów, pozycje przechowują protokół
+    for (alg::ResourceProtocol protocol : {alg::ResourceProtocol::NONE, alg::ResourceProtocol::INHERITANCE,
+                                           alg::ResourceProtocol::CEILING})
+        ui->resourcesComboBox->addItem(alg::protocolName(protocol), static_cast<int>(protocol));
+
+    ui->spinBox->setValue(500);
+    // łączymy sygnały i sloty
+    connect(ui->pushButton, SIGNAL(clicked()), SLOT(runSimulation()));
+    connect(ui->cancelButton, SIGNAL(clicked()), SLOT(cancelSimulation()));
+    connect(ui->openTraceButton, SIGNAL(clicked()), SLOT(openTrace()));
+    connect(ui->pushButton_2, SIGNAL(clicked()), SLOT(randomTasks()));
+    connect(ui->pushButton_3,SIGNAL(clicked()), SLOT(insertTask()));
+    connect(ui->pushButton_4,SIGNAL(clicked()), SLOT(deleteTask()));
+    connect(ui->comboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateAnalysis()));
+    connect(ui->coresSpinBox, SIGNAL(valueChanged(int)), SLOT(updateAnalysis()));
+    connect(ui->serverComboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateAnalysis()));
+    connect(ui->switchCostSpinBox, SIGNAL(valueChanged(int)), SLOT(updateAnalysis()));
+
+    // tabela zadań pokazuje model, edytor tworzony jest tylko dla edytowanej komórki,
+    // a stała wysokość wierszy zwalnia widok z mierzenia każdego wiersza
+    ui->taskView->setModel(&mTaskModel);
+    ui->taskView->setItemDelegate(new TaskDelegate(ui->taskView));
+    ui->taskView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->taskView->verticalHeader()->setDefaultSectionSize(ui->taskView->fontMetrics().height() + 6);
+
+    // każda zmiana zadań odświeża wynik testów szeregowalności
+    connect(&mTaskModel, SIGNAL(dataChanged(QModelIndex,QModelIndex)), SLOT(updateAnalysis()));
+    connect(&mTaskModel, SIGNAL(rowsInserted(QModelIndex,int,int)), SLOT(updateAnalysis()));
+    connect(&mTaskModel, SIGNAL(rowsRemoved(QModelIndex,int,int)), SLOT(updateAnalysis()));
+    connect(&mTaskModel, SIGNAL(modelReset()), SLOT(updateAnalysis()));
+
+    // paczki odcinków przekazywane są z wątku symulacji
+    qRegisterMetaType<alg::Scheduler*>("alg::Scheduler*");
+    qRegisterMetaType<std::vector<alg::Segment>>("std::vector<alg::Segment>");
+    mSimulationThread.start();
+
+    // wstawimy przykładowe zadania
+    mTaskModel.setTasks({alg::Scheduler::Task(0, 80, 30, 80, 0), alg::Scheduler::Task(1, 120, 60, 120, 0)});
+}
+
+MainWindow::~MainWindow()
+{
+    // przerywamy trwającą symulację i czekamy na zakończenie wątku
+    if (mScheduler)
+        mScheduler->cancel();
+    mSimulationThread.quit();
+    mSimulationThread.wait();
+
+    delete ui;
+    delete mScheduler;
+}
+
+alg::MultiprocessorOptions MainWindow::multiprocessorOptions() const
+{
+    alg::MultiprocessorOptions options;
+    options.cores = static_cast<uint>(ui->coresSpinBox->value());
+
+    // pozycje heurystyk podziału przechowują ich skróty, szeregowanie globalne nie ma skrótu
+    QString heuristic = ui->modeComboBox->currentData().toString();
+    if (!heuristic.isEmpty() && alg::parseHeuristic(heuristic.toStdString(), options.heuristic, options.decreasing))
+        options.mode = alg::MultiprocessorMode::PARTITIONED;
+    return options;
+}
+
+alg::ServerOptions MainWindow::serverOptions() const
+{
+    alg::ServerOptions options;
+    options.kind = static_cast<alg::ServerKind>(ui->serverComboBox->currentData().toInt());
+    options.budget = ui->serverBudgetSpinBox->value();
+    options.period = ui->serverPeriodSpinBox->value();
+    return options;
+}
+
+alg::PolicyOptions MainWindow::policyOptions() const
+{
+    alg::PolicyOptions options;
+    options.quantum = ui->quantumSpinBox->value();
+    options.hysteresis = ui->hysteresisSpinBox->value();
+    options.sticky = ui->stickyCheckBox->isChecked();
+    options.switchCost = ui->switchCostSpinBox->value();
+    return options;
+}
+
+alg::Scheduler* MainWindow::createScheduler()
+{
+    // harmonogram tworzymy dla polityki z rejestru o nazwie wybranego algorytmu
+    const alg::PolicyInfo* policy = alg::findPolicy(ui->comboBox->currentText().toStdString());
+    if (!policy)
+        return nullptr;
+
+    return new alg::PolicyScheduler(*policy, multiprocessorOptions());
+}
+
+void MainWindow::runSimulation()
+{
+    // poprzedni harmonogram należy do wątku symulacji, więc usuwamy go w tym wątku
+    if (mScheduler)
+        mScheduler->deleteLater();
+    mScheduler = nullptr;
+
+    // tworzywy nowy harmonogram
+    mScheduler = createScheduler();
+    if (!mScheduler)
+    {
+        ui->widget->clear();
+        return;
+    }
+
+    // parsujemy tabelkę z zadanaimi i wpisujemy zadania do harmonogramu
+    updateTask(mScheduler);
+    mScheduler->setServerOptions(serverOptions());
+    mScheduler->setResourceProtocol(static_cast<alg::ResourceProtocol>(ui->resourcesComboBox->currentData().toInt()));
+    mScheduler->setPolicyOptions(policyOptions());
+
+    // przygotowujemy widget wykresu Gantt'a na nowy przebieg
+    ui->widget->start(mScheduler->tasks(), mScheduler->cores());
+    ui->statsTable->setRowCount(0);
+
+    // łączymy syganły i sloty pomiędzy harmonogramem a widgetem wykresu Gantt'a,
+    // harmonogram działa w innym wątku, więc sygnały trafią do kolejki zdarzeń okna
+    connect(mScheduler, SIGNAL(notifySegments(alg::Scheduler*, std::vector<alg::Segment>)), ui->widget, SLOT(notifySegments(alg::Scheduler*, std::vector<alg::Segment>)));
+    connect(mScheduler, SIGNAL(notifyProgress(uint)), ui->widget, SLOT(notifyProgress(uint)));
+    connect(mScheduler, SIGNAL(notifyProgress(uint)), SLOT(simulationProgress(uint)));
+    connect(mScheduler, SIGNAL(simulationFinished(uint, bool)), SLOT(simulationFinished(uint, bool)));
+
+    // pobieramy czas symulacji
+    uint time = static_cast<uint>(ui->spinBox->value());
+
+    ui->progressBar->setRange(0, ui->spinBox->value());
+    ui->progressBar->setValue(0);
+    ui->progressBar->setFormat("%p%");
+    ui->pushButton->setEnabled(false);
+    ui->cancelButton->setEnabled(true);
+
+    // uruchamimy symulację w wątku symulacji, przeskakując od zdarzenia do zdarzenia,
+    // przebieg i postęp przychodzą co ok. 1/200 czasu symulacji
+    mScheduler->moveToThread(&mSimulationThread);
+    QMetaObject::invokeMethod(mScheduler, "simulate", Qt::QueuedConnection,
+                              Q_ARG(uint, time), Q_ARG(uint, qMax(1u, time / 200)));
+}
+
+void MainWindow::cancelSimulation()
+{
+    if (mScheduler)
+        mScheduler->cancel();
+    ui->cancelButton->setEnabled(false);
+}
+
+void MainWindow::simulationProgress(uint time)
+{
+    ui->progressBar->setValue(static_cast<int>(time));
+
+    // przewijamy wykres tak, by była widoczna ostatnio zasymulowana chwila
+    if (ui->followCheckBox->isChecked())
+        ui->scrollArea->ensureVisible(ui->widget->x() + ui->widget->timePosition(time), ui->widget->y(), 50, 0);
+}
+
+void MainWindow::simulationFinished(uint time, bool cancelled)
+{
+    // wszystkie odcinki zostały już przekazane, przebieg jest kompletny do chwili time
+    ui->widget->notifyProgress(time);
+    simulationProgress(time);
+
+    if (cancelled)
+        ui->progressBar->setFormat(QString("przerwano w %1").arg(time));
+    else
+        ui->progressBar->setFormat("%p%");
+
+    // symulacja zakończyła się, więc jej statystyki nie są już zmieniane w wątku symulacji
+    showStats(mScheduler->stats());
+
+    // odłaczamy wszyskie sygnały połączone z widgetu wykresu Gantt'a
+    disconnect(mScheduler, nullptr, ui->widget, nullptr);
+    disconnect(mScheduler, nullptr, this, nullptr);
+
+    ui->pushButton->setEnabled(true);
+    ui->cancelButton->setEnabled(false);
+}
+
+void MainWindow::showStats(const alg::SimulationStats& stats)
+{
+    // serwer zadań aperiodycznych dostaje wiersz pod zadaniami
+    std::size_t rows = stats.tasks.size() + (stats.served ? 1 : 0);
+    ui->statsTable->setRowCount(static_cast<int>(rows));
+
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        const bool server = i == stats.tasks.size();
+        const alg::TaskStats &s = server ? stats.server : stats.tasks[i];
+        int row = static_cast<int>(i);
+
+        // percentyl i spóźnienie mają sens tylko dla zakończonych instancji
+        QString p99 = s.completed ? QString::number(s.responsePercentile(0.99)) : QString("-");
+        QString lateness = s.completed ? QString::number(s.maxLateness) : QString("-");
+
+        QStringList values;
+        values << (server ? QString("S") : "T" + QString::number(row + 1))
+               << QString::number(s.jobs)
+               << QString::number(s.misses)
+               << QString::number(s.maxResponse)
+               << QString::number(s.avgResponse(), 'f', 2)
+               << p99
+               << lateness
+               << QString::number(s.preemptions)
+               << QString::number(s.switches)
+               << QString::number(s.migrations)
+               << QString::number(s.blocked)
+               << QString::number(s.switching)
+               << QString::number(s.utilization(stats.horizon), 'f', 3);
+
+        for (int column = 0; column < values.size(); ++column)
+            ui->statsTable->setItem(row, column, new QTableWidgetItem(values[column]));
+    }
+
+    ui->statsTable->setToolTip(QString("Przekroczone terminy: %1\nWykorzystanie: %2\nWywłaszczenia: %3\nPrzełączenia: %4\nMigracje: %5\nBlokowanie: %6\n"
+                                       "Przełączanie kontekstu: %7 cykli, %8 czasu procesora\nProcesory: %9\nSystem %10")
+                               .arg(stats.misses())
+                               .arg(stats.utilization(), 0, 'f', 3)
+                               .arg(stats.preemptions())
+                               .arg(stats.switches())
+                               .arg(stats.migrations())
+                               .arg(stats.blocked())
+                               .arg(stats.switching())
+                               .arg(stats.switchOverhead(), 0, 'f', 3)
+                               .arg(stats.cores)
+                               .arg(stats.systemOk ? "sprawny" : "niesprawny"));
+}
+
+void MainWindow::updateTask( alg::Scheduler* scheduler)
+{
+    // sparwdzamy czy został przekazany harmonogram
+    if(!scheduler)
+        return;
+
+    // wstawimy zadania z tabeli do tablicy zadań w harmonogramie
+    scheduler->tasks() = readTasks();
+}
+
+const std::vector<alg::Scheduler::Task>& MainWindow::readTasks() const
+{
+    // zadania przechowywane są w modelu tabeli, więc nie trzeba niczego parsować
+    return mTaskModel.tasks();
+}
+
+void MainWindow::updateAnalysis()
+{
+    // sposób szeregowania ma znaczenie tylko dla wielu procesorów
+    ui->modeComboBox->setEnabled(ui->coresSpinBox->value() > 1);
+
+    // serwer zadań aperiodycznych działa tylko na jednym procesorze
+    bool server = ui->coresSpinBox->value() == 1;
+    ui->serverComboBox->setEnabled(server);
+    bool serverSettings = server && ui->serverComboBox->currentIndex() > 0;
+    ui->serverBudgetSpinBox->setEnabled(serverSettings);
+    ui->serverPeriodSpinBox->setEnabled(serverSettings);
+
+    // zasoby współdzielone przez procesory nie są modelowane
+    ui->resourcesComboBox->setEnabled(server);
+
+    // kwant i histereza dotyczą tylko polityk, które z nich korzystają
+    const alg::PolicyInfo* policy = alg::findPolicy(ui->comboBox->currentText().toStdString());
+    ui->quantumSpinBox->setEnabled(policy && policy->usesQuantum);
+    ui->hysteresisSpinBox->setEnabled(policy && policy->usesHysteresis);
+    ui->stickyCheckBox->setEnabled(policy && policy->usesSticky);
+
+    // testy dotyczą jednego procesora, dla wielu pokazujemy tylko wykorzystanie na procesor
+    if (ui->coresSpinBox->value() > 1)
+    {
+        double utilization = 0.0;
+        for (const alg::Task &t : readTasks())
+        {
+            if (t.period > 0)
+                utilization += static_cast<double>(t.time) / t.period;
+        }
+        ui->analysisLabel->setText(QString("U/m = %1").arg(utilization / ui->coresSpinBox->value(), 0, 'f', 3));
+        ui->analysisLabel->setToolTip("Testy szeregowalności dotyczą jednego procesora");
+        return;
+    }
+
+    // testy są szybkie, więc wykonujemy je przy każdej zmianie zadań lub algorytmu
+    alg::SchedulabilityReport report = alg::analyze(ui->comboBox->currentText().toStdString(), readTasks());
+
+    // testy nie uwzględniają kosztu przełączania kontekstu, więc ich wynik niczego wtedy nie przesądza
+    QString verdict = ui->switchCostSpinBox->value() > 0 ? QString("nieznany") : QString(alg::verdictName(report.verdict));
+    ui->analysisLabel->setText(QString("U = %1, %2")
+                               .arg(report.utilization, 0, 'f', 3)
+                               .arg(verdict));
+
+    // w podpowiedzi wyświetlamy wyniki poszczególnych testów
+    ui->analysisLabel->setToolTip(QString("Liu-Layland: %1\nHiperboliczny: %2\nCzas odpowiedzi: %3\nZapotrzebowanie procesora: %4")
+                                  .arg(alg::verdictName(report.liuLayland))
+                                  .arg(alg::verdictName(report.hyperbolic))
+                                  .arg(alg::verdictName(report.responseTime))
+                                  .arg(alg::verdictName(report.demand)));
+}
+
+void MainWindow::openTrace()
+{
+    // w trakcie symulacji wykres należy do niej
+    if (!ui->pushButton->isEnabled())
+        return;
+
+    QString path = QFileDialog::getOpenFileName(this, "Otwórz przebieg", QString(), "Przebiegi (*.trc);;Wszystkie pliki (*)");
+    if (path.isEmpty())
+        return;
+
+    // plik mapujemy do pamięci, bloki odcinków dekodowane są bezpośrednio z mapowania
+    QFile file(path);
+    uchar *data = nullptr;
+    if (file.open(QIODevice::ReadOnly) && file.size() > 0)
+        data = file.map(0, file.size());
+    if (!data)
+    {
+        QMessageBox::warning(this, "Otwórz przebieg", "Nie można odczytać pliku " + path);
+        return;
+    }
+
+    alg::TraceView view;
+    std::string error;
+    if (!view.open(data, static_cast<std::size_t>(file.size()), error))
+    {
+        file.unmap(data);
+        QMessageBox::warning(this, "Otwórz przebieg", path + ": " + QString::fromStdString(error));
+        return;
+    }
+
+    // poprzedni harmonogram nie jest już potrzebny, usuwamy go w wątku symulacji
+    if (mScheduler)
+        mScheduler->deleteLater();
+    mScheduler = nullptr;
+
+    // zadania i algorytm z nagłówka wpisujemy do okna, by można było powtórzyć symulację
+    mTaskModel.setTasks(view.tasks());
+    int index = ui->comboBox->findText(QString::fromStdString(view.policy()));
+    if (index >= 0)
+        ui->comboBox->setCurrentIndex(index);
+    ui->coresSpinBox->setValue(static_cast<int>(view.cores()));
+    ui->spinBox->setValue(static_cast<int>(qMin<uint>(view.horizon(), static_cast<uint>(ui->spinBox->maximum()))));
+    updateAnalysis();
+
+    if (!ui->widget->load(view))
+        QMessageBox::warning(this, "Otwórz przebieg", path + ": plik jest uszkodzony, wczytano tylko część przebiegu");
+
+    file.unmap(data);
+}
+
+void MainWindow::randomTasks()
+{
+    // inicjalizujemy generatory liczb psudolosowych
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> disTaskCount(1, 9);
+    std::uniform_int_distribution<> disTime(1, 100);
+    std::uniform_int_distribution<> disPrioryty(0, 9);
+
+    // losujemy liczbę zadań
+    int taskCount = disTaskCount(gen);
+    std::vector<alg::Scheduler::Task> tasks;
+    tasks.reserve(static_cast<std::size_t>(taskCount));
+
+    // dla kolejnych zadań losujemy parametry zdania
+    for(int i = 0; i < taskCount; i++)
+    {
+        int time = disTime(gen);
+        int prioryty = disPrioryty(gen);
+
+        std::uniform_int_distribution<> disPeriod(time+10, time+50);
+        int period = disPeriod(gen);
+
+        tasks.emplace_back(i, period, time, period, prioryty);
+    }
+
+    // tabelę zastępujemy jednym powiadomieniem widoku
+    mTaskModel.setTasks(std::move(tasks));
+}
+
+void MainWindow::insertTask()
+{
+    // nowe zadanie ma wszystkie parametry równe 1, tak jak dawniej
+    int row = static_cast<int>(mTaskModel.tasks().size());
+    mTaskModel.appendTasks({alg::Scheduler::Task(row, 1, 1, 1, 1)});
+}
+
+void MainWindow::deleteTask()
+{
+    mTaskModel.removeLast();
+}
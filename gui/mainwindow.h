@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QMainWindow>
+#include <QThread>
+#include <vector>
+#include "scheduler.h"
+#include "taskmodel.h"
+
+// deklaracja zapowiadajaća klasy Ui::MainWindow
+namespace Ui
+{
+class MainWindow;
+}
+
+//! MainWindow
+/*!
+Klasa okienka.
+*/
+class MainWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    //! Konstruktor
+    explicit MainWindow(QWidget *parent = nullptr);
+    //! Destruktor
+    ~MainWindow();
+
+private:
+    //!Funkcja zwraca wybraną liczbę procesorów i sposób szeregowania
+    alg::MultiprocessorOptions multiprocessorOptions() const;
+    //! Funkcja zwraca ustawienia serwera zadań aperiodycznych z kontrolek okna
+    alg::ServerOptions serverOptions() const;
+    //! Funkcja zwraca parametry polityki szeregowania z kontrolek okna
+    alg::PolicyOptions policyOptions() const;
+    //!Funckcja tworzy odpowiedni harmonogram w zależności od wybranego algorytmu
+    alg::Scheduler* createScheduler();
+    //!Metoda kopiuje zadania z tabelki do harmonogramu
+    void updateTask( alg::Scheduler* scheduler);
+    //!Funkcja zwraca zadania z tabelki
+    const std::vector<alg::Scheduler::Task>& readTasks() const;
+    //!Metoda wypełnia tabelę statystyk zadań
+    void showStats(const alg::SimulationStats& stats);
+
+    Ui::MainWindow* ui; //!< Wskażnik na klasę zwierającą elemty graficzne okienka
+    alg::Scheduler* mScheduler { nullptr };  //!< Wskażni na aktualnie wykorzystywany harmonogram
+    QThread mSimulationThread;               //!< Wątek, w którym działa symulacja
+    TaskModel mTaskModel;                    //!< Zadania wyświetlane w tabeli
+
+private slots:
+    //! Metoda wywołująca symulację w wątku symulacji
+    void runSimulation();
+    //! Metoda przerywająca symulację
+    void cancelSimulation();
+    //! Metoda aktualizuje pasek postępu i przewija wykres za symulacją
+    void simulationProgress(uint time);
+    //! Metoda wywoływana po zakończeniu lub przerwaniu symulacji
+    void simulationFinished(uint time, bool cancelled);
+    //! Metoda lozuje zadania
+    void randomTasks();
+    //! Metoda dodają zadanie do tabeli
+    void insertTask();
+    //! Metoda usuwająca ostatnie zadanie w tabeli
+    void deleteTask();
+    //! Metoda wyświetla wynik testów szeregowalności dla zadań z tabeli
+    void updateAnalysis();
+    //! Metoda wczytuje przebieg z pliku przebiegu i wyświetla go na wykresie
+    void openTrace();
+};
@@ -0,0 +1,97 @@
+#include "scheduler.h"
+
+namespace alg
+{
+    //! Konstruktor
+    Scheduler::Scheduler(std::unique_ptr<SchedulerEngine> engine)
+        : mEngine(std::move(engine))
+    {
+        mEngine->setTraceSink(this);
+        mEngine->setCancelToken(&mCancel);
+    }
+
+    //! Destruktor domyśny
+    Scheduler::~Scheduler() = default;
+
+    void Scheduler::schedule(uint endTime)
+    {
+        run(endTime, false);
+    }
+
+    void Scheduler::scheduleEvents(uint endTime)
+    {
+        run(endTime, true);
+    }
+
+    void Scheduler::run(uint endTime, bool events)
+    {
+        // powtórzeń hiperokresu nie rozliczamy, więc kolektor dostaje wszystkie odcinki razem z wykresem
+        mCollector.reset(new StatsCollector(mEngine->tasks));
+
+        if (events)
+            mEngine->scheduleEvents(endTime);
+        else
+            mEngine->schedule(endTime);
+
+        mStats = mCollector->stats(mEngine->currentTime());
+        mStats.cores = mEngine->cores();
+        mStats.systemOk = mEngine->systemOk();
+        mStats.locking = mEngine->locking();
+        mStats.switchCost = static_cast<uint>(std::max(mEngine->policyOptions().switchCost, 0));
+        if (mEngine->serving())
+            collectServerStats(mStats, mEngine->tasks);
+        mCollector.reset();
+    }
+
+    bool Scheduler::nextTick(bool print)
+    {
+        return mEngine->nextTick(print);
+    }
+
+    int Scheduler::getBestTaskId() const
+    {
+        return mEngine->getBestTaskId();
+    }
+
+    void Scheduler::simulate(uint endTime, uint chunk)
+    {
+        mEngine->setChunk(chunk);
+        mThrottle = true;
+        run(endTime, true);
+        mThrottle = false;
+        mEngine->setChunk(0);
+
+        emit simulationFinished(mEngine->currentTime(), mEngine->cancelled());
+    }
+
+    void Scheduler::cancel()
+    {
+        mCancel = true;
+        // zwalniamy symulację czekającą na potwierdzenie paczek
+        mPendingBatches.release(maxPendingBatches);
+    }
+
+    void Scheduler::segmentsConsumed()
+    {
+        // odbiorca potwierdza też paczki z symulacji wywołanych bezpośrednio, nie przekraczamy limitu
+        if (mPendingBatches.available() < maxPendingBatches)
+            mPendingBatches.release();
+    }
+
+    void Scheduler::consume(const Segment* segments, std::size_t count)
+    {
+        // gdy odbiorca w innym wątku nie nadąża, czekamy aż potwierdzi wcześniejsze paczki
+        if (mThrottle && !mCancel)
+            mPendingBatches.acquire();
+
+        if (mCollector)
+            mCollector->consume(segments, count);
+
+        emit notifySegments(this, std::vector<Segment>(segments, segments + count));
+    }
+
+    void Scheduler::progress(uint time)
+    {
+        emit notifyProgress(time);
+    }
+}
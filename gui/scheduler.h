@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QMetaType>
+#include <QObject>
+#include <QSemaphore>
+
+#include "basicscheduler.h"
+#include "multiprocessor.h"
+#include "registry.h"
+#include "simulation.h"
+
+namespace alg
+{
+    //! Harmonogram
+    /*!
+    Klasa abstrakcyjna harmonogramu.
+    Zawiera metody i funkcje pozwalające na symulowanie działania alogrytmów szeregowania
+    zadań.
+
+    Jest cienką nakładką Qt na silnik BasicScheduler (lub GlobalScheduler i PartitionedScheduler
+    dla wielu procesorów), który wykonuje całą symulację i przekazuje przebieg w paczkach
+    odcinków przez interfejs TraceSink.
+    Nakładka wysyła każdą paczkę jednym sygnałem notifySegments().
+
+    Obiekt może zostać przeniesiony do osobnego wątku i uruchomiony slotem simulate().
+    Przebieg przekazywany jest wtedy fragmentami razem z postępem, a symulację
+    można przerwać metodą cancel() z dowolnego wątku.
+
+    W trakcie symulacji te same paczki odcinków trafiają do StatsCollector,
+    a statystyki zadań dostępne są po jej zakończeniu przez stats().
+    */
+    class Scheduler: public QObject, private TraceSink
+    {
+        Q_OBJECT
+    public:
+        // zadanie przeniesione do task.h, zostawiamy starą nazwę
+        using Task = alg::Task;
+
+        //! Destruktor
+        virtual ~Scheduler();
+
+        //! Metoda symulująca działanie harmonogramu
+        /*!
+        \param endTime czas zakończenia symulacji
+        */
+        void schedule(uint endTime);
+
+        //! Metoda symulująca działanie harmonogramu sterowana zdarzeniami
+        /*!
+        Zamiast symulować każdy cykl osobno, przeskakuje od razu do najbliższego zdarzenia
+        (zwolnienie zadania, termin, zakończenie zadania, zmiana kolejności swobód w LLF)
+        i rozlicza cały odcinek jednocześnie. Koszt zależy od liczby zdarzeń, a nie od czasu symulacji.
+        \param endTime czas zakończenia symulacji
+        */
+        void scheduleEvents(uint endTime);
+
+        //! Metoda przerywa symulację na najbliższej granicy fragmentu
+        /*!
+        Może być wywołana z dowolnego wątku.
+        */
+        void cancel();
+
+        //! Metoda potwierdza odebranie paczki odcinków
+        /*!
+        Harmonogram wstrzymuje symulację, gdy odbiorca nie nadąża z paczkami,
+        więc każda paczka z notifySegments() musi zostać potwierdzona.
+        */
+        void segmentsConsumed();
+
+        //! Funkcja sprawdza czy możliwe jest zasymulowanie kolejnego cyklu
+        /*!
+        \param print czy wypisać informacje na konsole
+        */
+        bool nextTick(bool print = true);
+
+        //! Funkcja zawraca id zadania z tablicy (std::vector)
+        /*!
+        Wybór najlepszego zadania odbywa się zgodnie z przyjętym algorytmem.
+        Zadanie odczytywane jest z kolejki zadań gotowych w czasie O(1).
+        */
+        int getBestTaskId() const;
+
+        //! Funkcja virtualna porównująca dwa zadania i dokonująca
+        //! wyboru najlepszego według zdefinowanego kryterium
+        /*!
+        Nie jest wywoływana w pętli symulacji, silnik korzysta bezpośrednio z polityki.
+        \param a pierwsze zadanie do porównania
+        \param b drugie zadanie do porównania
+        */
+        virtual bool getTaskPriority(const Task& a, const Task& b) const = 0;
+
+        //! Funkcja zwraca akttualny czas symulacji
+        uint currentTime() const { return mEngine->currentTime(); }
+
+        //! Funkcja zwraca statystyki ostatniej symulacji
+        /*!
+        Po simulate() statystyki można odczytać z innego wątku po odebraniu sygnału simulationFinished().
+        Dla przerwanej symulacji obejmują czas do chwili przerwania.
+        */
+        const SimulationStats& stats() const { return mStats; }
+
+        //! Funkcja zwraca liczbę procesorów
+        uint cores() const { return mEngine->cores(); }
+
+        //! Metoda ustawia serwer zadań aperiodycznych (SchedulerEngine::setServerOptions())
+        void setServerOptions(const ServerOptions& options) { mEngine->setServerOptions(options); }
+
+        //! Funkcja zwraca czy harmonogram obsługuje serwer zadań aperiodycznych
+        bool serverSupported() const { return mEngine->serverSupported(); }
+
+        //! Metoda ustawia protokół dostępu do zasobów (SchedulerEngine::setResourceProtocol())
+        void setResourceProtocol(ResourceProtocol protocol) { mEngine->setResourceProtocol(protocol); }
+
+        //! Metoda ustawia parametry polityki, np. kwant RR lub koszt przełączenia kontekstu (SchedulerEngine::setPolicyOptions())
+        void setPolicyOptions(const PolicyOptions& options) { mEngine->setPolicyOptions(options); }
+
+        //! Funkcja zwraca ilość zadań
+        int tasksSize() const { return static_cast<int>(mEngine->tasks.size()); }
+
+        //! Funkcja zwraca tablicę zadań
+        std::vector<Task>& tasks() { return mEngine->tasks; }
+        //! Funkcja zwraca tablicę zadań
+        const std::vector<Task>& tasks() const { return mEngine->tasks; }
+
+    public slots:
+        //! Slot wykonujący symulację sterowaną zdarzeniami podzieloną na fragmenty
+        /*!
+        \param endTime czas zakończenia symulacji
+        \param chunk rozmiar fragmentu, po którym przekazywany jest postęp
+        */
+        void simulate(uint endTime, uint chunk);
+
+    signals:
+        //! Sygnał z kolejną paczką odcinków przebiegu symulacji
+        void notifySegments(alg::Scheduler* scheduler, const std::vector<alg::Segment>& segments);
+        //! Sygnał z postępem symulacji, odcinki przed tą chwilą zostały już wysłane
+        void notifyProgress(uint time);
+        //! Sygnał zakończenia symulacji uruchomionej slotem simulate()
+        void simulationFinished(uint time, bool cancelled);
+
+    protected:
+        //! Konstruktor
+        /*!
+        \param engine silnik wykonujący symulację
+        */
+        explicit Scheduler(std::unique_ptr<SchedulerEngine> engine);
+
+    private:
+        //! Metoda uruchamia silnik i zbiera statystyki symulacji
+        void run(uint endTime, bool events);
+        //! Metoda interfejsu TraceSink zamieniająca paczkę odcinków na sygnał
+        void consume(const Segment* segments, std::size_t count) override;
+        //! Metoda interfejsu TraceSink zamieniająca postęp na sygnał
+        void progress(uint time) override;
+
+        //! Największa liczba niepotwierdzonych paczek odcinków
+        static const int maxPendingBatches = 64;
+
+        std::unique_ptr<SchedulerEngine> mEngine; //!< silnik harmonogramu
+        std::unique_ptr<StatsCollector> mCollector; //!< statystyki trwającej symulacji
+        SimulationStats mStats;                   //!< statystyki ostatniej symulacji
+        std::atomic<bool> mCancel {false};        //!< flaga przerwania symulacji
+        std::atomic<bool> mThrottle {false};      //!< czy symulacja czeka na potwierdzenia paczek
+        QSemaphore mPendingBatches {maxPendingBatches}; //!< wolne miejsca na niepotwierdzone paczki
+    };
+
+    //! Harmonogram z polityką
+    /*!
+    Klasa łącząca nakładkę Scheduler z silnikiem polityki z rejestru (policies())
+    dla podanej liczby procesorów. Przeciąża funkcję getTaskPriority().
+    */
+    class PolicyScheduler : public Scheduler
+    {
+    public:
+        //! Konstruktor
+        /*!
+        \param policy polityka z rejestru
+        \param options liczba procesorów i sposób szeregowania, domyślnie jeden procesor
+        */
+        explicit PolicyScheduler(const PolicyInfo& policy, const MultiprocessorOptions& options = MultiprocessorOptions())
+            : Scheduler(policy.create(options)), mHigher(policy.higher)
+        {}
+
+        //! Przeciążona funkcja porównująca dwa zadania zgodnie z polityką
+        bool getTaskPriority(const Task& a, const Task& b) const override
+        {
+            return mHigher(a, b);
+        }
+
+    private:
+        bool (*mHigher)(const Task&, const Task&); //!< porównanie zadań polityki
+    };
+}
+
+// paczki odcinków przekazywane są pomiędzy wątkami
+Q_DECLARE_METATYPE(std::vector<alg::Segment>)
@@ -0,0 +1,271 @@
+#include "taskmodel.h"
+
+#include <QComboBox>
+#include <QLineEdit>
+#include <QSpinBox>
+
+#include "taskio.h"
+
+TaskModel::TaskModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void TaskModel::setTasks(std::vector<alg::Task> tasks)
+{
+    beginResetModel();
+    mTasks = std::move(tasks);
+    for (std::size_t i = 0; i < mTasks.size(); ++i)
+        mTasks[i].index = static_cast<int>(i);
+    endResetModel();
+}
+
+void TaskModel::appendTasks(const std::vector<alg::Task>& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    const int first = static_cast<int>(mTasks.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(tasks.size()) - 1);
+    mTasks.insert(mTasks.end(), tasks.begin(), tasks.end());
+    for (std::size_t i = static_cast<std::size_t>(first); i < mTasks.size(); ++i)
+        mTasks[i].index = static_cast<int>(i);
+    endInsertRows();
+}
+
+void TaskModel::removeLast()
+{
+    if (mTasks.empty())
+        return;
+
+    const int last = static_cast<int>(mTasks.size()) - 1;
+    beginRemoveRows(QModelIndex(), last, last);
+    mTasks.pop_back();
+    endRemoveRows();
+}
+
+void TaskModel::range(int column, int& minimum, int& maximum)
+{
+    // te same zakresy co w dawnych walidatorach pól tabeli
+    minimum = column == PRIORITY || column == OFFSET || column == JITTER ? 0 : 1;
+    maximum = column == PRIORITY ? 100 : 1000;
+    if (column == ARRIVAL)
+    {
+        minimum = static_cast<int>(alg::Arrival::PERIODIC);
+        maximum = static_cast<int>(alg::Arrival::APERIODIC);
+    }
+}
+
+QString TaskModel::arrivalName(alg::Arrival arrival)
+{
+    switch (arrival)
+    {
+    case alg::Arrival::SPORADIC:
+        return "sporadyczne";
+    case alg::Arrival::APERIODIC:
+        return "aperiodyczne";
+    default:
+        return "okresowe";
+    }
+}
+
+int TaskModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(mTasks.size());
+}
+
+int TaskModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : COLUMNS;
+}
+
+QVariant TaskModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole))
+        return QVariant();
+
+    const alg::Task &t = mTasks[static_cast<std::size_t>(index.row())];
+    switch (index.column())
+    {
+    case INDEX:
+        return "T" + QString::number(index.row() + 1);
+    case TIME:
+        return t.time;
+    case PERIOD:
+        return t.period;
+    case DEADLINE:
+        return t.deadline;
+    case PRIORITY:
+        return t.prioryty;
+    case OFFSET:
+        return t.offset;
+    case JITTER:
+        return t.jitter;
+    case ARRIVAL:
+        if (role == Qt::EditRole)
+            return static_cast<int>(t.arrival);
+        return arrivalName(t.arrival);
+    case SECTIONS:
+        return QString::fromStdString(alg::formatSections(t.sections));
+    default:
+        return QVariant();
+    }
+}
+
+bool TaskModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || index.column() == INDEX)
+        return false;
+
+    // niepoprawne sekcje lub sekcje wychodzące poza czas przetwarzania odrzucamy
+    if (index.column() == SECTIONS)
+    {
+        alg::Task changed = mTasks[static_cast<std::size_t>(index.row())];
+        if (!alg::parseSections(value.toString().toStdString(), changed.sections) || !alg::validSections(changed))
+            return false;
+
+        mTasks[static_cast<std::size_t>(index.row())].sections = std::move(changed.sections);
+        emit dataChanged(index, index);
+        return true;
+    }
+
+    // wartości spoza zakresu kolumny odrzucamy, tak jak dawne walidatory pól
+    bool ok;
+    int number = value.toInt(&ok);
+    int minimum, maximum;
+    range(index.column(), minimum, maximum);
+    if (!ok || number < minimum || number > maximum)
+        return false;
+
+    alg::Task &t = mTasks[static_cast<std::size_t>(index.row())];
+    if (index.column() == ARRIVAL)
+    {
+        if (t.arrival == static_cast<alg::Arrival>(number))
+            return true;
+        t.arrival = static_cast<alg::Arrival>(number);
+        emit dataChanged(index, index);
+        return true;
+    }
+
+    // krótszy czas przetwarzania nie może uciąć sekcji krytycznych
+    if (index.column() == TIME)
+    {
+        alg::Task changed = t;
+        changed.time = number;
+        if (!alg::validSections(changed))
+            return false;
+    }
+
+    int &field = index.column() == TIME ? t.time : index.column() == PERIOD ? t.period
+               : index.column() == DEADLINE ? t.deadline : index.column() == OFFSET ? t.offset
+               : index.column() == JITTER ? t.jitter : t.prioryty;
+    if (field == number)
+        return true;
+
+    field = number;
+    emit dataChanged(index, index);
+    return true;
+}
+
+QVariant TaskModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section)
+    {
+    case INDEX:
+        return "Lp";
+    case TIME:
+        return "Czas prztwarzania";
+    case PERIOD:
+        return "Okres";
+    case DEADLINE:
+        return "Termin";
+    case PRIORITY:
+        return "Piorytet";
+    case OFFSET:
+        return "Przesunięcie";
+    case JITTER:
+        return "Jitter";
+    case ARRIVAL:
+        return "Zwalnianie";
+    case SECTIONS:
+        return "Sekcje krytyczne";
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags TaskModel::flags(const QModelIndex &index) const
+{
+    Qt::ItemFlags flags = QAbstractTableModel::flags(index);
+    if (index.isValid() && index.column() != INDEX)
+        flags |= Qt::ItemIsEditable;
+    return flags;
+}
+
+TaskDelegate::TaskDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QWidget* TaskDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &, const QModelIndex &index) const
+{
+    // edytor istnieje tylko w trakcie edycji jednej komórki
+    if (index.column() == TaskModel::ARRIVAL)
+    {
+        QComboBox *combo = new QComboBox(parent);
+        combo->setFrame(false);
+        for (alg::Arrival arrival : {alg::Arrival::PERIODIC, alg::Arrival::SPORADIC, alg::Arrival::APERIODIC})
+            combo->addItem(TaskModel::arrivalName(arrival));
+        return combo;
+    }
+    if (index.column() == TaskModel::SECTIONS)
+    {
+        QLineEdit *line = new QLineEdit(parent);
+        line->setFrame(false);
+        line->setPlaceholderText("R1:0:2 R2:1:1");
+        return line;
+    }
+
+    QSpinBox *editor = new QSpinBox(parent);
+    editor->setFrame(false);
+    int minimum, maximum;
+    TaskModel::range(index.column(), minimum, maximum);
+    editor->setRange(minimum, maximum);
+    return editor;
+}
+
+void TaskDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    if (index.column() == TaskModel::ARRIVAL)
+    {
+        static_cast<QComboBox*>(editor)->setCurrentIndex(index.data(Qt::EditRole).toInt());
+        return;
+    }
+    if (index.column() == TaskModel::SECTIONS)
+    {
+        static_cast<QLineEdit*>(editor)->setText(index.data(Qt::EditRole).toString());
+        return;
+    }
+    static_cast<QSpinBox*>(editor)->setValue(index.data(Qt::EditRole).toInt());
+}
+
+void TaskDelegate::setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const
+{
+    if (index.column() == TaskModel::ARRIVAL)
+    {
+        model->setData(index, static_cast<QComboBox*>(editor)->currentIndex(), Qt::EditRole);
+        return;
+    }
+    if (index.column() == TaskModel::SECTIONS)
+    {
+        model->setData(index, static_cast<QLineEdit*>(editor)->text(), Qt::EditRole);
+        return;
+    }
+
+    QSpinBox *spinBox = static_cast<QSpinBox*>(editor);
+    spinBox->interpretText();
+    model->setData(index, spinBox->value(), Qt::EditRole);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QStyledItemDelegate>
+
+#include "task.h"
+
+//! Model tabeli zadań
+/*!
+Przechowuje zadania bezpośrednio w tablicy std::vector<alg::Task>, więc symulacja
+i testy szeregowalności czytają je funkcją tasks() bez odczytywania tekstu z komórek.
+Widok tworzy tylko edytor aktualnie edytowanej komórki (TaskDelegate), a nie widgety
+dla każdego wiersza, więc tabela z setkami tysięcy zadań wczytuje się od razu.
+
+Kolumny: numer zadania, czas przetwarzania, okres, termin, priorytet, przesunięcie
+pierwszego zwolnienia, jitter, rodzaj zwalniania (alg::Arrival) i sekcje krytyczne
+zapisane tekstem jak w pliku zadań (alg::parseSections()).
+Id zadania jest zawsze równe numerowi wiersza.
+*/
+class TaskModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    //! Kolumny tabeli
+    enum Column
+    {
+        INDEX,    //!< numer zadania, tylko do odczytu
+        TIME,     //!< czas przetwarzania
+        PERIOD,   //!< okres
+        DEADLINE, //!< termin
+        PRIORITY, //!< priorytet
+        OFFSET,   //!< przesunięcie pierwszego zwolnienia
+        JITTER,   //!< jitter zwolnień
+        ARRIVAL,  //!< rodzaj zwalniania, w roli edycji numer wartości alg::Arrival
+        SECTIONS, //!< sekcje krytyczne, np. R1:0:2 R2:1:1
+        COLUMNS   //!< liczba kolumn
+    };
+
+    //! Konstruktor
+    explicit TaskModel(QObject *parent = nullptr);
+
+    //! Funkcja zwraca zadania z tabeli
+    const std::vector<alg::Task>& tasks() const { return mTasks; }
+
+    //! Metoda zastępuje wszystkie zadania, widok przebudowywany jest jednorazowo
+    void setTasks(std::vector<alg::Task> tasks);
+
+    //! Metoda dopisuje zadania na końcu tabeli jednym powiadomieniem widoku
+    void appendTasks(const std::vector<alg::Task>& tasks);
+
+    //! Metoda usuwa ostatnie zadanie
+    void removeLast();
+
+    //! Funkcja zwraca najmniejszą i największą wartość kolumny
+    static void range(int column, int& minimum, int& maximum);
+
+    //! Funkcja zwraca nazwę rodzaju zwalniania
+    static QString arrivalName(alg::Arrival arrival);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+private:
+    std::vector<alg::Task> mTasks; //!< zadania kolejnych wierszy
+};
+
+//! Edytor komórek tabeli zadań
+/*!
+Tworzy pole liczbowe z zakresem kolumny z TaskModel::range(), dla rodzaju zwalniania
+listę wyboru, a dla sekcji krytycznych pole tekstowe, tylko na czas edycji komórki.
+*/
+class TaskDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    //! Konstruktor
+    explicit TaskDelegate(QObject *parent = nullptr);
+
+    QWidget* createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const override;
+};
@@ -0,0 +1,64 @@
+#include "tilecache.h"
+
+#include <iterator>
+
+TileCache::TileCache(std::size_t capacity)
+    : mCapacity(capacity)
+{
+}
+
+const QImage* TileCache::find(const TileKey& key)
+{
+    auto it = mIndex.find(key);
+    if (it == mIndex.end())
+        return nullptr;
+
+    // przenosimy kafelek na początek listy, bez kopiowania obrazu
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return &it->second->second;
+}
+
+void TileCache::insert(const TileKey& key, const QImage& image)
+{
+    auto it = mIndex.find(key);
+    if (it != mIndex.end())
+        erase(it->second);
+
+    mEntries.emplace_front(key, image);
+    mIndex[key] = mEntries.begin();
+    mBytes += imageBytes(image);
+
+    evict();
+}
+
+void TileCache::clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+    mBytes = 0;
+}
+
+void TileCache::setCapacity(std::size_t capacity)
+{
+    mCapacity = capacity;
+    evict();
+}
+
+TileCache::Iterator TileCache::erase(Iterator it)
+{
+    mBytes -= imageBytes(it->second);
+    mIndex.erase(it->first);
+    return mEntries.erase(it);
+}
+
+void TileCache::evict()
+{
+    // ostatnio wstawiony kafelek zostaje nawet gdy sam przekracza limit
+    while (mBytes > mCapacity && mEntries.size() > 1)
+        erase(std::prev(mEntries.end()));
+}
+
+std::size_t TileCache::imageBytes(const QImage& image)
+{
+    return static_cast<std::size_t>(image.bytesPerLine()) * static_cast<std::size_t>(image.height());
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+
+#include <QImage>
+
+//! Klucz kafelka wykresu
+struct TileKey
+{
+    double zoom; //!< szerokość jednostki czasu, dla której narysowano kafelek
+    int x;       //!< numer kolumny kafelka
+    int y;       //!< numer wiersza kafelka
+
+    //! Operator porządku potrzebny do wyszukiwania kafelków
+    bool operator<(const TileKey& other) const
+    {
+        if (zoom != other.zoom)
+            return zoom < other.zoom;
+        if (x != other.x)
+            return x < other.x;
+        return y < other.y;
+    }
+};
+
+//! Pamięć podręczna kafelków wykresu
+/*!
+Przechowuje narysowane kafelki do łącznego rozmiaru capacity() bajtów.
+Po przekroczeniu limitu usuwane są kafelki najdawniej używane (LRU).
+Klasa nie jest synchronizowana, korzysta z niej tylko wątek okna.
+*/
+class TileCache
+{
+public:
+    //! Konstruktor
+    /*!
+    \param capacity limit pamięci w bajtach
+    */
+    explicit TileCache(std::size_t capacity = 64u << 20);
+
+    //! Funkcja zwraca kafelek i oznacza go jako ostatnio używany lub nullptr, gdy go nie ma
+    const QImage* find(const TileKey& key);
+
+    //! Funkcja sprawdza czy kafelek jest w pamięci, nie zmieniając kolejności użycia
+    bool contains(const TileKey& key) const { return mIndex.count(key) != 0; }
+
+    //! Metoda wstawia lub zastępuje kafelek, usuwając w razie potrzeby najdawniej używane
+    void insert(const TileKey& key, const QImage& image);
+
+    //! Metoda usuwa kafelki spełniające warunek
+    template <typename Predicate>
+    void removeIf(Predicate predicate)
+    {
+        for (auto it = mEntries.begin(); it != mEntries.end();)
+        {
+            if (predicate(it->first))
+                it = erase(it);
+            else
+                ++it;
+        }
+    }
+
+    //! Metoda usuwa wszystkie kafelki
+    void clear();
+
+    //! Funkcja zwraca zajętą pamięć w bajtach
+    std::size_t bytes() const { return mBytes; }
+
+    //! Funkcja zwraca limit pamięci w bajtach
+    std::size_t capacity() const { return mCapacity; }
+
+    //! Metoda zmienia limit pamięci
+    void setCapacity(std::size_t capacity);
+
+private:
+    using Entry = std::pair<TileKey, QImage>;
+    using Iterator = std::list<Entry>::iterator;
+
+    //! Funkcja usuwa kafelek i zwraca iterator na następny
+    Iterator erase(Iterator it);
+    //! Metoda usuwa najdawniej używane kafelki, aż zmieszczą się w limicie
+    void evict();
+    //! Funkcja zwraca rozmiar obrazu w bajtach
+    static std::size_t imageBytes(const QImage& image);
+
+    std::list<Entry> mEntries;            //!< kafelki od ostatnio używanego
+    std::map<TileKey, Iterator> mIndex;   //!< indeks kafelków według klucza
+    std::size_t mBytes {0};               //!< zajęta pamięć
+    std::size_t mCapacity;                //!< limit pamięci
+};
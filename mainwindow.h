@@ -1,46 +0,0 @@
-#pragma once
-
-#include <QMainWindow>
-#include "scheduler.h"
-
-// deklaracja zapowiadajaa klasy Ui::MainWindow
-namespace Ui
-{
-class MainWindow;
-}
-
-//! MainWindow
-/*!
-Klasa okienka.
-*/
-class MainWindow : public QMainWindow
-{
-    Q_OBJECT
-
-public:
-    //! Konstruktor
-    explicit MainWindow(QWidget *parent = nullptr);
-    //! Destruktor
-    ~MainWindow();
-
-private:
-    //!Funckcja tworzy odpowiedni harmonogram w zalenoci od wybranego algorytmu
-    alg::Scheduler* createScheduler();
-    //!Metoda parsuje tabelk zada i dodaje zadania do harmonogramu
-    void updateTask( alg::Scheduler* scheduler);
-
-    Ui::MainWindow* ui; //!< Wskanik na klas zwierajc elemty graficzne okienka
-    alg::Scheduler* mScheduler { nullptr };  //!< Wskani na aktualnie wykorzystywany harmonogram
-
-private slots:
-    //! Metoda wywoujca symulacj
-    void runSimulation();
-    //! Metoda lozuje zadania
-    void randomTasks();
-    //! Metoda dodaj zadanie do tabeli
-    void insertTask();
-    //! Metoda dodaj zadanie do tabeli w oparciu o wskanik do zadania
-    void insertTask(alg::Scheduler::Task*);
-    //! Metoda usuwajca ostatnie zadanie w tabeli
-    void deleteTask();
-};
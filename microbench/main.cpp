@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "simulation.h"
+
+namespace
+{
+    using alg::uint;
+
+    std::atomic<std::uint64_t> gAllocations {0};     //!< liczba przydziałów pamięci
+    std::atomic<std::uint64_t> gAllocatedBytes {0};  //!< liczba przydzielonych bajtów
+}
+
+// zastępujemy globalne operatory new, by liczyć przydziały pamięci w trakcie pomiaru
+// operatory delete nie są rozwijane w miejscu wywołania, bo GCC zestawia wtedy free
+// z operatorem new i zgłasza niedopasowaną parę (-Wmismatched-new-delete)
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+void* operator new(std::size_t size)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+BENCH_NOINLINE void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    operator delete[](p);
+}
+
+namespace
+{
+    //! Parametry przypadku testowego
+    struct Case
+    {
+        std::string policy;     //!< nazwa algorytmu
+        bool events;            //!< czy symulacja sterowana zdarzeniami
+        std::size_t tasks;      //!< liczba zadań
+        uint horizon;           //!< czas symulacji
+        double utilization;     //!< docelowe wykorzystanie procesora
+    };
+
+    //! Wynik przypadku testowego
+    struct Result
+    {
+        bool skipped {false};            //!< czy przypadek przekroczył limit pracy
+        double ns {0.0};                 //!< najkrótszy czas symulacji
+        std::uint64_t steps {0};         //!< liczba obiegów pętli symulacji
+        std::uint64_t allocations {0};   //!< liczba przydziałów pamięci w jednej symulacji
+        std::uint64_t allocatedBytes {0};//!< liczba przydzielonych bajtów w jednej symulacji
+        std::uint64_t segments {0};      //!< liczba odcinków przebiegu
+        bool systemOk {true};            //!< czy żadne zadanie nie przekroczyło terminu
+    };
+
+    //! Odbiorca przebiegu liczący odcinki
+    /*!
+    Powtórzenia hiperokresu rozlicza bez odcinków, tak jak StatsCollector.
+    */
+    class CountingSink : public alg::TraceSink
+    {
+    public:
+        void consume(const alg::Segment*, std::size_t count) override { mSegments += count; }
+        void boundary(uint) override { mBoundary = mSegments; }
+        bool repeat(uint, uint count) override
+        {
+            mSegments += (mSegments - mBoundary) * count;
+            return true;
+        }
+
+        //! Funkcja zwraca liczbę odcinków
+        std::uint64_t segments() const { return mSegments; }
+
+    private:
+        std::uint64_t mSegments {0}; //!< liczba odcinków
+        std::uint64_t mBoundary {0}; //!< liczba odcinków w chwili ostatniej granicy okresu
+    };
+
+    //! Funkcja losuje zadania z rozkładami MainWindow::randomTasks() i skaluje okresy do podanego wykorzystania
+    /*!
+    Czas wykonania, okres i priorytet losowane są tak jak w oknie aplikacji, a następnie wszystkie
+    okresy mnożone są przez wspólny czynnik. Terminy równe są okresom. Ten sam zestaw zwracany jest
+    dla tego samego ziarna, a zestaw mniejszy jest początkiem większego.
+    */
+    std::vector<alg::Task> generateTasks(std::size_t count, double utilization, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> disTime(1, 100);
+        std::uniform_int_distribution<> disPrioryty(0, 9);
+
+        std::vector<alg::Task> tasks;
+        double sum = 0.0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            int time = disTime(gen);
+            int prioryty = disPrioryty(gen);
+
+            std::uniform_int_distribution<> disPeriod(time + 10, time + 50);
+            int period = disPeriod(gen);
+
+            tasks.emplace_back(static_cast<int>(i), period, time, period, prioryty);
+            sum += static_cast<double>(time) / period;
+        }
+
+        // okres nie może być krótszy od czasu wykonania
+        double scale = sum / utilization;
+        for (alg::Task &t : tasks)
+        {
+            double period = std::max(std::round(t.period * scale), static_cast<double>(t.time));
+            t.period = static_cast<int>(std::min(period, static_cast<double>(std::numeric_limits<int>::max())));
+            t.deadline = t.period;
+        }
+
+        return tasks;
+    }
+
+    //! Funkcja mierzy jeden przypadek testowy
+    /*!
+    \param repeat liczba powtórzeń, wynikiem jest najszybsze z nich
+    \param shortcut czy pomijać powtarzające się hiperokresy
+    */
+    Result measure(const Case& c, const std::vector<alg::Task>& tasks, unsigned repeat, bool shortcut)
+    {
+        Result result;
+
+        for (unsigned r = 0; r < repeat; ++r)
+        {
+            std::unique_ptr<alg::SchedulerEngine> engine = alg::createEngine(c.policy);
+            engine->tasks = tasks;
+            engine->setHyperperiodShortcut(shortcut);
+
+            CountingSink sink;
+            engine->setTraceSink(&sink);
+
+            std::uint64_t allocations = gAllocations.load();
+            std::uint64_t bytes = gAllocatedBytes.load();
+            auto start = std::chrono::steady_clock::now();
+
+            if (c.events)
+                engine->scheduleEvents(c.horizon);
+            else
+                engine->schedule(c.horizon);
+
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+            if (r > 0 && ns >= result.ns)
+                continue;
+
+            result.ns = ns;
+            result.allocations = gAllocations.load() - allocations;
+            result.allocatedBytes = gAllocatedBytes.load() - bytes;
+            result.steps = engine->steps();
+            result.segments = sink.segments();
+            result.systemOk = engine->systemOk();
+        }
+
+        return result;
+    }
+
+    //! Funkcja wczytuje listę liczb oddzielonych przecinkami
+    template <typename T>
+    bool parseList(const char* text, std::vector<T>& values)
+    {
+        values.clear();
+        while (*text)
+        {
+            char* end;
+            double value = std::strtod(text, &end);
+            if (end == text || (*end != ',' && *end != '\0') || value < 0)
+                return false;
+
+            values.push_back(static_cast<T>(value));
+            text = *end ? end + 1 : end;
+        }
+        return !values.empty();
+    }
+
+    //! Metoda wypisuje sposób użycia programu
+    void usage(const char* program)
+    {
+        std::fprintf(stderr,
+            "Uzycie: %s [-n zadania[,...]] [-t czas[,...]] [-u wykorzystanie[,...]] [-a algorytm|all]\n"
+            "          [-m ticks|events|all] [-r powtorzenia] [-s ziarno] [--max-work n] [--shortcut] [-o plik]\n"
+            "  -n           liczby zadan (domyslnie 1,10,100,1000,10000,100000)\n"
+            "  -t           czasy symulacji (domyslnie 10000)\n"
+            "  -u           docelowe wykorzystania procesora (domyslnie 0.5,0.9)\n"
+            "  -a           algorytm szeregowania (domyslnie all)\n"
+            "  -m           rodzaj symulacji (domyslnie all)\n"
+            "  -r           liczba powtorzen, wynikiem jest najkrotszy czas (domyslnie 3)\n"
+            "  -s           ziarno generatora zadan (domyslnie 1)\n"
+            "  --max-work   pomin symulacje cykl po cyklu, gdy zadania * czas przekracza n (domyslnie 1e9)\n"
+            "  --shortcut   pomijaj powtarzajace sie hiperokresy (domyslnie symulowany jest caly czas)\n"
+            "  -o plik      plik wynikow JSON (domyslnie standardowe wyjscie)\n",
+            program);
+    }
+}
+
+//! Benchmark silnika symulacji z wynikami w formacie JSON
+/*!
+Dla każdej kombinacji liczby zadań, czasu symulacji, wykorzystania, algorytmu i rodzaju symulacji
+wypisuje czas na cykl i na zdarzenie, liczbę przydziałów pamięci oraz rozmiar przebiegu.
+Przypadki wypisywane są w stałej kolejności, więc wyniki z różnych wersji można porównywać programem diff.
+*/
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> taskCounts {1, 10, 100, 1000, 10000, 100000};
+    std::vector<uint> horizons {10000};
+    std::vector<double> utilizations {0.5, 0.9};
+    std::string algorithm = "all";
+    std::string mode = "all";
+    unsigned repeat = 3;
+    unsigned seed = 1;
+    double maxWork = 1e9;
+    bool shortcut = false;
+    const char* output = nullptr;
+
+    // parsujemy argumenty
+    for (int i = 1; i < argc; ++i)
+    {
+        bool ok = true;
+        if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            ok = parseList(argv[++i], taskCounts);
+        else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            ok = parseList(argv[++i], horizons);
+        else if (std::strcmp(argv[i], "-u") == 0 && i + 1 < argc)
+            ok = parseList(argv[++i], utilizations);
+        else if (std::strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+            algorithm = argv[++i];
+        else if (std::strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            mode = argv[++i];
+        else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            repeat = std::max(1u, static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10)));
+        else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--max-work") == 0 && i + 1 < argc)
+            maxWork = std::strtod(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--shortcut") == 0)
+            shortcut = true;
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            output = argv[++i];
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    for (double u : utilizations)
+    {
+        if (u <= 0.0)
+        {
+            std::fprintf(stderr, "Wykorzystanie musi byc dodatnie\n");
+            return 2;
+        }
+    }
+
+    // wybieramy algorytmy i rodzaje symulacji
+    std::vector<std::string> algorithms;
+    if (algorithm == "all")
+        algorithms = alg::engineNames();
+    else if (alg::createEngine(algorithm))
+        algorithms.push_back(algorithm);
+    else
+    {
+        std::fprintf(stderr, "Nieznany algorytm: %s\n", algorithm.c_str());
+        return 2;
+    }
+
+    std::vector<bool> modes;
+    if (mode == "all" || mode == "ticks")
+        modes.push_back(false);
+    if (mode == "all" || mode == "events")
+        modes.push_back(true);
+    if (modes.empty())
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *out = output ? std::fopen(output, "w") : stdout;
+    if (!out)
+    {
+        std::fprintf(stderr, "%s: nie mozna utworzyc pliku\n", output);
+        return 1;
+    }
+
+    std::fprintf(out, "{\n  \"seed\": %u,\n  \"repeat\": %u,\n  \"shortcut\": %s,\n  \"segment_bytes\": %zu,\n  \"cases\": [",
+                 seed, repeat, shortcut ? "true" : "false", sizeof(alg::Segment));
+
+    bool first = true;
+    for (std::size_t count : taskCounts)
+    {
+        for (double u : utilizations)
+        {
+            // ten sam zestaw zadań dla wszystkich algorytmów, czasów i rodzajów symulacji
+            std::vector<alg::Task> tasks = generateTasks(count, u, seed);
+
+            for (uint horizon : horizons)
+            {
+                for (const std::string &policy : algorithms)
+                {
+                    for (bool events : modes)
+                    {
+                        Case c {policy, events, count, horizon, u};
+
+                        Result r;
+                        if (!events && static_cast<double>(count) * horizon > maxWork)
+                            r.skipped = true;
+                        else
+                            r = measure(c, tasks, repeat, shortcut);
+
+                        std::fprintf(out, "%s\n    {\"policy\": \"%s\", \"mode\": \"%s\", \"tasks\": %zu, \"horizon\": %u, \"utilization\": %.3f",
+                                     first ? "" : ",", c.policy.c_str(), events ? "events" : "ticks", c.tasks, c.horizon, c.utilization);
+                        first = false;
+
+                        if (r.skipped)
+                        {
+                            std::fprintf(out, ", \"skipped\": true}");
+                            continue;
+                        }
+
+                        double perTick = horizon ? r.ns / horizon : 0.0;
+                        double perEvent = r.steps ? r.ns / static_cast<double>(r.steps) : 0.0;
+                        std::fprintf(out, ", \"ns\": %.0f, \"ns_per_tick\": %.3f, \"events\": %llu, \"ns_per_event\": %.3f"
+                                          ", \"allocations\": %llu, \"allocated_bytes\": %llu, \"trace_segments\": %llu"
+                                          ", \"trace_bytes\": %llu, \"system_ok\": %s}",
+                                     r.ns, perTick, static_cast<unsigned long long>(r.steps), perEvent,
+                                     static_cast<unsigned long long>(r.allocations),
+                                     static_cast<unsigned long long>(r.allocatedBytes),
+                                     static_cast<unsigned long long>(r.segments),
+                                     static_cast<unsigned long long>(r.segments * sizeof(alg::Segment)),
+                                     r.systemOk ? "true" : "false");
+                        std::fflush(out);
+                    }
+                }
+            }
+        }
+    }
+
+    std::fprintf(out, "\n  ]\n}\n");
+    if (output)
+        std::fclose(out);
+
+    return 0;
+}
@@ -1,113 +0,0 @@
-#include "scheduler.h"
-#include <algorithm>
-#include <iostream>
-
-namespace alg
-{
-    //! Funkcja sprawdza czy zadnie si zakoczyo
-    bool isTaskSchedulable(const Scheduler::Task &t)
-    {
-        return t.cycles < t.time;
-    }
-
-    //! Konstruktor domyny
-    Scheduler::Scheduler() = default;
-
-    //! Destruktor domyny
-    Scheduler::~Scheduler() = default;
-
-    void Scheduler::schedule(uint endTime)
-    {
-        //Wywaane po ty tylko by nabi dane w zadaiach
-        nextTick(false);
-        --mCurrentTime;
-
-        mSystemOk = true;
-
-        //Gwna ptla symulacji
-        for ( mCurrentTime = 0; mCurrentTime < endTime; mSystemOk &= nextTick())
-        {
-            // wybr zadania
-            int taskId = getBestTaskId();
-
-            // przypisanie zadania do ostanio wykonywanego zadania
-            mLastTaskId = taskId;
-
-            // zwikszamy ilo cykli dla zadania
-            if (taskId != -1) 
-            {
-                tasks[static_cast<size_t>(taskId)].cycles++;
-            }
-
-            // wykonujemy zadanie
-            emit notifyTask(this, taskId);
-        }
-    }
-
-    bool Scheduler::nextTick(bool print)
-    {
-        bool ok = true;
-
-        // zwikszamy licznika czasu
-        mCurrentTime++;
-
-        // sparwdzamy kolajne zadani czy nie przeroczyy terminu
-        for (std::size_t i = 0; i< tasks.size(); ++i) 
-        {
-            Task &t = tasks[i];
-
-            if (t.timeToDeadline > 0)
-            {
-                t.timeToDeadline--;
-            }
-            else if(t.cycles != t.time) 
-            {
-
-                if (print)
-                    emit notifyDeadlineMiss(this, static_cast<int>(i)); // termin zosta przekroczony
-                t.cycles = t.time; 
-                ok = false;
-            }
-
-            if (t.timeToEnd > 0) 
-            {
-                t.timeToEnd--;
-            }
-            else 
-            {
-                // zadanie si zakoczyo resetujemy dane
-                t.cycles = 0;
-                t.timeToEnd = t.period - 1;
-                t.timeToDeadline = t.deadline - 1;
-            }
-        }
-
-        return ok;
-    }
-
-    int Scheduler::getBestTaskId() const
-    {
-        // pornujemy 2 zadania i wyszukujemy najmniejszy 
-        // element w tablicy wedug kryteriw
-        auto t = std::min_element(tasks.begin(), tasks.end(),
-            [=](const Task &a, const Task &b)
-        {
-            if (!isTaskSchedulable(a))
-                // a jest zakoczone, sortuj po b
-                return false;
-            else if (!isTaskSchedulable(b))
-                //  b jest zakoczone, sortuj po a 
-                return true;
-            else
-                // oba zadania s wykonywane, wybierz to z wikszym priorytetem
-                return getTaskPriority(a, b);
-        }
-        );
-
-        // jeeli wybrane zadanie nie moe by zrealizowane zwr brak zadania (-1)
-        if ( t == tasks.end() || !isTaskSchedulable(*t))
-            return -1;
-        else
-            return std::distance(tasks.begin(), t);
-    }
-}
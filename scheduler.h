@@ -1,159 +0,0 @@
-#pragma once
-
-#include <vector>
-
-#include <QObject>
-
-namespace alg
-{
-    // skracam nazw typu
-    using uint = unsigned int;
-
-    //! Harmonogram
-    /*!
-    Klasa abstrakcyjna harmonogramu.
-    Zawiera metody i funkcje pozwalajce na symulowanie dziaania alogrytmw szeregowania
-    zada. 
-
-    Podklasy musz zaimplementowa funcj getTaskPriority().
-    */
-    class Scheduler: public QObject
-    {
-        Q_OBJECT
-    public:
-        //! Konstruktor
-        Scheduler();
-
-        //! Destruktor
-        virtual ~Scheduler();
-
-        //! Zadanie
-        /*!
-        Struktura danych reprezentujca zadanie w harmonogramie
-        */
-        struct Task
-        {
-            Task() = default;
-            Task(int index, int period, int time, int deadline, int prioryty)
-                : index(index)
-                , period(period)
-                , time(time)
-                , deadline(deadline)
-                , prioryty(prioryty)
-                , timeToDeadline(deadline)
-            {}
-
-            int index   {0};  //!< koleny indeks zadania 
-            int period  {0};  //!< okres 
-            int time    {0};  //!< czas wykonania zadania
-            int deadline{0};  //!< termin
-            int prioryty{0};  //!< priorytet
-
-            int cycles         {0}; //!< liczba cykli trwania zadania
-            int timeToDeadline {0}; //!< cykle pozostae do nstpnego terminu
-            int timeToEnd  {0}; //!< cykle pozostae do zakoczenia zadania
-        };
-
-        //! Metoda symulujca dziaanie harmonogramu
-        /*!
-        \param endTime czas zakoczenia symulacji
-        */
-        void schedule(uint endTime);
-
-        //! Funkcja sprawdza czy moliwe jest zasymulowanie kolejnego cyklu
-        /*!
-        \param print czy wypisa informacje na konsole
-        */
-        bool nextTick(bool print = true);
-
-        //! Funkcja zawraca id zadania z tablicy (std::vector)
-        /*!
-        Wybr najlepszego zadania odbywa si zgodnie z przyjtym algorytmem
-        */
-        int getBestTaskId() const;
-
-        //! Funkcja virtualna porwnujca dwa zadania i dokonujca 
-        //! wyboru najlepszego wedug zdefinowanego kryterium
-        /*!
-        \param a pierwsze zadanie do porwnania
-        \param b drugie zadanie do porwnania
-        */
-        virtual bool getTaskPriority(const Task& a, const Task& b) const = 0;
-
-        //! Funkcja zwraca akttualny czas symulacji
-        uint currentTime() const { return mCurrentTime; }
-
-        //! Funkcja zwraca ilo zada
-        int tasksSize() const { return static_cast<int>(tasks.size()); }
-
-        std::vector<Task> tasks; //!< tablica zada
-
-    signals:
-        void notifyTask(alg::Scheduler* scheduler, int taskId);
-        void notifyDeadlineMiss(alg::Scheduler* scheduler, int taskId);
-
-    private:
-        uint mCurrentTime   {0};    //!< czas symulacji
-        int mLastTaskId     {-1};   //!< id ostaniego wykonanego zadania. Wartoc -1 oznacza brak zadania
-        bool mSystemOk      {true};  //!< flaga sprawdzajca czy system dziaa
-
-    };
-
-    //! DMS
-    /*!
-    Klasa algorytmu DMS.
-    Przecia funkcj getTaskPriority().
-    */
-    class DMSScheduler : public Scheduler
-    {
-        //! Przeciona funkcja porwnujca dwa zadania
-        /*!
-        Porwnywane s terminy i wybierany jest ten z krtszym terminem
-        */
-        bool getTaskPriority(const Scheduler::Task& a, const Scheduler::Task& b) const override
-        {
-            return a.deadline < b.deadline;
-        }
-    };
-
-    //! LLF
-    /*!
-    Klasa algorytmu LLS.
-    Przecia funkcj getTaskPriority().
-    */
-    class LLSScheduler : public Scheduler
-    {
-        //! Przeciona funkcja porwnujca dwa zadania
-        /*!
-        Porwnywane s swobody czasowe i wybierane jest to zadanie z mniejsz swobod
-        */
-        bool getTaskPriority(const Scheduler::Task& a, const Scheduler::Task& b) const override
-        {
-            return laxity(a) < laxity(b);
-        }
-
-        //! Funkcja obliczajca swobod czasow dla zadania
-        int laxity(const Scheduler::Task& t) const
-        {
-            return t.deadline - (t.time - t.cycles);
-        }
-    };
-
-    //! Prioryty
-    /*!
-    Klasa algorytmu piorytetowego.
-    Przecia funkcj getTaskPriority().
-    */
-    class PriorytyScheduler : public Scheduler
-    {
-        //! Przeciona funkcja porwnujca dwa zadania
-        /*!
-        Porwnywane s piorytety i wybierany jest te z wyszym piorytetem (mniejsza liczba = wiekszy priorytet)
-        */
-        bool getTaskPriority(const Scheduler::Task& a, const Scheduler::Task& b) const override
-        {
-            return a.prioryty < b.prioryty;
-        }
-    };
-
-}
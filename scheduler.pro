@@ -1,18 +1,14 @@
-TEMPLATE = app
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-HEADERS = mainwindow.h \
-          scheduler.h \
-          ganttwidget.h
-
-SOURCES = main.cpp \
-          mainwindow.cpp \
-          scheduler.cpp \
-          ganttwidget.cpp
-
-FORMS = mainwindow.ui
-
-INCLUDEPATH += $$PWD
-         
-
+TEMPLATE = subdirs
+
+SUBDIRS = core \
+          gui \
+          cli \
+          bench \
+          microbench \
+          tests
+
+gui.depends = core
+cli.depends = core
+bench.depends = core
+microbench.depends = core
+tests.depends = core
@@ -0,0 +1,179 @@
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "analysis.h"
+#include "batch.h"
+#include "generator.h"
+#include "registry.h"
+
+namespace
+{
+    using alg::uint;
+
+    int gFailures = 0; //!< liczba niespełnionych sprawdzeń
+
+    //! Metoda zapisuje wynik sprawdzenia i wypisuje opis niespełnionego
+    void check(bool condition, const std::string& what)
+    {
+        if (condition)
+            return;
+
+        std::printf("FAIL %s\n", what.c_str());
+        ++gFailures;
+    }
+
+    //! Funkcja zwraca nazwy wszystkich zarejestrowanych algorytmów
+    std::vector<std::string> algorithmNames()
+    {
+        std::vector<std::string> names;
+        for (const alg::PolicyInfo &info : alg::policies())
+            names.push_back(info.name);
+        return names;
+    }
+
+    //! Test sprawdza, że zestawy rozstrzygnięte przez analyze() mają ten sam wynik w symulacji
+    /*!
+    Okresy są dzielnikami krótkiego hiperokresu, więc symulacja kilku hiperokresów obejmuje
+    każde przekroczenie terminu, które przewiduje analiza. Co drugi zestaw dostaje zadanie
+    z terminem dłuższym od okresu.
+    */
+    void testAnalysisAgreesWithSimulation()
+    {
+        alg::GeneratorOptions options;
+        options.tasks = 5;
+        options.periodMethod = alg::PeriodMethod::DIVISORS;
+        options.minPeriod = 10;
+        options.maxPeriod = 420;
+        options.hyperperiod = 2520;
+
+        std::vector<alg::TaskSet> sets;
+        alg::Random random(7);
+        for (double utilization : {0.6, 0.85, 1.0, 1.1})
+        {
+            for (double deadline : {1.0, 0.3})
+            {
+                options.utilization = utilization;
+                options.minDeadline = deadline;
+                alg::TaskSetGenerator generator(options, sets.size() + 1);
+
+                for (alg::TaskSet &set : generator.generate(40))
+                {
+                    if (sets.size() % 2)
+                    {
+                        alg::Task &t = set[static_cast<std::size_t>(random.below(set.size()))];
+                        t.deadline = t.period + 1 + static_cast<int>(random.below(static_cast<std::uint64_t>(t.period)));
+                    }
+                    sets.push_back(set);
+                }
+            }
+        }
+
+        const std::vector<std::string> algorithms = algorithmNames();
+        const std::vector<uint> horizons {3 * options.hyperperiod};
+
+        alg::ThreadPool pool;
+        alg::BatchOptions batch;
+        std::vector<alg::BatchResult> results;
+        std::vector<alg::BatchSummary> simulated = alg::simulateBatch(pool, sets, algorithms, horizons, batch, &results);
+
+        std::size_t decided = 0;
+        for (const alg::BatchResult &r : results)
+        {
+            alg::Verdict verdict = alg::analyze(algorithms[r.algorithm], sets[r.set]).verdict;
+            if (verdict == alg::Verdict::UNKNOWN)
+                continue;
+
+            ++decided;
+            check((verdict == alg::Verdict::SCHEDULABLE) == (r.misses == 0),
+                  "analiza " + algorithms[r.algorithm] + " zestawu " + std::to_string(r.set) + ": " +
+                  alg::verdictName(verdict) + ", symulacja " + std::to_string(r.misses) + " przekroczen");
+        }
+        check(decided > 0, "analiza nie rozstrzygnela zadnego zestawu");
+
+        // zestawy odrzucone przez analizę liczą się jak symulowane z przekroczeniem terminu
+        batch.prefilter = true;
+        std::vector<alg::BatchSummary> prefiltered = alg::simulateBatch(pool, sets, algorithms, horizons, batch);
+        check(prefiltered.size() == simulated.size(), "liczba wynikow zbiorczych");
+        for (std::size_t i = 0; i < prefiltered.size() && i < simulated.size(); ++i)
+        {
+            check(prefiltered[i].failedSets == simulated[i].failedSets,
+                  "zestawy z przekroczeniem " + simulated[i].algorithm + ": " + std::to_string(prefiltered[i].failedSets) +
+                  " z analiza, " + std::to_string(simulated[i].failedSets) + " bez");
+        }
+    }
+
+    //! Test sprawdza, że zestaw z sekcjami krytycznymi rozstrzyga symulacja, a nie analiza
+    /*!
+    Zadanie o dłuższym terminie zajmuje zasób przez 4 cykle, a zadanie o terminie 1 cyklu
+    potrzebuje tego samego zasobu, więc przy każdym protokole przekracza termin,
+    choć testy bez składnika blokowania przyjmują zestaw.
+    */
+    void testCriticalSectionsAreSimulated()
+    {
+        std::istringstream in("1 4 1 0 0 0 p R1:0:1\n5 20 20 1 0 0 p R1:0:4\n");
+        std::vector<alg::TaskSet> sets;
+        std::string error;
+        check(alg::readTaskSets(in, sets, error) && sets.size() == 1, "wczytanie zestawu z sekcjami krytycznymi: " + error);
+        if (sets.size() != 1)
+            return;
+
+        check(alg::analyze("DMS", sets[0]).verdict == alg::Verdict::UNKNOWN, "analiza zestawu z sekcjami krytycznymi");
+
+        alg::ThreadPool pool;
+        for (alg::ResourceProtocol protocol : {alg::ResourceProtocol::NONE, alg::ResourceProtocol::INHERITANCE, alg::ResourceProtocol::CEILING})
+        {
+            alg::BatchOptions batch;
+            batch.prefilter = true;
+            batch.resources = protocol;
+            std::vector<alg::BatchResult> results;
+            alg::simulateBatch(pool, sets, {"DMS"}, {1000}, batch, &results);
+
+            check(results.size() == 1 && results[0].simulated && results[0].misses > 0,
+                  "zestaw z sekcjami krytycznymi, protokol " + std::to_string(static_cast<int>(protocol)) +
+                  ": " + (results.empty() ? std::string("brak wyniku") : std::to_string(results[0].misses) + " przekroczen"));
+        }
+    }
+
+    //! Test sprawdza, że z kosztem przełączania kontekstu zestaw rozstrzyga symulacja, a nie analiza
+    /*!
+    Bez kosztu przełączania zestaw wykorzystuje 75% procesora i analiza go przyjmuje,
+    a dwa cykle na każde przełączenie sprawiają, że zadanie o dłuższym okresie przekracza termin.
+    */
+    void testSwitchCostIsSimulated()
+    {
+        std::istringstream in("2 4 4 0\n2 8 8 1\n");
+        std::vector<alg::TaskSet> sets;
+        std::string error;
+        check(alg::readTaskSets(in, sets, error) && sets.size() == 1, "wczytanie zestawu z przelaczaniem: " + error);
+        if (sets.size() != 1)
+            return;
+
+        alg::ThreadPool pool;
+        alg::BatchOptions batch;
+        batch.prefilter = true;
+        batch.policy.switchCost = 2;
+        std::vector<alg::BatchResult> results;
+        alg::simulateBatch(pool, sets, {"DMS"}, {1000}, batch, &results);
+
+        check(results.size() == 1 && results[0].simulated && results[0].misses > 0,
+              "zestaw z kosztem przelaczania: " + (results.empty() ? std::string("brak wyniku") : std::to_string(results[0].misses) + " przekroczen"));
+    }
+}
+
+int main()
+{
+    testAnalysisAgreesWithSimulation();
+    testCriticalSectionsAreSimulated();
+    testSwitchCostIsSimulated();
+
+    if (gFailures)
+    {
+        std::printf("%d sprawdzen nie powiodlo sie\n", gFailures);
+        return 1;
+    }
+
+    std::printf("wszystkie testy zaliczone\n");
+    return 0;
+}
@@ -0,0 +1,9 @@
+TEMPLATE = app
+TARGET = tests
+
+CONFIG += console
+CONFIG -= qt app_bundle
+
+SOURCES = main.cpp
+
+include(../core/core.pri)